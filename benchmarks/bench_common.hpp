@@ -0,0 +1,41 @@
+#ifndef BYTESTREAM_BENCH_COMMON_HPP
+#define BYTESTREAM_BENCH_COMMON_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+// Payload sizes: 16 B .. 64 MiB, x4 steps
+inline constexpr std::int64_t kMinPayload = 16;
+inline constexpr std::int64_t kMaxPayload = std::int64_t{64} << 20;
+
+inline void payload_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(kMinPayload, kMaxPayload);
+}
+
+// Deterministic, non-trivial fill (keeps the optimizer honest)
+inline std::vector<std::uint8_t> make_payload(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    std::uint32_t x = 0x9E3779B9u;
+    for (auto& b : v) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        b = static_cast<std::uint8_t>(x);
+    }
+    return v;
+}
+
+// Reports GB/s (bytes) and time/op (ops) for one benchmark run
+inline void report(benchmark::State& state, std::size_t bytes_per_iter, std::size_t ops_per_iter) {
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(bytes_per_iter));
+    state.counters["time/op"] = benchmark::Counter(
+        static_cast<double>(ops_per_iter),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+} // namespace bench
+
+#endif // BYTESTREAM_BENCH_COMMON_HPP
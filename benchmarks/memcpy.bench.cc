@@ -0,0 +1,17 @@
+#include <bench_common.hpp>
+#include <cstring>
+
+// Baseline: raw memcpy of the payload, the latency budget reference
+static void BM_Memcpy(benchmark::State& state) {
+    const auto n   = static_cast<std::size_t>(state.range(0));
+    const auto src = bench::make_payload(n);
+    std::vector<std::uint8_t> dst(n);
+
+    for (auto _ : state) {
+        std::memcpy(dst.data(), src.data(), n);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, n, 1);
+}
+BENCHMARK(BM_Memcpy)->Apply(bench::payload_sizes);
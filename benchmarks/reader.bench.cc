@@ -0,0 +1,250 @@
+#include <bench_common.hpp>
+#include <bytestream/core.hpp>
+#include <algorithm>
+#include <array>
+
+using namespace bytestream;
+
+template <typename T>
+static void BM_ReadLE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    const auto buf   = bench::make_payload(n);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        T acc{};
+        for (std::size_t i = 0; i < count; ++i) acc ^= r.read_le<T>();
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, count * sizeof(T), count);
+}
+BENCHMARK_TEMPLATE(BM_ReadLE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadLE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadLE, std::uint64_t)->Apply(bench::payload_sizes);
+
+template <typename T>
+static void BM_ReadBE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    const auto buf   = bench::make_payload(n);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        T acc{};
+        for (std::size_t i = 0; i < count; ++i) acc ^= r.read_be<T>();
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, count * sizeof(T), count);
+}
+BENCHMARK_TEMPLATE(BM_ReadBE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadBE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadBE, std::uint64_t)->Apply(bench::payload_sizes);
+
+template <typename T>
+static void BM_ReadArrayBE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    const auto buf   = bench::make_payload(n);
+    std::vector<T> out(count);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        r.read_array_be<T>({out.data(), out.size()});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(T), 1);
+}
+BENCHMARK_TEMPLATE(BM_ReadArrayBE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArrayBE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArrayBE, float)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadArrayBE, double)->Apply(bench::payload_sizes);
+
+// One terminated string spanning the whole payload
+static void BM_ReadCString(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint8_t> buf(n, 'x');
+    buf.back() = 0;
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        auto s = r.read_cstring();
+        benchmark::DoNotOptimize(s.data());
+    }
+    bench::report(state, n, 1);
+}
+BENCHMARK(BM_ReadCString)->Apply(bench::payload_sizes);
+
+// Small fixed-layout frame (u8 + u16 + u32 + u64 + f32 = 19 bytes), checked vs validate-once
+template <typename Frame>
+static std::uint64_t decode_frame(Frame& f) {
+    std::uint64_t acc = f.template read<std::uint8_t>();
+    acc += f.template read_be<std::uint16_t>();
+    acc += f.template read_be<std::uint32_t>();
+    acc += f.template read_be<std::uint64_t>();
+    acc += static_cast<std::uint64_t>(f.template read_be<float>());
+    return acc;
+}
+
+static constexpr std::size_t kFrameSize = 1 + 2 + 4 + 8 + 4;
+
+static void BM_ReadFrameChecked(benchmark::State& state) {
+    const auto n      = static_cast<std::size_t>(std::max<std::int64_t>(state.range(0), kFrameSize));
+    const auto frames = n / kFrameSize;
+    const auto buf    = bench::make_payload(n);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < frames; ++i) acc += decode_frame(r);
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, frames * kFrameSize, frames);
+}
+BENCHMARK(BM_ReadFrameChecked)->Apply(bench::payload_sizes);
+
+static void BM_ReadFrameUnchecked(benchmark::State& state) {
+    const auto n      = static_cast<std::size_t>(std::max<std::int64_t>(state.range(0), kFrameSize));
+    const auto frames = n / kFrameSize;
+    const auto buf    = bench::make_payload(n);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < frames; ++i) {
+            auto f = r.unchecked(kFrameSize);
+            acc += decode_frame(f);
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, frames * kFrameSize, frames);
+}
+BENCHMARK(BM_ReadFrameUnchecked)->Apply(bench::payload_sizes);
+
+// Delta-coded timestamps, Stream VByte vs the fixed-width array they replace
+static std::vector<std::uint32_t> make_timestamps(std::size_t count) {
+    const auto noise = bench::make_payload(count);
+    std::vector<std::uint32_t> v(count);
+    std::uint32_t t = 1700000000u;
+    for (std::size_t i = 0; i < count; ++i) v[i] = t += noise[i];
+    return v;
+}
+
+static void BM_ReadPackedU32Delta(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0)) / sizeof(std::uint32_t);
+    const auto ts    = make_timestamps(count);
+    DynamicWriter w;
+    w.write_packed_u32_array({ts.data(), ts.size()}, packed_coding::delta);
+    std::vector<std::uint32_t> out(count);
+
+    for (auto _ : state) {
+        Reader r = w.as_reader();
+        r.read_packed_u32_array({out.data(), out.size()}, packed_coding::delta);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    // decoded bytes, comparable with BM_ReadArrayLE
+    bench::report(state, count * sizeof(std::uint32_t), 1);
+}
+BENCHMARK(BM_ReadPackedU32Delta)->Apply(bench::payload_sizes);
+
+static void BM_ReadArrayLEU32(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0)) / sizeof(std::uint32_t);
+    const auto ts    = make_timestamps(count);
+    DynamicWriter w;
+    w.write_array_le<std::uint32_t>({ts.data(), ts.size()});
+    std::vector<std::uint32_t> out(count);
+
+    for (auto _ : state) {
+        Reader r = w.as_reader();
+        r.read_array_le<std::uint32_t>({out.data(), out.size()});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(std::uint32_t), 1);
+}
+BENCHMARK(BM_ReadArrayLEU32)->Apply(bench::payload_sizes);
+
+// u32 fields fed in 4 KiB chunks; compare with BM_ReadLE<uint32_t>
+static void BM_StreamReadLE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(std::uint32_t);
+    const auto buf   = bench::make_payload(n);
+    constexpr std::size_t kChunk = 4096;
+
+    for (auto _ : state) {
+        std::size_t pos = 0;
+        StreamReader r(StreamReader::chunk_source([&]() -> span<const std::byte> {
+            const std::size_t k = std::min(kChunk, buf.size() - pos);
+            span<const std::byte> s{reinterpret_cast<const std::byte*>(buf.data()) + pos, k};
+            pos += k;
+            return s;
+        }));
+        std::uint32_t acc = 0;
+        for (std::size_t i = 0; i < count; ++i) acc ^= r.read_le<std::uint32_t>();
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, count * sizeof(std::uint32_t), count);
+}
+BENCHMARK(BM_StreamReadLE)->Apply(bench::payload_sizes);
+
+// Packed 3/5/12-bit sensor fields through the bit accumulator
+template <bit_order Order>
+static void BM_ReadBits(benchmark::State& state) {
+    const auto n      = static_cast<std::size_t>(state.range(0));
+    const auto groups = std::max<std::size_t>(1, n * 8 / 20);
+    const auto body   = bench::make_payload(groups * 20 / 8 + 8);
+
+    for (auto _ : state) {
+        Reader r(body.data(), body.size());
+        BitReader<Reader, Order> br(r);
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < groups; ++i) {
+            acc += br.read_bits(3);
+            acc += br.read_bits(5);
+            acc += br.read_bits(12);
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, groups * 20 / 8, groups * 3);
+}
+BENCHMARK_TEMPLATE(BM_ReadBits, bit_order::msb_first)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadBits, bit_order::lsb_first)->Apply(bench::payload_sizes);
+
+// Proxy forward: 16-byte header + body decoded as one message, either
+// copied together first or read in place through a BufferChain
+template <bool Chain>
+static void BM_ForwardHeaderBody(benchmark::State& state) {
+    const auto n    = static_cast<std::size_t>(state.range(0));
+    const auto body = bench::make_payload(n);
+    std::array<std::byte, 16> head{};
+    Writer h(head.data(), head.size());
+    h.write_le<std::uint64_t>(n);
+    h.write_le<std::uint64_t>(42);
+    DynamicWriter flat;  // both reused across messages
+    BufferChain   msg;
+
+    for (auto _ : state) {
+        std::uint64_t acc = 0;
+        if constexpr (Chain) {
+            msg.clear();
+            msg.append(h);
+            msg.append(body.data(), body.size());
+            ChainReader r = msg.as_reader();
+            acc = r.read_le<std::uint64_t>() + r.read_le<std::uint64_t>();
+            acc += std::uint64_t(r.view_bytes(n).data()[n - 1]);
+        } else {
+            flat.clear();
+            flat.write_bytes(head.data(), h.written_bytes());
+            flat.write_bytes(body.data(), body.size());
+            Reader r = flat.as_reader();
+            acc = r.read_le<std::uint64_t>() + r.read_le<std::uint64_t>();
+            acc += std::uint64_t(r.view_bytes(n).data()[n - 1]);
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, n + 16, 1);
+}
+BENCHMARK_TEMPLATE(BM_ForwardHeaderBody, false)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ForwardHeaderBody, true)->Apply(bench::payload_sizes);
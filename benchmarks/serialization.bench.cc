@@ -0,0 +1,398 @@
+#include <bench_common.hpp>
+#include <bytestream/core.hpp>
+#include <bytestream/parallel.hpp>
+#include <algorithm>
+#include <string>
+
+using namespace bytestream;
+
+namespace {
+
+struct Sample : Serializable<Sample> {
+    std::uint32_t id{};
+    double        value{};
+    std::string   tag;
+
+    void serialize_impl(Writer& w) const { write_fields(w, id, value, tag); }
+    void deserialize_impl(Reader& r) {
+        id    = read_field<std::uint32_t>(r);
+        value = read_field<double>(r);
+        tag   = read_field<std::string>(r);
+    }
+};
+
+// id + value + u32 prefix + 8-char tag
+constexpr std::size_t kSampleWireSize = 4 + 8 + 4 + 8;
+
+// Wider record: hand-written per-field CRTP vs a schema with fused fixed runs
+#define BYTESTREAM_BENCH_RECORD_FIELDS(X) \
+    X(std::uint64_t, a) X(std::uint64_t, b) X(std::uint32_t, c) X(std::uint32_t, d) \
+    X(double, e) X(double, f) X(std::uint16_t, g) X(std::uint16_t, h)
+
+struct RecordCRTP : Serializable<RecordCRTP> {
+#define X(T, n) T n{};
+    BYTESTREAM_BENCH_RECORD_FIELDS(X)
+#undef X
+    std::string tag;
+
+    template <class W> void serialize_impl(W& w) const {
+#define X(T, n) w.template write_le<T>(n);
+        BYTESTREAM_BENCH_RECORD_FIELDS(X)
+#undef X
+        write_field(w, tag);
+    }
+    template <class R> void deserialize_impl(R& r) {
+#define X(T, n) n = r.template read_le<T>();
+        BYTESTREAM_BENCH_RECORD_FIELDS(X)
+#undef X
+        tag = read_field<std::string>(r);
+    }
+};
+
+struct RecordSchema {
+#define X(T, n) T n{};
+    BYTESTREAM_BENCH_RECORD_FIELDS(X)
+#undef X
+    std::string tag;
+
+#define X(T, n) field_le<&RecordSchema::n>,
+    using bytestream_schema = schema<BYTESTREAM_BENCH_RECORD_FIELDS(X) field<&RecordSchema::tag>>;
+#undef X
+};
+
+// Fixed-layout record for the SoA batch decode
+struct Tick {
+    std::uint64_t ts{};
+    double        px{};
+    std::uint32_t qty{};
+    std::uint16_t venue{};
+    using bytestream_schema = schema<field_le<&Tick::ts>, field_le<&Tick::px>, field_le<&Tick::qty>,
+                                     field_le<&Tick::venue>>;
+};
+
+// Record with several strings; scans below only look at two fields
+struct WideOrder {
+    std::uint64_t id{};
+    std::string   account, trader, desk, strategy;
+    std::uint32_t qty{};
+    std::string   note;
+    std::int16_t  side{};
+    using bytestream_schema = schema<field_le<&WideOrder::id>, field<&WideOrder::account>, field<&WideOrder::trader>,
+                                     field<&WideOrder::desk>, field<&WideOrder::strategy>, field_le<&WideOrder::qty>,
+                                     field<&WideOrder::note>, field_le<&WideOrder::side>>;
+};
+
+// Same fields with wire ids (tagged.hpp). RecordTaggedOld knows two of them
+// and skips the rest.
+struct RecordTagged {
+#define X(T, n) T n{};
+    BYTESTREAM_BENCH_RECORD_FIELDS(X)
+#undef X
+    std::string tag;
+
+    using bytestream_tagged = tagged_schema<
+        bytestream::tag<1, field_le<&RecordTagged::a>>, bytestream::tag<2, field_le<&RecordTagged::b>>,
+        bytestream::tag<3, field_le<&RecordTagged::c>>, bytestream::tag<4, field_le<&RecordTagged::d>>,
+        bytestream::tag<5, field_le<&RecordTagged::e>>, bytestream::tag<6, field_le<&RecordTagged::f>>,
+        bytestream::tag<7, field_le<&RecordTagged::g>>, bytestream::tag<8, field_le<&RecordTagged::h>>,
+        bytestream::tag<9, field<&RecordTagged::tag>>>;
+};
+struct RecordTaggedOld {
+    std::uint64_t b{};
+    std::string   tag;
+    using bytestream_tagged = tagged_schema<bytestream::tag<2, field_le<&RecordTaggedOld::b>>,
+                                            bytestream::tag<9, field<&RecordTaggedOld::tag>>>;
+};
+
+constexpr std::size_t kRecordWireSize = 8 + 8 + 4 + 4 + 8 + 8 + 2 + 2 + 4 + 8;
+
+} // namespace
+
+static void BM_WriteFieldCRTP(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kSampleWireSize);
+    std::vector<std::uint8_t> buf(count * kSampleWireSize);
+    const Sample s = [] { Sample x; x.id = 7; x.value = 1.5; x.tag = "sensor-0"; return x; }();
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        for (std::size_t i = 0; i < count; ++i) write_field(w, s);
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * kSampleWireSize, count);
+}
+BENCHMARK(BM_WriteFieldCRTP)->Apply(bench::payload_sizes);
+
+template <typename T>
+static void BM_ReadVector(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    std::vector<T> src(count);
+    for (std::size_t i = 0; i < count; ++i) src[i] = static_cast<T>(i);
+
+    std::vector<std::uint8_t> buf(sizeof(std::uint32_t) + count * sizeof(T));
+    Writer w(buf.data(), buf.size());
+    write_vector(w, src);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        auto v = read_vector<T>(r);
+        benchmark::DoNotOptimize(v.data());
+    }
+    bench::report(state, count * sizeof(T), count);
+}
+BENCHMARK_TEMPLATE(BM_ReadVector, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadVector, float)->Apply(bench::payload_sizes);
+
+static void BM_ReadVectorCRTP(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kSampleWireSize);
+    std::vector<Sample> src(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        src[i].id = static_cast<std::uint32_t>(i);
+        src[i].tag = "sensor-0";
+    }
+
+    std::vector<std::uint8_t> buf(sizeof(std::uint32_t) + count * kSampleWireSize);
+    Writer w(buf.data(), buf.size());
+    write_vector(w, src);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        auto v = read_vector<Sample>(r);
+        benchmark::DoNotOptimize(v.data());
+    }
+    bench::report(state, count * kSampleWireSize, count);
+}
+BENCHMARK(BM_ReadVectorCRTP)->Apply(bench::payload_sizes);
+
+template <typename Record>
+static void BM_WriteRecord(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kRecordWireSize);
+    std::vector<std::uint8_t> buf(count * kRecordWireSize);
+    Record rec;
+    rec.a = 1; rec.e = 2.5; rec.tag = "sensor-0";
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        for (std::size_t i = 0; i < count; ++i) write_field(w, rec);
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * kRecordWireSize, count);
+}
+BENCHMARK_TEMPLATE(BM_WriteRecord, RecordCRTP)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteRecord, RecordSchema)->Apply(bench::payload_sizes);
+
+template <typename Record>
+static void BM_ReadRecord(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kRecordWireSize);
+    std::vector<std::uint8_t> buf(count * kRecordWireSize);
+    Record rec;
+    rec.a = 1; rec.e = 2.5; rec.tag = "sensor-0";
+    Writer w(buf.data(), buf.size());
+    for (std::size_t i = 0; i < count; ++i) write_field(w, rec);
+
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < count; ++i) acc += read_field<Record>(r).b;
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, count * kRecordWireSize, count);
+}
+BENCHMARK_TEMPLATE(BM_ReadRecord, RecordCRTP)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadRecord, RecordSchema)->Apply(bench::payload_sizes);
+
+// Same stream decoded in place into one reused target
+static void BM_ReadRecordInto(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kRecordWireSize);
+    std::vector<std::uint8_t> buf(count * kRecordWireSize);
+    RecordSchema rec;
+    rec.a = 1; rec.e = 2.5; rec.tag = "sensor-0";
+    Writer w(buf.data(), buf.size());
+    for (std::size_t i = 0; i < count; ++i) write_field(w, rec);
+
+    RecordSchema target;
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            read_field_into(r, target);
+            acc += target.b;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, count * kRecordWireSize, count);
+}
+BENCHMARK(BM_ReadRecordInto)->Apply(bench::payload_sizes);
+
+// Tagged wire format: every field self-describing, unknown ids skipped
+template <typename Record>
+static void BM_ReadTaggedRecord(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = std::max<std::size_t>(1, n / kRecordWireSize);
+    RecordTagged rec;
+    rec.a = 1; rec.e = 2.5; rec.tag = "sensor-0";
+    DynamicWriter w;
+    for (std::size_t i = 0; i < count; ++i) write_field(w, rec);
+
+    for (auto _ : state) {
+        Reader r(w.data(), w.size());
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < count; ++i) acc += read_field<Record>(r).b;
+        benchmark::DoNotOptimize(acc);
+    }
+    bench::report(state, w.size(), count);
+}
+BENCHMARK_TEMPLATE(BM_ReadTaggedRecord, RecordTagged)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_ReadTaggedRecord, RecordTaggedOld)->Apply(bench::payload_sizes);
+
+// Length-prefixed archive: serial Reader loop vs index + parallel_decode
+static DynamicWriter make_record_archive(std::size_t bytes) {
+    const auto count = std::max<std::size_t>(1, bytes / (kRecordWireSize + 4));
+    RecordSchema rec;
+    rec.tag = "sensor-0";
+    DynamicWriter out, tmp;
+    for (std::size_t i = 0; i < count; ++i) {
+        rec.a = i;
+        tmp.clear();
+        write_field(tmp, rec);
+        out.write_le<std::uint32_t>(static_cast<std::uint32_t>(tmp.size()));
+        out.write_bytes(tmp.data(), tmp.size());
+    }
+    return out;
+}
+
+static void BM_DecodeArchiveSerial(benchmark::State& state) {
+    const auto archive = make_record_archive(static_cast<std::size_t>(state.range(0)));
+    std::size_t count = 0;
+    for (auto _ : state) {
+        Reader r(archive.data(), archive.size());
+        std::vector<RecordSchema> out;
+        while (r.remaining()) {
+            const std::size_t n = r.read_le<std::uint32_t>();
+            Reader rec = r.subview(r.position(), n);
+            r.skip(n);
+            out.push_back(read_field<RecordSchema>(rec));
+        }
+        count = out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+    bench::report(state, archive.size(), count);
+}
+BENCHMARK(BM_DecodeArchiveSerial)->Arg(1 << 20)->Arg(16 << 20);
+
+static void BM_DecodeArchiveParallel(benchmark::State& state) {
+    const auto archive = make_record_archive(static_cast<std::size_t>(state.range(0)));
+    const Reader src(archive.data(), archive.size());
+    std::size_t count = 0;
+    for (auto _ : state) {
+        const auto index = index_records(archive.data(), archive.size());
+        auto out = parallel_decode(src, index, [](Reader& rec) { return read_field<RecordSchema>(rec); });
+        count = out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+    bench::report(state, archive.size(), count);
+}
+BENCHMARK(BM_DecodeArchiveParallel)->Arg(1 << 20)->Arg(16 << 20)->UseRealTime();
+
+// SoA: read_vector + a reshaping pass vs decoding straight into columns
+static std::vector<std::uint8_t> make_tick_vector(std::size_t bytes) {
+    const std::size_t count = std::max<std::size_t>(1, bytes / ColumnBatch<Tick>::row_size);
+    std::vector<Tick> ticks(count);
+    for (std::size_t i = 0; i < count; ++i) ticks[i] = { i, double(i) * 0.25, std::uint32_t(i), std::uint16_t(i) };
+    DynamicWriter w;
+    write_field(w, ticks);
+    return { reinterpret_cast<const std::uint8_t*>(w.data()), reinterpret_cast<const std::uint8_t*>(w.data()) + w.size() };
+}
+
+static void BM_ReadTicksThenReshape(benchmark::State& state) {
+    const auto buf = make_tick_vector(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint64_t> ts;
+    std::vector<double>        px;
+    std::size_t count = 0;
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        const auto ticks = read_vector<Tick>(r);
+        ts.resize(ticks.size());
+        px.resize(ticks.size());
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            ts[i] = ticks[i].ts;
+            px[i] = ticks[i].px;
+        }
+        count = ticks.size();
+        benchmark::DoNotOptimize(px.data());
+    }
+    bench::report(state, buf.size(), count);
+}
+BENCHMARK(BM_ReadTicksThenReshape)->Apply(bench::payload_sizes);
+
+static void BM_ReadTickColumns(benchmark::State& state) {
+    const auto buf = make_tick_vector(static_cast<std::size_t>(state.range(0)));
+    ColumnBatch<Tick> cols;
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        read_vector_columns(r, cols);
+        benchmark::DoNotOptimize(cols.column<&Tick::px>().data());
+    }
+    bench::report(state, buf.size(), cols.size());
+}
+BENCHMARK(BM_ReadTickColumns)->Apply(bench::payload_sizes);
+
+// Filter scan: full decode vs RecordView (skip walk / offset table)
+static std::vector<std::uint8_t> make_wide_orders(std::size_t bytes, bool indexed) {
+    DynamicWriter w;
+    for (std::uint64_t i = 0; w.size() < bytes; ++i) {
+        const WideOrder o{ i, "account-" + std::to_string(i), std::string(24, 't'), "desk-7", std::string(40, 's'),
+                           std::uint32_t(i), std::string(64, 'n'), std::int16_t(i % 2 ? -1 : 1) };
+        if (indexed) {
+            write_indexed_field(w, o);
+        } else {
+            CountingWriter size;
+            write_field(size, o);
+            w.write_le<std::uint32_t>(static_cast<std::uint32_t>(size.size()));
+            write_field(w, o);
+        }
+    }
+    return { reinterpret_cast<const std::uint8_t*>(w.data()), reinterpret_cast<const std::uint8_t*>(w.data()) + w.size() };
+}
+
+static void BM_FilterScanDecodeAll(benchmark::State& state) {
+    const auto buf = make_wide_orders(static_cast<std::size_t>(state.range(0)), false);
+    std::uint64_t total = 0;
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        total = 0;
+        while (r.remaining()) {
+            r.skip(4);
+            const auto o = read_field<WideOrder>(r);
+            if (o.side < 0) total += o.qty;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    bench::report(state, buf.size(), 1);
+}
+BENCHMARK(BM_FilterScanDecodeAll)->Arg(1 << 16)->Arg(1 << 20);
+
+template <record_index Index>
+static void BM_FilterScanView(benchmark::State& state) {
+    const auto buf = make_wide_orders(static_cast<std::size_t>(state.range(0)), Index == record_index::trailer);
+    std::uint64_t total = 0;
+    for (auto _ : state) {
+        Reader r(buf.data(), buf.size());
+        total = 0;
+        while (r.remaining()) {
+            const auto v = read_view<WideOrder>(r, Index);
+            if (v.template get<&WideOrder::side>() < 0) total += v.template get<&WideOrder::qty>();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    bench::report(state, buf.size(), 1);
+}
+BENCHMARK_TEMPLATE(BM_FilterScanView, record_index::none)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FilterScanView, record_index::trailer)->Arg(1 << 16)->Arg(1 << 20);
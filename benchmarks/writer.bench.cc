@@ -0,0 +1,141 @@
+#include <bench_common.hpp>
+#include <bytestream/core.hpp>
+#include <bytestream/ring_buffer.hpp>
+#include <memory>
+
+using namespace bytestream;
+
+template <typename T>
+static void BM_WriteLE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    std::vector<std::uint8_t> buf(n);
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        for (std::size_t i = 0; i < count; ++i) w.write_le<T>(static_cast<T>(i));
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(T), count);
+}
+BENCHMARK_TEMPLATE(BM_WriteLE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteLE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteLE, std::uint64_t)->Apply(bench::payload_sizes);
+
+template <typename T>
+static void BM_WriteBE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    std::vector<std::uint8_t> buf(n);
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        for (std::size_t i = 0; i < count; ++i) w.write_be<T>(static_cast<T>(i));
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(T), count);
+}
+BENCHMARK_TEMPLATE(BM_WriteBE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteBE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteBE, std::uint64_t)->Apply(bench::payload_sizes);
+
+template <typename T>
+static void BM_WriteArrayBE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(T);
+    std::vector<T> src(count);
+    for (std::size_t i = 0; i < count; ++i) src[i] = static_cast<T>(i);
+    std::vector<std::uint8_t> buf(n);
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        w.write_array_be<T>({src.data(), src.size()});
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(T), 1);
+}
+BENCHMARK_TEMPLATE(BM_WriteArrayBE, std::uint16_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArrayBE, std::uint32_t)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArrayBE, float)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteArrayBE, double)->Apply(bench::payload_sizes);
+
+// Header + one large body: copied into the buffer vs recorded by reference
+static void BM_WriteBlobCopy(benchmark::State& state) {
+    const auto n    = static_cast<std::size_t>(state.range(0));
+    const auto body = bench::make_payload(n);
+    DynamicWriter w(n + 64);
+
+    for (auto _ : state) {
+        w.clear();
+        w.write_le<std::uint32_t>(1);
+        w.write_le<std::uint64_t>(body.size());
+        w.write_bytes(body.data(), body.size());
+        benchmark::DoNotOptimize(w.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, n, 1);
+}
+BENCHMARK(BM_WriteBlobCopy)->Apply(bench::payload_sizes);
+
+static void BM_WriteBlobGather(benchmark::State& state) {
+    const auto n    = static_cast<std::size_t>(state.range(0));
+    const auto body = bench::make_payload(n);
+    GatherWriter w;
+
+    for (auto _ : state) {
+        w.clear();
+        w.write_le<std::uint32_t>(1);
+        w.write_le<std::uint64_t>(body.size());
+        w.write_bytes(body.data(), body.size());
+        auto segs = w.segments();
+        benchmark::DoNotOptimize(segs.data());
+    }
+    bench::report(state, n, 1);
+}
+BENCHMARK(BM_WriteBlobGather)->Apply(bench::payload_sizes);
+
+// Checksum adapter overhead on a scalar-heavy frame
+template <typename Hasher>
+static void BM_WriteChecksummedLE(benchmark::State& state) {
+    const auto n     = static_cast<std::size_t>(state.range(0));
+    const auto count = n / sizeof(std::uint64_t);
+    std::vector<std::uint8_t> buf(n + checksum_trailer_size<Hasher>);
+
+    for (auto _ : state) {
+        Writer w(buf.data(), buf.size());
+        ChecksumWriter<Writer, Hasher> cw(w);
+        for (std::size_t i = 0; i < count; ++i) cw.template write_le<std::uint64_t>(i);
+        cw.write_trailer();
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, count * sizeof(std::uint64_t), count);
+}
+BENCHMARK_TEMPLATE(BM_WriteChecksummedLE, Crc32c)->Apply(bench::payload_sizes);
+BENCHMARK_TEMPLATE(BM_WriteChecksummedLE, XxHash64)->Apply(bench::payload_sizes);
+
+// Ring frame round trip (reserve/commit/acquire/release), one thread
+template <ring_mode Mode>
+static void BM_RingFrameRoundTrip(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    constexpr std::size_t region = RingBuffer<Mode>::header_size + (1 << 16);
+    auto mem  = std::unique_ptr<std::byte[]>(new std::byte[region + 64]);
+    void* p   = mem.get() + (64 - reinterpret_cast<std::uintptr_t>(mem.get()) % 64) % 64;
+    auto ring = RingBuffer<Mode>::create(p, region);
+    const auto payload = bench::make_payload(n);
+
+    for (auto _ : state) {
+        auto f = ring.reserve(n);
+        f.writer.write_bytes(payload.data(), n);
+        ring.commit(f);
+        auto in = ring.acquire();
+        benchmark::DoNotOptimize(in.reader.data());
+        ring.release(in);
+    }
+    bench::report(state, n, 1);
+}
+BENCHMARK_TEMPLATE(BM_RingFrameRoundTrip, ring_mode::spsc)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_RingFrameRoundTrip, ring_mode::mpsc)->Arg(16)->Arg(256)->Arg(4096);
@@ -0,0 +1,323 @@
+#ifndef BYTESTREAM_ASYNC_READER_HPP
+#define BYTESTREAM_ASYNC_READER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/serialization.hpp>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define BYTESTREAM_HAS_COROUTINES 1
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------------
+// C++20 awaitable reader fed by an async I/O layer (io_uring, asio,
+// epoll callbacks). Bytes are pushed in; coroutines pull fields out:
+//
+//   bytestream::AsyncReader in;
+//
+//   task<void> session(bytestream::AsyncReader& in) {
+//       for (;;) {
+//           auto type = co_await in.read_le<std::uint16_t>();
+//           auto msg  = co_await in.read_field<Order>();
+//           handle(type, msg);
+//       }
+//   }
+//
+//   // completion handler
+//   auto buf = in.prepare(4096);                 // recv target
+//   std::size_t n = recv(fd, buf.data(), buf.size(), 0);
+//   n ? in.commit(n) : in.close();               // resumes the session
+//
+// The awaitables are plain structs, not coroutines: when the bytes are
+// already buffered, await_ready() decodes on the spot and the caller
+// never suspends and nothing is allocated. Otherwise the coroutine is
+// parked and resumed from commit()/close() once the read can finish.
+// After close(), a read that cannot finish throws UnderflowException.
+//
+// The buffer grows to the largest partially received message, not to
+// a worst case. read_field() decodes speculatively over the buffered
+// bytes and retries as more arrive; for large messages prefer a
+// length-prefixed read_frame(), which waits for exactly the prefix and
+// the payload. Views (read_bytes, read_frame, string_view fields) stay
+// valid until the coroutine next suspends.
+//
+// One reader per connection, one pending read at a time, no locking:
+// feed and resume on the same thread (or serialize externally).
+// ------------------------------------------------------------------
+namespace bytestream {
+
+class AsyncReader;
+
+namespace detail {
+
+// Completion state shared by every async read
+struct async_op_base {
+    bool               done = false;
+    std::exception_ptr error;
+
+    void check() const {
+        if (error) std::rethrow_exception(error);
+        if (!done) throw UnderflowException("bytestream::AsyncReader: stream closed");
+    }
+};
+
+// Op: bool try_complete(AsyncReader&) (finish now or report not yet),
+//     result() (after try_complete succeeded)
+template <typename Op>
+class async_read : Op {
+    AsyncReader* in_;
+public:
+    async_read(AsyncReader& in, Op op) : Op(std::move(op)), in_(&in) {}
+
+    bool await_ready() { return this->try_complete(*in_); }
+    // false (resume now, await_resume throws) once the reader is closed:
+    // nothing would ever wake a parked read
+    inline bool await_suspend(std::coroutine_handle<> h);
+    decltype(auto) await_resume() {
+        this->check();
+        return this->result();
+    }
+
+private:
+    // called from commit()/close(); decode errors go to the coroutine
+    static bool poll(void* self, AsyncReader& in) noexcept {
+        auto* op = static_cast<async_read*>(self);
+        try {
+            return op->try_complete(in);
+        } catch (...) {
+            op->error = std::current_exception();
+            return true;
+        }
+    }
+};
+
+} // namespace detail
+
+class AsyncReader {
+    std::vector<std::byte>  buf_;
+    std::size_t             head_     = 0; // first unread byte
+    std::size_t             tail_     = 0; // end of received bytes
+    std::size_t             consumed_ = 0; // bytes dropped by compaction
+    bool                    closed_   = false;
+    DecodeBudget*           budget_   = nullptr;
+    std::coroutine_handle<> waiter_;
+    void*                   op_   = nullptr;
+    bool                  (*poll_)(void*, AsyncReader&) = nullptr;
+
+    template <typename Op> friend class detail::async_read;
+public:
+    static constexpr std::size_t default_buffer_size = 4096;
+
+    explicit AsyncReader(std::size_t initial_capacity = default_buffer_size)
+        : buf_(initial_capacity ? initial_capacity : 1) {}
+    AsyncReader(const AsyncReader&) = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+
+    // Limits for read_field/read_frame (frames are checked as strings)
+    void set_budget(DecodeBudget* b) noexcept { budget_ = b; }
+    DecodeBudget* budget() const noexcept { return budget_; }
+
+    // bytes received and not yet read
+    std::size_t buffered() const noexcept { return tail_ - head_; }
+    // bytes read so far
+    std::size_t position() const noexcept { return consumed_ + head_; }
+    std::size_t capacity() const noexcept { return buf_.size(); }
+    bool closed() const noexcept { return closed_; }
+    // a coroutine is parked on a read
+    bool waiting() const noexcept { return bool(waiter_); }
+
+    // ---- I/O side
+    // Writable space of at least min_free bytes after the buffered data
+    span<std::byte> prepare(std::size_t min_free = 1) {
+        if (buf_.size() - tail_ < min_free) make_room(min_free);
+        return { buf_.data() + tail_, buf_.size() - tail_ };
+    }
+
+    // n bytes were written into prepare()'s span; may resume the reader
+    void commit(std::size_t n) {
+        BYTESTREAM_ASSERT(n <= buf_.size() - tail_);
+        tail_ += n;
+        wake();
+    }
+
+    void feed(const void* data, std::size_t n) {
+        if (!n) return;
+        std::memcpy(prepare(n).data(), data, n);
+        commit(n);
+    }
+    void feed(span<const std::byte> s) { feed(s.data(), s.size()); }
+
+    // End of stream: a parked read finishes or throws UnderflowException
+    void close() {
+        closed_ = true;
+        wake();
+    }
+
+    // ---- coroutine side
+    template <typename T>
+    auto read_le() { return detail::async_read<fixed_op<T, false>>(*this, {}); }
+    template <typename T>
+    auto read_be() { return detail::async_read<fixed_op<T, true>>(*this, {}); }
+
+    // n raw bytes in place
+    auto read_bytes(std::size_t n) { return detail::async_read<bytes_op>(*this, bytes_op{ {}, n, nullptr }); }
+    auto read_string(std::size_t n) { return detail::async_read<string_op>(*this, string_op{ {}, n, {} }); }
+
+    // A length-prefixed payload as a Reader (complete frame only)
+    template <length_prefix P = length_prefix::u32_le>
+    auto read_frame() { return detail::async_read<frame_op<P>>(*this, {}); }
+
+    // read_field<T, P> once enough bytes have arrived
+    template <typename T, length_prefix P = length_prefix::u32_le>
+    auto read_field() { return detail::async_read<field_op<T, P>>(*this, {}); }
+    template <typename T, length_prefix P = length_prefix::u32_le>
+    auto read_vector() { return read_field<std::vector<T>, P>(); }
+
+    // Buffered bytes / consume, for custom ops
+    span<const std::byte> peek() const noexcept { return { buf_.data() + head_, buffered() }; }
+    const std::byte* consume(std::size_t n) noexcept {
+        BYTESTREAM_ASSERT(n <= buffered());
+        const std::byte* p = buf_.data() + head_;
+        head_ += n;
+        return p;
+    }
+
+private:
+    template <typename T, bool Big>
+    struct fixed_op : detail::async_op_base {
+        T value{};
+        bool try_complete(AsyncReader& in) noexcept {
+            if (in.buffered() < sizeof(T)) return false;
+            const std::byte* p = in.consume(sizeof(T));
+            if constexpr (sizeof(T) == 1) value = load_native<T>(p);
+            else if constexpr (Big) value = load_be<T>(p);
+            else value = load_le<T>(p);
+            done = true;
+            return true;
+        }
+        T result() noexcept { return value; }
+    };
+
+    struct bytes_op : detail::async_op_base {
+        std::size_t      n;
+        const std::byte* p;
+        bool try_complete(AsyncReader& in) noexcept {
+            if (in.buffered() < n) return false;
+            p = in.consume(n);
+            done = true;
+            return true;
+        }
+        span<const std::byte> result() noexcept { return { p, n }; }
+    };
+
+    struct string_op : detail::async_op_base {
+        std::size_t n;
+        std::string value;
+        bool try_complete(AsyncReader& in) {
+            if (in.buffered() < n) return false;
+            if (in.budget_) in.budget_->check_string(n);
+            value.assign(reinterpret_cast<const char*>(in.consume(n)), n);
+            done = true;
+            return true;
+        }
+        std::string result() noexcept { return std::move(value); }
+    };
+
+    template <length_prefix P>
+    struct frame_op : detail::async_op_base {
+        const std::byte* p = nullptr;
+        std::size_t      n = 0;
+        bool try_complete(AsyncReader& in) {
+            const auto b = in.peek();
+            std::size_t hdr = 0;
+            if constexpr (P == length_prefix::varint) {
+                std::size_t i = 0;
+                while (i < b.size() && i < 10 && (std::to_integer<unsigned>(b.data()[i]) & 0x80u)) ++i;
+                if (i == b.size()) return false; // prefix still incomplete
+                Reader r(b.data(), b.size());
+                n   = r.read_varint_length();
+                hdr = r.position();
+            } else {
+                if (b.size() < 4) return false;
+                n   = load_le<std::uint32_t>(b.data());
+                hdr = 4;
+            }
+            if (in.budget_) in.budget_->check_string(n);
+            if (b.size() - hdr < n) return false;
+            in.consume(hdr);
+            p = in.consume(n);
+            done = true;
+            return true;
+        }
+        Reader result() const noexcept { return Reader(p, n); }
+    };
+
+    template <typename T, length_prefix P>
+    struct field_op : detail::async_op_base {
+        std::optional<T> value;
+        std::size_t      tried = 0; // buffered() at the last failed attempt
+        bool try_complete(AsyncReader& in) {
+            const auto b = in.peek();
+            if (b.size() == 0 || (tried && b.size() <= tried)) return false;
+            Reader r(b.data(), b.size());
+            // charge a scratch copy so failed attempts leave the budget alone
+            std::optional<DecodeBudget> trial;
+            if (in.budget_) r.set_budget(&trial.emplace(*in.budget_));
+            try {
+                value.emplace(bytestream::read_field<T, P>(r));
+            } catch (const UnderflowException&) {
+                tried = b.size();
+                return false;
+            }
+            if (in.budget_) *in.budget_ = *trial;
+            in.consume(r.position());
+            done = true;
+            return true;
+        }
+        T result() { return std::move(*value); }
+    };
+
+    void park(std::coroutine_handle<> h, void* op, bool (*poll)(void*, AsyncReader&)) noexcept {
+        BYTESTREAM_ASSERT(!waiter_); // one pending read per reader
+        waiter_ = h;
+        op_     = op;
+        poll_   = poll;
+    }
+
+    void wake() {
+        if (!waiter_) return;
+        if (!poll_(op_, *this) && !closed_) return;
+        std::exchange(waiter_, nullptr).resume();
+    }
+
+    // Drop consumed bytes, then grow if still short
+    BYTESTREAM_NOINLINE void make_room(std::size_t min_free) {
+        if (head_) {
+            const std::size_t live = buffered();
+            if (live) std::memmove(buf_.data(), buf_.data() + head_, live);
+            consumed_ += head_;
+            head_ = 0;
+            tail_ = live;
+        }
+        if (buf_.size() - tail_ < min_free) buf_.resize(std::max(buf_.size() * 2, tail_ + min_free));
+    }
+};
+
+template <typename Op>
+inline bool detail::async_read<Op>::await_suspend(std::coroutine_handle<> h) {
+    if (in_->closed_) return false;
+    in_->park(h, this, &poll);
+    return true;
+}
+
+} // namespace bytestream
+
+#endif // coroutines
+
+#endif // BYTESTREAM_ASYNC_READER_HPP
@@ -0,0 +1,239 @@
+#ifndef BYTESTREAM_BIT_STREAM_HPP
+#define BYTESTREAM_BIT_STREAM_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <cstring>
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Bit-granular fields on top of a byte sink/source.
+//
+// msb_first: fields fill each byte from bit 7 down (network protocols,
+//            codecs like H.264/MPEG)
+// lsb_first: fields fill each byte from bit 0 up (DEFLATE, many sensor
+//            formats)
+// ------------------------------------------------------------------
+enum class bit_order { msb_first, lsb_first };
+
+namespace detail {
+
+constexpr std::uint64_t low_bits_mask(unsigned n) noexcept {
+    return n >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Writer: bits collect in a 64-bit accumulator and whole bytes go to
+// Sink (Writer, DynamicWriter, GatherWriter, ...) in one copy per flush.
+// flush() pads the last partial byte with zero bits; the destructor
+// does not flush.
+// ------------------------------------------------------------------
+template <typename Sink = Writer, bit_order Order = bit_order::msb_first>
+class BitWriter {
+    Sink&         sink_;
+    std::uint64_t acc_  = 0; // msb_first: right-aligned; lsb_first: bit 0 is the oldest
+    unsigned      bits_ = 0;
+    std::size_t   total_ = 0;
+public:
+    explicit BitWriter(Sink& sink) noexcept : sink_(sink) {}
+
+    // bits written so far (including buffered ones)
+    std::size_t bit_position() const noexcept { return total_; }
+    unsigned bits_buffered() const noexcept { return bits_; }
+
+    // Write the low n bits of v (n <= 64)
+    void write_bits(std::uint64_t v, unsigned n) {
+        BYTESTREAM_ASSERT(n <= 64);
+        if (n > 56) {
+            if constexpr (Order == bit_order::msb_first) {
+                write_bits(v >> 32, n - 32);
+                write_bits(v, 32);
+            } else {
+                write_bits(v, 32);
+                write_bits(v >> 32, n - 32);
+            }
+            return;
+        }
+        if (!n) return;
+        if (bits_ + n > 64) emit();
+        v &= detail::low_bits_mask(n);
+        if constexpr (Order == bit_order::msb_first) {
+            acc_ = (acc_ << n) | v;
+        } else {
+            acc_ |= v << bits_;
+        }
+        bits_  += n;
+        total_ += n;
+    }
+
+    void write_bit(bool b) { write_bits(b ? 1u : 0u, 1); }
+
+    // Pad with zero bits up to the next byte boundary
+    void align_to_byte() {
+        const unsigned pad = (8 - (bits_ & 7)) & 7;
+        if (pad) write_bits(0, pad);
+    }
+
+    // Pad to a byte boundary and hand every buffered byte to the sink
+    void flush() {
+        align_to_byte();
+        emit();
+    }
+
+private:
+    // Move the whole bytes of the accumulator to the sink (one write)
+    void emit() {
+        const unsigned nbytes = bits_ >> 3;
+        if (!nbytes) return;
+        std::byte buf[8];
+        if constexpr (Order == bit_order::msb_first) {
+            std::uint64_t out = acc_ << (64 - bits_);
+            if constexpr (is_little_endian()) out = byteswap(out);
+            std::memcpy(buf, &out, 8);
+            bits_ -= nbytes * 8;
+            acc_ &= detail::low_bits_mask(bits_);
+        } else {
+            std::uint64_t out = acc_;
+            if constexpr (is_big_endian()) out = byteswap(out);
+            std::memcpy(buf, &out, 8);
+            bits_ -= nbytes * 8;
+            acc_ = nbytes == 8 ? 0 : acc_ >> (nbytes * 8);
+        }
+        // copied in: buf dies here, and a by-reference sink must not keep it
+        detail::write_inline(sink_, buf, nbytes);
+    }
+};
+
+// ------------------------------------------------------------------
+// Reader: keeps a 64-bit accumulator and refills it with one unaligned
+// 8-byte load whenever 8 bytes are contiguous in Source (byte by byte
+// near the end). Only the bytes merged into the accumulator are
+// consumed from Source. read_bits(n) handles n <= 64, peek_bits(n)
+// n <= 56. Running out throws UnderflowException.
+// ------------------------------------------------------------------
+template <typename Source = Reader, bit_order Order = bit_order::msb_first>
+class BitReader {
+    Source&       src_;
+    std::uint64_t acc_  = 0; // msb_first: next bit at bit 63; lsb_first: at bit 0
+    unsigned      bits_ = 0;
+    std::size_t   total_ = 0;
+public:
+    explicit BitReader(Source& src) noexcept : src_(src) {}
+
+    // bits consumed so far
+    std::size_t bit_position() const noexcept { return total_; }
+    unsigned bits_buffered() const noexcept { return bits_; }
+
+    // Next n bits without consuming them (n <= 56)
+    std::uint64_t peek_bits(unsigned n) {
+        BYTESTREAM_ASSERT(n <= 56);
+        if (bits_ < n) refill(n);
+        if (!n) return 0;
+        if constexpr (Order == bit_order::msb_first) return acc_ >> (64 - n);
+        else return acc_ & detail::low_bits_mask(n);
+    }
+
+    void skip_bits(unsigned n) {
+        while (n > 56) {
+            peek_bits(56);
+            consume(56);
+            n -= 56;
+        }
+        peek_bits(n);
+        consume(n);
+    }
+
+    std::uint64_t read_bits(unsigned n) {
+        BYTESTREAM_ASSERT(n <= 64);
+        if (n > 56) {
+            if constexpr (Order == bit_order::msb_first) {
+                const std::uint64_t hi = read_bits(n - 32);
+                return (hi << 32) | read_bits(32);
+            } else {
+                const std::uint64_t lo = read_bits(32);
+                return lo | (read_bits(n - 32) << 32);
+            }
+        }
+        const std::uint64_t v = peek_bits(n);
+        consume(n);
+        return v;
+    }
+
+    bool read_bit() { return read_bits(1) != 0; }
+
+    // Sign-extend an n-bit two's complement field
+    std::int64_t read_signed_bits(unsigned n) {
+        const std::uint64_t v = read_bits(n);
+        if (n == 0 || n >= 64) return static_cast<std::int64_t>(v);
+        const std::uint64_t sign = std::uint64_t{1} << (n - 1);
+        return static_cast<std::int64_t>((v ^ sign) - sign);
+    }
+
+    // Drop bits up to the next byte boundary
+    void align_to_byte() { consume(bits_ & 7); }
+
+    // Byte-aligned copy: buffered bytes first, then straight from Source
+    void read_aligned_bytes(void* dst, std::size_t n) {
+        BYTESTREAM_ASSERT((bits_ & 7) == 0);
+        auto* out = static_cast<std::byte*>(dst);
+        while (n && bits_) {
+            *out++ = std::byte(read_bits(8));
+            --n;
+        }
+        if (n) {
+            src_.read_bytes(out, n);
+            total_ += n * 8;
+        }
+    }
+
+private:
+    void consume(unsigned n) noexcept {
+        BYTESTREAM_ASSERT(n <= bits_);
+        if constexpr (Order == bit_order::msb_first) acc_ = n >= 64 ? 0 : acc_ << n;
+        else acc_ = n >= 64 ? 0 : acc_ >> n;
+        bits_  -= n;
+        total_ += n;
+    }
+
+    // Make at least `need` bits available
+    void refill(unsigned need) {
+        const span<const std::byte> avail = src_.peek_contiguous();
+        if (avail.size() >= 8) {
+            // merge as many whole bytes as fit (56..63 bits afterwards)
+            const unsigned k = (63 - bits_) >> 3;
+            if constexpr (Order == bit_order::msb_first) {
+                acc_ |= load_be<std::uint64_t>(avail.data()) >> bits_;
+            } else {
+                acc_ |= load_le<std::uint64_t>(avail.data()) << bits_;
+            }
+            src_.take(k);
+            bits_ += k * 8;
+            clear_unowned();
+            return;
+        }
+        refill_slow(need);
+    }
+
+    BYTESTREAM_NOINLINE void refill_slow(unsigned need) {
+        while (bits_ < need) {
+            const auto b = static_cast<std::uint8_t>(*src_.take(1));
+            if constexpr (Order == bit_order::msb_first) acc_ |= std::uint64_t(b) << (56 - bits_);
+            else acc_ |= std::uint64_t(b) << bits_;
+            bits_ += 8;
+        }
+    }
+
+    // Zero the bits past bits_ so the byte-wise path can OR into them
+    void clear_unowned() noexcept {
+        if constexpr (Order == bit_order::msb_first) acc_ &= ~detail::low_bits_mask(64 - bits_);
+        else acc_ &= detail::low_bits_mask(bits_);
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_BIT_STREAM_HPP
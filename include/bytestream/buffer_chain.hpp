@@ -0,0 +1,229 @@
+#ifndef BYTESTREAM_BUFFER_CHAIN_HPP
+#define BYTESTREAM_BUFFER_CHAIN_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <bytestream/dynamic_writer.hpp>
+#include <bytestream/gather_writer.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace bytestream {
+
+class ChainReader; // fwd
+
+// ------------------------------------------------------------------
+// Ordered list of byte ranges that forms one message without copying
+// them together (header buffer + forwarded body + trailer).
+//
+//   bytestream::BufferChain msg;
+//   msg.append(header);                  // Writer: its written_view()
+//   msg.append(body_bytes);              // any span<const std::byte>
+//   msg.append(trailer);
+//   auto r = msg.as_reader();            // one cursor over all three
+//   auto len = r.read_le<std::uint32_t>();
+//   ::writev(fd, msg.iovecs().data(), int(msg.segment_count()));
+//
+// The chain only refers to the bytes: they must stay valid and
+// unchanged while the chain and its readers are used. Empty ranges are
+// dropped, so segment_count() counts non-empty segments.
+// ------------------------------------------------------------------
+class BufferChain {
+    std::vector<span<const std::byte>> segments_;
+    std::size_t                        size_ = 0;
+public:
+    BufferChain() = default;
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t segment_count() const noexcept { return segments_.size(); }
+    span<const std::byte> segment(std::size_t i) const noexcept { return segments_[i]; }
+    const std::vector<span<const std::byte>>& segments() const noexcept { return segments_; }
+
+    void reserve(std::size_t segments) { segments_.reserve(segments); }
+    void clear() noexcept {
+        segments_.clear();
+        size_ = 0;
+    }
+
+    // ---- append by reference
+    void append(span<const std::byte> s) {
+        if (!s.size()) return;
+        segments_.push_back(s);
+        size_ += s.size();
+    }
+    void append(const void* data, std::size_t n) {
+        append(span<const std::byte>(static_cast<const std::byte*>(data), n));
+    }
+    void append(const Writer& w) { append(w.written_view()); }
+    void append(const NothrowWriter& w) { append(w.written_view()); }
+    template <typename Alloc>
+    void append(const BasicDynamicWriter<Alloc>& w) { append(w.written_view()); }
+    template <std::size_t N>
+    void append(const StaticWriter<N>& w) { append(w.written_view()); }
+    // a GatherWriter's segments (valid until its next write)
+    void append(const GatherWriter& w) {
+        for (const auto& s : w.segments()) append(s);
+    }
+    void append(const BufferChain& c) {
+        segments_.insert(segments_.end(), c.segments_.begin(), c.segments_.end());
+        size_ += c.size_;
+    }
+
+#if defined(BYTESTREAM_HAS_IOVEC)
+    // writev/sendmsg input; callers split batches above IOV_MAX
+    std::vector<::iovec> iovecs() const {
+        std::vector<::iovec> out;
+        out.reserve(segments_.size());
+        for (const auto& s : segments_)
+            out.push_back({ const_cast<std::byte*>(s.data()), s.size() });
+        return out;
+    }
+#endif
+
+    // Copy the whole message into dst (size() bytes)
+    void copy_to(void* dst) const noexcept {
+        auto* out = static_cast<std::byte*>(dst);
+        for (const auto& s : segments_) {
+            std::memcpy(out, s.data(), s.size());
+            out += s.size();
+        }
+    }
+
+    // Cursor over the chain; the chain must outlive it
+    ChainReader as_reader() const noexcept;
+};
+
+// ------------------------------------------------------------------
+// Reader over a BufferChain. Same decoding API as Reader. Reads inside
+// one segment take the Reader path (pointer into the segment); a field
+// that crosses a segment boundary is stitched together in a small
+// internal buffer, so pointers and views returned by take(),
+// view_string() and friends stay valid only until the next read.
+// read_bytes/skip copy or step across segments without stitching.
+// Underflow throws UnderflowException and leaves the cursor alone.
+// ------------------------------------------------------------------
+class ChainReader : public detail::reader_base<ChainReader> {
+    const BufferChain*     chain_   = nullptr;
+    std::size_t            seg_     = 0; // index of the current segment
+    std::size_t            before_  = 0; // bytes of the segments before it
+    const std::byte*       begin_   = nullptr;
+    const std::byte*       cur_     = nullptr;
+    const std::byte*       end_     = nullptr;
+    std::vector<std::byte> stitch_;
+public:
+    explicit ChainReader(const BufferChain& chain) noexcept : chain_(&chain) { enter(0); }
+
+    std::size_t size() const noexcept { return chain_->size(); }
+    std::size_t position() const noexcept { return before_ + std::size_t(cur_ - begin_); }
+    std::size_t remaining() const noexcept { return size() - position(); }
+    bool exhausted() const noexcept { return position() >= size(); }
+
+    span<const std::byte> peek_contiguous() const noexcept { return { cur_, buffered() }; }
+
+    void ensure(std::size_t n) const {
+        if (n > remaining()) underflow(n);
+    }
+
+    // Consume n bytes at the cursor and return a pointer to them
+    const std::byte* take(std::size_t n) {
+        if (n <= buffered()) {
+            const std::byte* p = cur_;
+            cur_ += n;
+            return p;
+        }
+        return stitch(n);
+    }
+
+    UncheckedReader unchecked(std::size_t n) {
+        UncheckedReader u{take(n), n};
+        u.set_budget(budget_);
+        return u;
+    }
+
+    void rewind() noexcept {
+        before_ = 0;
+        enter(0);
+    }
+
+    // ---- overrides that copy/drop straight across segments (no stitching)
+    void read_bytes(void* dst, std::size_t n) {
+        if (n <= buffered()) {
+            if (n) std::memcpy(dst, cur_, n);
+            cur_ += n;
+            return;
+        }
+        ensure(n);
+        auto* out = static_cast<std::byte*>(dst);
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            if (k) std::memcpy(out, cur_, k);
+            cur_ += k;
+            out  += k;
+            n    -= k;
+            if (!n) return;
+            next_segment();
+        }
+    }
+    void read_bytes(span<std::byte> out) { read_bytes(out.data(), out.size()); }
+
+    void skip(std::size_t n) {
+        ensure(n);
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            cur_ += k;
+            n    -= k;
+            if (!n) return;
+            next_segment();
+        }
+    }
+
+private:
+    std::size_t buffered() const noexcept { return std::size_t(end_ - cur_); }
+
+    [[noreturn]] static void underflow(std::size_t missing) {
+        BYTESTREAM_COUNT(underflow, missing);
+        (void)missing;
+        BYTESTREAM_THROW(UnderflowException("bytestream::ChainReader underflow"));
+    }
+
+    void enter(std::size_t i) noexcept {
+        seg_ = i;
+        if (i < chain_->segment_count()) {
+            const span<const std::byte> s = chain_->segment(i);
+            begin_ = cur_ = s.data();
+            end_   = begin_ + s.size();
+        } else {
+            begin_ = cur_ = end_ = nullptr;
+        }
+    }
+    // callers have checked that bytes are left
+    void next_segment() noexcept {
+        before_ += std::size_t(end_ - begin_);
+        enter(seg_ + 1);
+    }
+
+    // Step past an exhausted segment, or gather n bytes spanning
+    // segments into stitch_
+    BYTESTREAM_NOINLINE const std::byte* stitch(std::size_t n) {
+        ensure(n);
+        if (!buffered()) {
+            next_segment();
+            if (n <= buffered()) {
+                const std::byte* p = cur_;
+                cur_ += n;
+                return p;
+            }
+        }
+        stitch_.resize(n);
+        read_bytes(stitch_.data(), n);
+        return stitch_.data();
+    }
+};
+
+inline ChainReader BufferChain::as_reader() const noexcept { return ChainReader{*this}; }
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_BUFFER_CHAIN_HPP
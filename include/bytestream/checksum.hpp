@@ -0,0 +1,386 @@
+#ifndef BYTESTREAM_CHECKSUM_HPP
+#define BYTESTREAM_CHECKSUM_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <cstring>
+
+// -------------------------------------------------------------
+// Checksums and checksum-accumulating adapters.
+//
+// CRC32C (Castagnoli) selection:
+//   - SSE4.2 crc32 when enabled at compile time
+//   - SSE4.2 picked at runtime on GCC/Clang x86 builds without it
+//   - ARMv8 CRC32 extension (__ARM_FEATURE_CRC32)
+//   - slicing-by-8 tables
+// XXH64 is portable scalar code.
+// Define BYTESTREAM_NO_SIMD to force the table/scalar paths.
+// -------------------------------------------------------------
+#if !defined(BYTESTREAM_NO_SIMD)
+#  if defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_X64))
+#    include <nmmintrin.h>
+#    define BYTESTREAM_CRC32C_SSE42 1
+#  elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#    include <nmmintrin.h>
+#    define BYTESTREAM_CRC32C_SSE42 1
+#    define BYTESTREAM_CRC32C_RUNTIME_DISPATCH 1
+#  elif defined(__ARM_FEATURE_CRC32)
+#    include <arm_acle.h>
+#    define BYTESTREAM_CRC32C_ARM 1
+#  endif
+#endif
+
+namespace bytestream {
+namespace detail {
+
+// ---- CRC32C, reflected polynomial 0x82F63B78
+struct crc32c_tables {
+    std::uint32_t t[8][256];
+};
+
+constexpr crc32c_tables make_crc32c_tables() noexcept {
+    crc32c_tables tab{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1u)));
+        tab.t[0][i] = c;
+    }
+    for (std::uint32_t i = 0; i < 256; ++i)
+        for (int s = 1; s < 8; ++s) tab.t[s][i] = (tab.t[s - 1][i] >> 8) ^ tab.t[0][tab.t[s - 1][i] & 0xFFu];
+    return tab;
+}
+
+inline constexpr crc32c_tables crc32c_table = make_crc32c_tables();
+
+// `crc` is the raw register (pre-inverted by the caller)
+inline std::uint32_t crc32c_sw(std::uint32_t crc, const std::byte* p, std::size_t n) noexcept {
+    const auto& t = crc32c_table.t;
+    for (; n >= 8; n -= 8, p += 8) {
+        const std::uint64_t v = load_le<std::uint64_t>(p) ^ crc;
+        crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^ t[5][(v >> 16) & 0xFF] ^ t[4][(v >> 24) & 0xFF] ^
+              t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^ t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+    }
+    for (; n; --n, ++p) crc = (crc >> 8) ^ t[0][(crc ^ static_cast<std::uint8_t>(*p)) & 0xFF];
+    return crc;
+}
+
+#if defined(BYTESTREAM_CRC32C_SSE42)
+#  if defined(BYTESTREAM_CRC32C_RUNTIME_DISPATCH)
+#    define BYTESTREAM_TARGET_SSE42 __attribute__((target("sse4.2")))
+#  else
+#    define BYTESTREAM_TARGET_SSE42
+#  endif
+
+BYTESTREAM_TARGET_SSE42 inline std::uint32_t crc32c_hw(std::uint32_t crc, const std::byte* p, std::size_t n) noexcept {
+    std::uint64_t c = crc;
+    for (; n >= 8; n -= 8, p += 8) {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+    auto c32 = static_cast<std::uint32_t>(c);
+    for (; n; --n, ++p) c32 = _mm_crc32_u8(c32, static_cast<std::uint8_t>(*p));
+    return c32;
+}
+
+#  if defined(BYTESTREAM_CRC32C_RUNTIME_DISPATCH)
+inline bool cpu_has_sse42() noexcept {
+    static const bool has = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2") != 0;
+    }();
+    return has;
+}
+#  endif
+
+#elif defined(BYTESTREAM_CRC32C_ARM)
+
+inline std::uint32_t crc32c_hw(std::uint32_t crc, const std::byte* p, std::size_t n) noexcept {
+    for (; n >= 8; n -= 8, p += 8) {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+    for (; n; --n, ++p) crc = __crc32cb(crc, static_cast<std::uint8_t>(*p));
+    return crc;
+}
+
+#endif
+
+inline std::uint32_t crc32c_raw(std::uint32_t crc, const void* data, std::size_t n) noexcept {
+    const auto* p = static_cast<const std::byte*>(data);
+#if defined(BYTESTREAM_CRC32C_RUNTIME_DISPATCH)
+    return cpu_has_sse42() ? crc32c_hw(crc, p, n) : crc32c_sw(crc, p, n);
+#elif defined(BYTESTREAM_CRC32C_SSE42) || defined(BYTESTREAM_CRC32C_ARM)
+    return crc32c_hw(crc, p, n);
+#else
+    return crc32c_sw(crc, p, n);
+#endif
+}
+
+// ---- XXH64
+inline constexpr std::uint64_t xxh64_p1 = 0x9E3779B185EBCA87ull;
+inline constexpr std::uint64_t xxh64_p2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr std::uint64_t xxh64_p3 = 0x165667B19E3779F9ull;
+inline constexpr std::uint64_t xxh64_p4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr std::uint64_t xxh64_p5 = 0x27D4EB2F165667C5ull;
+
+constexpr std::uint64_t rotl64(std::uint64_t x, int r) noexcept { return (x << r) | (x >> (64 - r)); }
+
+constexpr std::uint64_t xxh64_round(std::uint64_t acc, std::uint64_t input) noexcept {
+    return rotl64(acc + input * xxh64_p2, 31) * xxh64_p1;
+}
+constexpr std::uint64_t xxh64_merge(std::uint64_t acc, std::uint64_t v) noexcept {
+    return (acc ^ xxh64_round(0, v)) * xxh64_p1 + xxh64_p4;
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Hashers: update() any number of times, digest() at any point
+// ------------------------------------------------------------------
+class Crc32c {
+    std::uint32_t crc_ = 0xFFFFFFFFu;
+public:
+    using digest_type = std::uint32_t;
+
+    void update(const void* data, std::size_t n) noexcept { crc_ = detail::crc32c_raw(crc_, data, n); }
+    digest_type digest() const noexcept { return ~crc_; }
+    void reset() noexcept { crc_ = 0xFFFFFFFFu; }
+};
+
+class XxHash64 {
+    std::uint64_t seed_;
+    std::uint64_t v_[4];
+    std::byte     buf_[32];
+    std::size_t   buffered_ = 0;
+    std::uint64_t total_    = 0;
+public:
+    using digest_type = std::uint64_t;
+
+    explicit XxHash64(std::uint64_t seed = 0) noexcept : seed_(seed) { reset(); }
+
+    void reset() noexcept {
+        v_[0] = seed_ + detail::xxh64_p1 + detail::xxh64_p2;
+        v_[1] = seed_ + detail::xxh64_p2;
+        v_[2] = seed_;
+        v_[3] = seed_ - detail::xxh64_p1;
+        buffered_ = 0;
+        total_    = 0;
+    }
+
+    void update(const void* data, std::size_t n) noexcept {
+        const auto* p = static_cast<const std::byte*>(data);
+        total_ += n;
+        if (buffered_) {
+            const std::size_t k = n < 32 - buffered_ ? n : 32 - buffered_;
+            std::memcpy(buf_ + buffered_, p, k);
+            buffered_ += k;
+            p += k;
+            n -= k;
+            if (buffered_ < 32) return;
+            stripe(buf_);
+            buffered_ = 0;
+        }
+        for (; n >= 32; n -= 32, p += 32) stripe(p);
+        if (n) {
+            std::memcpy(buf_, p, n);
+            buffered_ = n;
+        }
+    }
+
+    digest_type digest() const noexcept {
+        using namespace detail;
+        std::uint64_t h;
+        if (total_ >= 32) {
+            h = rotl64(v_[0], 1) + rotl64(v_[1], 7) + rotl64(v_[2], 12) + rotl64(v_[3], 18);
+            for (auto v : v_) h = xxh64_merge(h, v);
+        } else {
+            h = v_[2] + xxh64_p5;
+        }
+        h += total_;
+
+        const std::byte* p = buf_;
+        std::size_t n = buffered_;
+        for (; n >= 8; n -= 8, p += 8) h = rotl64(h ^ xxh64_round(0, load_le<std::uint64_t>(p)), 27) * xxh64_p1 + xxh64_p4;
+        if (n >= 4) {
+            h = rotl64(h ^ (std::uint64_t(load_le<std::uint32_t>(p)) * xxh64_p1), 23) * xxh64_p2 + xxh64_p3;
+            p += 4;
+            n -= 4;
+        }
+        for (; n; --n, ++p) h = rotl64(h ^ (std::uint64_t(static_cast<std::uint8_t>(*p)) * xxh64_p5), 11) * xxh64_p1;
+
+        h ^= h >> 33;
+        h *= xxh64_p2;
+        h ^= h >> 29;
+        h *= xxh64_p3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    void stripe(const std::byte* p) noexcept {
+        for (int i = 0; i < 4; ++i) v_[i] = detail::xxh64_round(v_[i], load_le<std::uint64_t>(p + 8 * i));
+    }
+};
+
+// One-shot helpers
+inline std::uint32_t crc32c(const void* data, std::size_t n) noexcept {
+    Crc32c h;
+    h.update(data, n);
+    return h.digest();
+}
+inline std::uint64_t xxh64(const void* data, std::size_t n, std::uint64_t seed = 0) noexcept {
+    XxHash64 h(seed);
+    h.update(data, n);
+    return h.digest();
+}
+
+// ------------------------------------------------------------------
+// Trailer: u64 LE byte count + digest LE, appended after the covered bytes
+// ------------------------------------------------------------------
+template <typename Hasher>
+inline constexpr std::size_t checksum_trailer_size = 8 + sizeof(typename Hasher::digest_type);
+
+// ------------------------------------------------------------------
+// Writer adapter: forwards to Sink (anything with claim(), e.g. Writer,
+// DynamicWriter, MappedFileWriter) and hashes what was written.
+// Claimed bytes are hashed right before the next claim (they are still
+// in cache), or at digest()/write_trailer(). Don't touch the sink
+// directly while the adapter is in use. Over a sticky sink
+// (NothrowWriter) the adapter is sticky too: refused bytes are not
+// hashed and ok()/error() report the sink's state.
+// ------------------------------------------------------------------
+template <typename Sink, typename Hasher = Crc32c>
+class ChecksumWriter : public detail::writer_base<ChecksumWriter<Sink, Hasher>> {
+    Sink&       sink_;
+    Hasher      hasher_;
+    std::byte*  pending_   = nullptr;
+    std::size_t pending_n_ = 0;
+    std::size_t covered_   = 0;
+public:
+    using digest_type = typename Hasher::digest_type;
+    static constexpr bool sticky_errors = ::bytestream::detail::sticky_errors<Sink>::value;
+
+    explicit ChecksumWriter(Sink& sink, Hasher hasher = Hasher()) : sink_(sink), hasher_(std::move(hasher)) {}
+
+    std::size_t position() const noexcept { return sink_.position(); }
+    // bytes hashed so far
+    std::size_t covered_bytes() const noexcept { return covered_ + pending_n_; }
+
+    // sticky sinks only
+    bool ok() const noexcept { return sink_.ok(); }
+    errc error() const noexcept { return sink_.error(); }
+    explicit operator bool() const noexcept { return ok(); }
+    void fail(errc e) noexcept { sink_.fail(e); }
+
+    std::byte* claim(std::size_t n) {
+        flush();
+        std::byte* p = sink_.claim(n);
+        pending_   = p;
+        pending_n_ = p ? n : 0; // a sticky sink refused the claim
+        return p;
+    }
+
+    // Scalars and other by-value fields are claimed and copied (they may
+    // be temporaries, so a by-reference sink must not see them)
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable<T>::value, void>
+    write(const T& v) {
+        if (std::byte* p = claim(sizeof(T))) std::memcpy(p, &v, sizeof(T));
+    }
+
+    // Hash the caller's bytes directly (keeps by-reference sinks zero-copy
+    // for blobs the caller owns)
+    void write_bytes(const void* src, std::size_t n) {
+        flush();
+        sink_.write_bytes(src, n);
+        if constexpr (sticky_errors) {
+            if (!sink_.ok()) return;
+        }
+        hasher_.update(src, n);
+        covered_ += n;
+    }
+
+    digest_type digest() {
+        flush();
+        return hasher_.digest();
+    }
+
+    // Append the trailer (not itself hashed) and restart the checksum
+    digest_type write_trailer() {
+        const digest_type d = digest();
+        sink_.template write_le<std::uint64_t>(covered_);
+        sink_.template write_le<digest_type>(d);
+        hasher_.reset();
+        covered_ = 0;
+        return d;
+    }
+
+private:
+    void flush() noexcept {
+        if (pending_n_) {
+            hasher_.update(pending_, pending_n_);
+            covered_ += pending_n_;
+            pending_n_ = 0;
+        }
+    }
+};
+
+// ------------------------------------------------------------------
+// Reader adapter: hashes every byte consumed from Source. Over a sticky
+// source (NothrowReader) it is sticky too, and a mismatching trailer
+// records errc::format instead of throwing.
+// ------------------------------------------------------------------
+template <typename Source, typename Hasher = Crc32c>
+class ChecksumReader : public detail::reader_base<ChecksumReader<Source, Hasher>> {
+    Source&     src_;
+    Hasher      hasher_;
+    std::size_t covered_ = 0;
+public:
+    using digest_type = typename Hasher::digest_type;
+    static constexpr bool sticky_errors = ::bytestream::detail::sticky_errors<Source>::value;
+
+    explicit ChecksumReader(Source& src, Hasher hasher = Hasher()) : src_(src), hasher_(std::move(hasher)) {
+        this->set_budget(src.budget());
+    }
+
+    std::size_t position() const noexcept { return src_.position(); }
+    std::size_t covered_bytes() const noexcept { return covered_; }
+
+    span<const std::byte> peek_contiguous() const noexcept { return src_.peek_contiguous(); }
+
+    // sticky sources only
+    bool ok() const noexcept { return src_.ok(); }
+    errc error() const noexcept { return src_.error(); }
+    explicit operator bool() const noexcept { return ok(); }
+    void fail(errc e) noexcept { src_.fail(e); }
+
+    const std::byte* take(std::size_t n) {
+        const std::byte* p = src_.take(n);
+        if (!p) return p; // a sticky source ran short
+        hasher_.update(p, n);
+        covered_ += n;
+        return p;
+    }
+
+    digest_type digest() const noexcept { return hasher_.digest(); }
+
+    // Read the trailer from Source and compare; throws FormatException on
+    // mismatch. Restarts the checksum for the next frame.
+    void verify_trailer() {
+        const auto n = src_.template read_le<std::uint64_t>();
+        const auto d = src_.template read_le<digest_type>();
+        const bool match = n == covered_ && d == hasher_.digest();
+        hasher_.reset();
+        covered_ = 0;
+        if (match) return;
+        if constexpr (sticky_errors) src_.fail(errc::format);
+        else BYTESTREAM_THROW(FormatException("bytestream checksum mismatch"));
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_CHECKSUM_HPP
@@ -0,0 +1,252 @@
+#ifndef BYTESTREAM_COLUMNS_HPP
+#define BYTESTREAM_COLUMNS_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/serialization.hpp>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------------
+// Structure-of-arrays batches for fixed-layout schema types.
+//
+//   struct Tick {
+//       std::uint64_t ts;
+//       double        px;
+//       std::uint32_t qty;
+//       using bytestream_schema = bytestream::schema<
+//           bytestream::field_le<&Tick::ts>,
+//           bytestream::field_le<&Tick::px>,
+//           bytestream::field_le<&Tick::qty>>;
+//   };
+//
+//   bytestream::ColumnBatch<Tick> ticks;
+//   bytestream::read_vector_columns(reader, ticks);   // = read_field<std::vector<Tick>> layout
+//   const std::vector<double>& px = ticks.column<&Tick::px>();
+//
+// The wire format is unchanged: N records of S::fixed_size bytes back
+// to back (read_columns/write_columns), optionally behind the vector
+// length prefix (read_vector_columns/write_vector_columns). All N
+// records are bounds-checked with one take()/claim(); the transpose
+// then runs one column at a time over tiles of records small enough
+// to stay in L1, so every column loop is a constant-stride load/store
+// the compiler can unroll and vectorize. Every schema field must be
+// fixed-size (field_le/field_be, or field<> of a trivial member).
+// ------------------------------------------------------------------
+namespace bytestream {
+
+namespace detail {
+
+template <typename S>
+struct schema_columns;
+template <typename... F>
+struct schema_columns<schema<F...>> {
+    using vectors        = std::tuple<std::vector<typename F::member_type>...>;
+    using pointers       = std::tuple<typename F::member_type*...>;
+    using const_pointers = std::tuple<const typename F::member_type*...>;
+};
+
+// Byte offset of field I within a fixed record
+template <typename S, std::size_t I>
+constexpr std::size_t schema_field_offset() noexcept {
+    return fixed_run_size<S, 0>(std::make_index_sequence<I>{});
+}
+
+// Records per transpose tile: ~8 KiB of source, at least 16 rows
+template <typename S>
+inline constexpr std::size_t column_tile = std::max<std::size_t>(16, 8192 / S::fixed_size);
+
+template <typename S, std::size_t I, typename M>
+void load_column(const std::byte* src, std::size_t rows, M* out) noexcept {
+    using F = schema_field_t<S, I>;
+    constexpr std::size_t stride = S::fixed_size;
+    src += schema_field_offset<S, I>();
+    for (std::size_t k = 0; k < rows; ++k) F::load_value(src + k * stride, out[k]);
+}
+
+template <typename S, std::size_t I, typename M>
+void store_column(std::byte* dst, std::size_t rows, const M* in) noexcept {
+    using F = schema_field_t<S, I>;
+    constexpr std::size_t stride = S::fixed_size;
+    dst += schema_field_offset<S, I>();
+    for (std::size_t k = 0; k < rows; ++k) F::store_value(dst + k * stride, in[k]);
+}
+
+template <typename S, typename Ptrs, std::size_t... Is>
+void rows_to_columns(const std::byte* src, std::size_t n, const Ptrs& cols, std::index_sequence<Is...>) noexcept {
+    constexpr std::size_t tile = column_tile<S>;
+    for (std::size_t i = 0; i < n; i += tile) {
+        const std::size_t rows = std::min(tile, n - i);
+        const std::byte* block = src + i * S::fixed_size;
+        (load_column<S, Is>(block, rows, std::get<Is>(cols) + i), ...);
+    }
+}
+
+template <typename S, typename Ptrs, std::size_t... Is>
+void columns_to_rows(std::byte* dst, std::size_t n, const Ptrs& cols, std::index_sequence<Is...>) noexcept {
+    constexpr std::size_t tile = column_tile<S>;
+    for (std::size_t i = 0; i < n; i += tile) {
+        const std::size_t rows = std::min(tile, n - i);
+        std::byte* block = dst + i * S::fixed_size;
+        (store_column<S, Is>(block, rows, std::get<Is>(cols) + i), ...);
+    }
+}
+
+template <typename T>
+struct column_schema {
+    using type = typename schema_of<T>::type;
+    static_assert(std::is_same<typename type::class_type, T>::value, "columns: schema describes another type");
+    static_assert(type::all_fixed, "columns: every schema field must be fixed-size");
+    using indices = std::make_index_sequence<type::field_count>;
+};
+
+template <typename S, typename W, typename Ptrs>
+void write_rows(W& w, std::size_t n, const Ptrs& cols) {
+    using indices = std::make_index_sequence<S::field_count>;
+    if constexpr (has_claim<W>::value) {
+        if (n > std::numeric_limits<std::size_t>::max() / S::fixed_size)
+            BYTESTREAM_THROW(OverflowException("bytestream columns: batch too large"));
+        std::byte* dst = w.claim(n * S::fixed_size);
+        if constexpr (sticky_errors<W>::value) {
+            if (!dst) return;
+        }
+        columns_to_rows<S>(dst, n, cols, indices{});
+    } else {
+        // sinks without claim(): stage one tile at a time
+        constexpr std::size_t tile = column_tile<S>;
+        std::vector<std::byte> stage(std::min(n, tile) * S::fixed_size);
+        for (std::size_t i = 0; i < n; i += tile) {
+            const std::size_t rows = std::min(tile, n - i);
+            std::apply([&](auto*... p) { columns_to_rows<S>(stage.data(), rows, std::make_tuple((p + i)...), indices{}); },
+                       cols);
+            w.write_bytes(stage.data(), rows * S::fixed_size);
+        }
+    }
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// One std::vector per schema field, in schema order
+// ------------------------------------------------------------------
+template <typename T>
+class ColumnBatch {
+    using S = typename detail::column_schema<T>::type;
+    using indices = typename detail::column_schema<T>::indices;
+    typename detail::schema_columns<S>::vectors cols_;
+public:
+    using schema_type = S;
+    using pointers       = typename detail::schema_columns<S>::pointers;
+    using const_pointers = typename detail::schema_columns<S>::const_pointers;
+    static constexpr std::size_t row_size     = S::fixed_size;
+    static constexpr std::size_t column_count = S::field_count;
+
+    std::size_t size() const noexcept { return std::get<0>(cols_).size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // keeps the columns' capacity
+    void clear() noexcept { std::apply([](auto&... c) { (c.clear(), ...); }, cols_); }
+    void reserve(std::size_t n) { std::apply([n](auto&... c) { (c.reserve(n), ...); }, cols_); }
+    void resize(std::size_t n) { std::apply([n](auto&... c) { (c.resize(n), ...); }, cols_); }
+
+    template <std::size_t I> auto& column() noexcept { return std::get<I>(cols_); }
+    template <std::size_t I> const auto& column() const noexcept { return std::get<I>(cols_); }
+    template <auto Member, std::enable_if_t<std::is_member_object_pointer<decltype(Member)>::value, int> = 0>
+    auto& column() noexcept { return std::get<detail::schema_field_index<S, Member>()>(cols_); }
+    template <auto Member, std::enable_if_t<std::is_member_object_pointer<decltype(Member)>::value, int> = 0>
+    const auto& column() const noexcept {
+        return std::get<detail::schema_field_index<S, Member>()>(cols_);
+    }
+
+    // element pointers of every column, starting at row `first`
+    pointers data(std::size_t first = 0) noexcept {
+        return std::apply([first](auto&... c) { return pointers(c.data() + first...); }, cols_);
+    }
+    const_pointers data(std::size_t first = 0) const noexcept {
+        return std::apply([first](const auto&... c) { return const_pointers(c.data() + first...); }, cols_);
+    }
+
+    // array-of-structs bridge
+    void push_back(const T& row) { push_row(row, indices{}); }
+    T row(std::size_t i) const {
+        T out{};
+        get_row(i, out, indices{});
+        return out;
+    }
+
+private:
+    template <std::size_t... Is>
+    void push_row(const T& row, std::index_sequence<Is...>) {
+        (std::get<Is>(cols_).push_back(row.*detail::schema_field_t<S, Is>::member), ...);
+    }
+    template <std::size_t... Is>
+    void get_row(std::size_t i, T& out, std::index_sequence<Is...>) const {
+        ((out.*detail::schema_field_t<S, Is>::member = std::get<Is>(cols_)[i]), ...);
+    }
+};
+
+// ------------------------------------------------------------------
+// Decode n records (no length prefix) into column arrays of n elements
+// ------------------------------------------------------------------
+template <typename T, typename R, typename... M>
+void read_columns(R& r, std::size_t n, const std::tuple<M*...>& cols) {
+    using C = detail::column_schema<T>;
+    static_assert(std::is_same<std::tuple<M*...>, typename detail::schema_columns<typename C::type>::pointers>::value,
+                  "read_columns: one pointer per schema field, member types in schema order");
+    if (n > std::numeric_limits<std::size_t>::max() / C::type::fixed_size)
+        return detail::source_error(r, errc::underflow, "bytestream columns: batch too large");
+    const std::byte* src = r.take(n * C::type::fixed_size);
+    if (!detail::source_ok(r)) return;
+    detail::rows_to_columns<typename C::type>(src, n, cols, typename C::indices{});
+}
+
+// Append n records to the batch
+template <typename T, typename R>
+void read_columns(R& r, std::size_t n, ColumnBatch<T>& out) {
+    using S = typename ColumnBatch<T>::schema_type;
+    if (n > std::numeric_limits<std::size_t>::max() / S::fixed_size)
+        return detail::source_error(r, errc::underflow, "bytestream columns: batch too large");
+    const std::byte* src = r.take(n * S::fixed_size); // bounds-checked before growing
+    if (!detail::source_ok(r)) return;
+    const std::size_t first = out.size();
+    out.resize(first + n);
+    detail::rows_to_columns<S>(src, n, out.data(first), std::make_index_sequence<S::field_count>{});
+}
+
+// Decode the read_field<std::vector<T>> layout, replacing the batch contents
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void read_vector_columns(R& r, ColumnBatch<T>& out) {
+    const std::size_t n = detail::read_length<P>(r);
+    out.clear();
+    if (!detail::budget_collection(r, n, ColumnBatch<T>::row_size)) return;
+    read_columns(r, n, out);
+}
+
+// ------------------------------------------------------------------
+// Encode n records (no length prefix) from column arrays
+// ------------------------------------------------------------------
+template <typename T, typename W, typename... M>
+void write_columns(W& w, std::size_t n, const std::tuple<M*...>& cols) {
+    using C = detail::column_schema<T>;
+    using expected = typename detail::schema_columns<typename C::type>::const_pointers;
+    static_assert(std::is_same<std::tuple<const M*...>, expected>::value,
+                  "write_columns: one pointer per schema field, member types in schema order");
+    detail::write_rows<typename C::type>(w, n, expected(cols));
+}
+
+template <typename W, typename T>
+void write_columns(W& w, const ColumnBatch<T>& in) {
+    detail::write_rows<typename ColumnBatch<T>::schema_type>(w, in.size(), in.data());
+}
+
+// The write_field(std::vector<T>) layout: length prefix, then the records
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_vector_columns(W& w, const ColumnBatch<T>& in) {
+    detail::write_length<P>(w, in.size());
+    write_columns(w, in);
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_COLUMNS_HPP
@@ -0,0 +1,473 @@
+#ifndef BYTESTREAM_COMPRESSION_HPP
+#define BYTESTREAM_COMPRESSION_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// LZ4/Zstd codecs are available when linking ByteStream::compression,
+// which defines BYTESTREAM_HAS_LZ4 / BYTESTREAM_HAS_ZSTD for the
+// libraries it found. identity_codec is always available.
+#if defined(BYTESTREAM_HAS_LZ4)
+#  include <lz4.h>
+#endif
+#if defined(BYTESTREAM_HAS_ZSTD)
+#  include <zstd.h>
+#endif
+
+// ------------------------------------------------------------------
+// Block compression.
+//
+//   bytestream::DynamicWriter out;
+//   bytestream::CompressedWriter<bytestream::DynamicWriter, bytestream::lz4_codec> cw(out);
+//   write_field(cw, message);                // encoded into the current block
+//   cw.finish();                             // last block + end marker
+//
+//   bytestream::Reader in(out.data(), out.size());
+//   bytestream::CompressedReader<bytestream::Reader, bytestream::lz4_codec> cr(in);
+//   auto m = read_field<Message>(cr);        // blocks are decompressed on demand
+//
+// The writer encodes into one block-sized buffer and compresses it into
+// the sink when full, so a message never exists uncompressed in full.
+// The reader keeps one decompressed block. Both lease their buffers
+// from a ScratchPool (ScratchPool::shared() by default).
+//
+// Wire format (all little-endian):
+//   u32 magic "BSZ1", u8 codec id, u32 block size
+//   per block: u32 raw size, u32 stored size (bit 31: stored uncompressed), bytes
+//   u32 0 (end of stream)
+//
+// Codec interface:
+//   static constexpr std::uint8_t id;
+//   std::size_t max_compressed_size(std::size_t n) const;
+//   std::size_t compress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t cap);
+//                                            // 0: not compressible, store raw
+//   void decompress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t raw_n);
+//                                            // throws FormatException on bad input
+// ------------------------------------------------------------------
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Pool of reusable byte buffers (thread-safe)
+// ------------------------------------------------------------------
+class ScratchPool {
+    struct buffer {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t                  size = 0;
+    };
+
+    std::mutex          mutex_;
+    std::vector<buffer> free_;
+    std::size_t         max_cached_;
+public:
+    // Buffer on loan; returned to the pool on destruction
+    class lease {
+        ScratchPool* pool_ = nullptr;
+        buffer       buf_;
+    public:
+        lease() noexcept = default;
+        lease(ScratchPool* pool, buffer b) noexcept : pool_(pool), buf_(std::move(b)) {}
+        lease(lease&& o) noexcept : pool_(std::exchange(o.pool_, nullptr)), buf_(std::move(o.buf_)) {}
+        lease& operator=(lease&& o) noexcept {
+            if (this != &o) {
+                release();
+                pool_ = std::exchange(o.pool_, nullptr);
+                buf_  = std::move(o.buf_);
+            }
+            return *this;
+        }
+        ~lease() { release(); }
+
+        std::byte*  data() const noexcept { return buf_.data.get(); }
+        std::size_t size() const noexcept { return buf_.size; }
+
+    private:
+        void release() noexcept {
+            if (pool_) pool_->give_back(std::move(buf_));
+            pool_ = nullptr;
+        }
+    };
+
+    explicit ScratchPool(std::size_t max_cached = 16) noexcept : max_cached_(max_cached) {}
+    ScratchPool(const ScratchPool&) = delete;
+    ScratchPool& operator=(const ScratchPool&) = delete;
+
+    // Process-wide pool used when none is given
+    static ScratchPool& shared() {
+        static ScratchPool pool;
+        return pool;
+    }
+
+    // A buffer of at least n bytes (contents unspecified)
+    lease acquire(std::size_t n) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t i = free_.size(); i-- > 0;) {
+                if (free_[i].size >= n) {
+                    buffer b = std::move(free_[i]);
+                    free_.erase(free_.begin() + std::ptrdiff_t(i));
+                    return lease(this, std::move(b));
+                }
+            }
+        }
+        return lease(this, buffer{ std::unique_ptr<std::byte[]>(new std::byte[n ? n : 1]), n });
+    }
+
+    std::size_t cached() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+private:
+    void give_back(buffer b) noexcept {
+        if (!b.data) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < max_cached_) {
+            try { free_.push_back(std::move(b)); } catch (...) {}
+        }
+    }
+};
+
+// ------------------------------------------------------------------
+// Codecs
+// ------------------------------------------------------------------
+
+// Stores every block uncompressed (framing/tests)
+struct identity_codec {
+    static constexpr std::uint8_t id = 0;
+    std::size_t max_compressed_size(std::size_t) const noexcept { return 0; }
+    std::size_t compress(const std::byte*, std::size_t, std::byte*, std::size_t) noexcept { return 0; }
+    void decompress(const std::byte*, std::size_t, std::byte*, std::size_t) {
+        BYTESTREAM_THROW(FormatException("bytestream compression: identity codec cannot decompress"));
+    }
+};
+
+#if defined(BYTESTREAM_HAS_LZ4)
+struct lz4_codec {
+    static constexpr std::uint8_t id = 1;
+    int acceleration = 1;
+
+    std::size_t max_compressed_size(std::size_t n) const noexcept {
+        return std::size_t(LZ4_compressBound(int(n)));
+    }
+    std::size_t compress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t cap) noexcept {
+        const int r = LZ4_compress_fast(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                        int(n), int(cap), acceleration);
+        return r > 0 ? std::size_t(r) : 0;
+    }
+    void decompress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t raw_n) {
+        const int r = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                          int(n), int(raw_n));
+        if (r < 0 || std::size_t(r) != raw_n) BYTESTREAM_THROW(FormatException("bytestream compression: corrupt LZ4 block"));
+    }
+};
+#endif
+
+#if defined(BYTESTREAM_HAS_ZSTD)
+struct zstd_codec {
+    static constexpr std::uint8_t id = 2;
+    int level = 3;
+
+    explicit zstd_codec(int compression_level = 3) noexcept : level(compression_level) {}
+
+    std::size_t max_compressed_size(std::size_t n) const noexcept { return ZSTD_compressBound(n); }
+    std::size_t compress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t cap) {
+        if (!cctx_) cctx_.reset(ZSTD_createCCtx());
+        const std::size_t r = ZSTD_compressCCtx(cctx_.get(), dst, cap, src, n, level);
+        return ZSTD_isError(r) ? 0 : r;
+    }
+    void decompress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t raw_n) {
+        if (!dctx_) dctx_.reset(ZSTD_createDCtx());
+        const std::size_t r = ZSTD_decompressDCtx(dctx_.get(), dst, raw_n, src, n);
+        if (ZSTD_isError(r) || r != raw_n) BYTESTREAM_THROW(FormatException("bytestream compression: corrupt Zstd block"));
+    }
+
+private:
+    struct cctx_free { void operator()(ZSTD_CCtx* c) const noexcept { ZSTD_freeCCtx(c); } };
+    struct dctx_free { void operator()(ZSTD_DCtx* d) const noexcept { ZSTD_freeDCtx(d); } };
+    std::unique_ptr<ZSTD_CCtx, cctx_free> cctx_;
+    std::unique_ptr<ZSTD_DCtx, dctx_free> dctx_;
+};
+#endif
+
+namespace detail {
+
+inline constexpr std::uint32_t compression_magic  = 0x315A5342u; // "BSZ1"
+inline constexpr std::uint32_t block_stored_flag  = 0x80000000u;
+inline constexpr std::size_t   block_header_size  = 8;
+inline constexpr std::size_t   stream_header_size = 9;
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Writer: encodes into a block buffer, compresses full blocks into Sink
+// (anything with write_bytes, e.g. Writer, DynamicWriter, GatherWriter).
+// Blocks are copied into the sink's own memory via claim(), so sinks
+// that keep large write_bytes() by reference never see the reused
+// block buffer.
+// Call finish() after the last field; the destructor does not flush.
+// Claims larger than the block size are staged separately and split
+// into blocks on the next operation.
+// ------------------------------------------------------------------
+template <typename Sink, typename Codec = identity_codec>
+class CompressedWriter : public detail::writer_base<CompressedWriter<Sink, Codec>> {
+public:
+    static constexpr std::size_t default_block_size = std::size_t{64} << 10;
+
+    explicit CompressedWriter(Sink& sink, std::size_t block_size = default_block_size,
+                              Codec codec = Codec(), ScratchPool& pool = ScratchPool::shared())
+        : sink_(sink), codec_(std::move(codec)),
+          block_size_(std::clamp<std::size_t>(block_size, 1, detail::block_stored_flag - 1)),
+          block_(pool.acquire(block_size_)),
+          out_(pool.acquire(detail::block_header_size + std::max(block_size_, codec_.max_compressed_size(block_size_)))) {
+        std::byte h[detail::stream_header_size];
+        store_le<std::uint32_t>(h, detail::compression_magic);
+        h[4] = std::byte{Codec::id};
+        store_le<std::uint32_t>(h + 5, std::uint32_t(block_size_));
+        emit(h, sizeof(h));
+    }
+
+    CompressedWriter(const CompressedWriter&) = delete;
+    CompressedWriter& operator=(const CompressedWriter&) = delete;
+
+    // uncompressed bytes written so far
+    std::size_t position() const noexcept { return flushed_ + fill_ + (big_pending_ ? big_.size() : 0); }
+    std::size_t block_size() const noexcept { return block_size_; }
+    std::size_t blocks_written() const noexcept { return blocks_; }
+
+    std::byte* claim(std::size_t n) {
+        if (big_pending_) drain_big();
+        if (n > block_size_ - fill_) {
+            flush_block();
+            if (n > block_size_) {
+                big_.resize(n);
+                big_pending_ = true;
+                return big_.data();
+            }
+        }
+        std::byte* p = block_.data() + fill_;
+        fill_ += n;
+        return p;
+    }
+
+    // Copy straight into blocks, splitting as needed
+    void write_bytes(const void* src, std::size_t n) {
+        if (big_pending_) drain_big();
+        append(static_cast<const std::byte*>(src), n);
+    }
+
+    // Compress the pending block and write the end marker
+    void finish() {
+        if (finished_) return;
+        if (big_pending_) drain_big();
+        flush_block();
+        std::byte end[4];
+        store_le<std::uint32_t>(end, 0);
+        emit(end, sizeof(end));
+        finished_ = true;
+    }
+
+private:
+    void append(const std::byte* p, std::size_t n) {
+        while (n) {
+            if (fill_ == block_size_) flush_block();
+            const std::size_t k = std::min(n, block_size_ - fill_);
+            std::memcpy(block_.data() + fill_, p, k);
+            fill_ += k;
+            p += k;
+            n -= k;
+        }
+    }
+
+    // out_ (and the header arrays) are reused or on the stack: the sink must copy now
+    void emit(const std::byte* p, std::size_t n) {
+        if constexpr (detail::has_claim<Sink>::value) {
+            if (std::byte* dst = sink_.claim(n)) std::memcpy(dst, p, n);
+        } else {
+            sink_.write_bytes(p, n);
+        }
+    }
+
+    void drain_big() {
+        big_pending_ = false;
+        append(big_.data(), big_.size());
+        big_.clear();
+    }
+
+    BYTESTREAM_NOINLINE void flush_block() {
+        if (!fill_) return;
+        const std::size_t cap = out_.size() - detail::block_header_size;
+        std::byte* body = out_.data() + detail::block_header_size;
+        std::size_t stored = codec_.compress(block_.data(), fill_, body, cap);
+        std::uint32_t tag;
+        if (stored == 0 || stored >= fill_) {
+            std::memcpy(body, block_.data(), fill_);
+            stored = fill_;
+            tag    = std::uint32_t(stored) | detail::block_stored_flag;
+        } else {
+            tag = std::uint32_t(stored);
+        }
+        store_le<std::uint32_t>(out_.data(), std::uint32_t(fill_));
+        store_le<std::uint32_t>(out_.data() + 4, tag);
+        emit(out_.data(), detail::block_header_size + stored);
+        flushed_ += fill_;
+        fill_ = 0;
+        ++blocks_;
+    }
+
+    Sink&               sink_;
+    Codec               codec_;
+    std::size_t         block_size_;
+    ScratchPool::lease  block_;
+    ScratchPool::lease  out_;
+    std::vector<std::byte> big_;
+    std::size_t         fill_        = 0;
+    std::size_t         flushed_     = 0;
+    std::size_t         blocks_      = 0;
+    bool                big_pending_ = false;
+    bool                finished_    = false;
+};
+
+// ------------------------------------------------------------------
+// Reader: decompresses one block at a time from Source (anything with
+// take() that throws on errors, e.g. Reader, StreamReader,
+// MappedFile::reader(); sticky sources are rejected). Fields that
+// cross a block boundary are stitched like StreamReader; pointers from
+// take()/view_*() stay valid only until the next read.
+// ------------------------------------------------------------------
+template <typename Source, typename Codec = identity_codec>
+class CompressedReader : public detail::reader_base<CompressedReader<Source, Codec>> {
+    static_assert(!detail::sticky_errors<Source>::value,
+                  "CompressedReader: Source must throw on errors (decode a NothrowReader's bytes through a Reader)");
+public:
+    // largest block size a stream header may declare (the block is allocated up front)
+    static constexpr std::size_t default_max_block_size = std::size_t{16} << 20;
+
+    explicit CompressedReader(Source& src, Codec codec = Codec(), ScratchPool& pool = ScratchPool::shared(),
+                              std::size_t max_block_size = default_max_block_size)
+        : src_(src), codec_(std::move(codec)) {
+        this->set_budget(src.budget());
+        const std::byte* h = src_.take(detail::stream_header_size);
+        if (load_le<std::uint32_t>(h) != detail::compression_magic)
+            BYTESTREAM_THROW(FormatException("bytestream compression: bad stream header"));
+        if (std::uint8_t(h[4]) != Codec::id)
+            BYTESTREAM_THROW(FormatException("bytestream compression: codec mismatch"));
+        block_size_ = load_le<std::uint32_t>(h + 5);
+        if (block_size_ == 0 || block_size_ >= detail::block_stored_flag)
+            BYTESTREAM_THROW(FormatException("bytestream compression: bad block size"));
+        if (block_size_ > max_block_size)
+            BYTESTREAM_THROW(FormatException("bytestream compression: block size above limit"));
+        if (this->budget_) this->budget_->charge(block_size_);
+        max_stored_ = std::max(block_size_, codec_.max_compressed_size(block_size_));
+        block_ = pool.acquire(block_size_);
+    }
+
+    CompressedReader(const CompressedReader&) = delete;
+    CompressedReader& operator=(const CompressedReader&) = delete;
+
+    // uncompressed bytes consumed so far
+    std::size_t position() const noexcept { return consumed_ + std::size_t(cur_ - begin_); }
+    std::size_t block_size() const noexcept { return block_size_; }
+    std::size_t buffered() const noexcept { return std::size_t(end_ - cur_); }
+    // true once the end marker was reached; may decompress to find out
+    bool exhausted() { return cur_ == end_ && !refill(); }
+
+    span<const std::byte> peek_contiguous() const noexcept { return { cur_, buffered() }; }
+
+    const std::byte* take(std::size_t n) {
+        if (n <= buffered()) {
+            const std::byte* p = cur_;
+            cur_ += n;
+            return p;
+        }
+        return stitch(n);
+    }
+
+    void read_bytes(void* dst, std::size_t n) {
+        auto* out = static_cast<std::byte*>(dst);
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            if (k) std::memcpy(out, cur_, k);
+            cur_ += k;
+            out  += k;
+            n    -= k;
+            if (!n) return;
+            if (!refill()) BYTESTREAM_THROW(UnderflowException("bytestream::CompressedReader underflow"));
+        }
+    }
+    void read_bytes(span<std::byte> out) { read_bytes(out.data(), out.size()); }
+
+    void skip(std::size_t n) {
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            cur_ += k;
+            n    -= k;
+            if (!n) return;
+            if (!refill()) BYTESTREAM_THROW(UnderflowException("bytestream::CompressedReader underflow"));
+        }
+    }
+
+private:
+    // Decompress the next block; false at the end marker
+    BYTESTREAM_NOINLINE bool refill() {
+        consumed_ += std::size_t(end_ - begin_);
+        begin_ = cur_ = end_ = block_.data();
+        if (done_) return false;
+
+        const std::uint32_t raw = load_le<std::uint32_t>(src_.take(4));
+        if (raw == 0) {
+            done_ = true;
+            return false;
+        }
+        const std::uint32_t tag = load_le<std::uint32_t>(src_.take(4));
+        const std::size_t stored = tag & ~detail::block_stored_flag;
+        if (raw > block_size_ || stored > max_stored_)
+            BYTESTREAM_THROW(FormatException("bytestream compression: block exceeds block size"));
+
+        const std::byte* body = src_.take(stored);
+        if (tag & detail::block_stored_flag) {
+            if (stored != raw) BYTESTREAM_THROW(FormatException("bytestream compression: bad stored block"));
+            std::memcpy(block_.data(), body, raw);
+        } else {
+            codec_.decompress(body, stored, block_.data(), raw);
+        }
+        end_ = begin_ + raw;
+        return true;
+    }
+
+    // Gather n bytes spanning blocks, charged and grown like StreamReader
+    BYTESTREAM_NOINLINE const std::byte* stitch(std::size_t n) {
+        if (this->budget_ && n > stitch_.capacity()) this->budget_->charge(n - stitch_.capacity());
+        stitch_.assign(cur_, end_);
+        cur_ = end_;
+        while (stitch_.size() < n) {
+            if (!refill()) BYTESTREAM_THROW(UnderflowException("bytestream::CompressedReader underflow"));
+            const std::size_t k = std::min(n - stitch_.size(), buffered());
+            stitch_.insert(stitch_.end(), cur_, cur_ + k);
+            cur_ += k;
+        }
+        return stitch_.data();
+    }
+
+    Source&                src_;
+    Codec                  codec_;
+    std::size_t            block_size_ = 0;
+    std::size_t            max_stored_ = 0;
+    ScratchPool::lease     block_;
+    std::vector<std::byte> stitch_;
+    const std::byte*       begin_    = nullptr;
+    const std::byte*       cur_      = nullptr;
+    const std::byte*       end_      = nullptr;
+    std::size_t            consumed_ = 0;
+    bool                   done_     = false;
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_COMPRESSION_HPP
@@ -12,14 +12,121 @@
 #include <array>
 #include <limits>
 #include <cassert>
+#include <cstdlib>
+#if __has_include(<version>)
+#  include <version>
+#endif
+#if defined(__cpp_lib_byteswap) || defined(__cpp_lib_bit_cast)
+#  include <bit>
+#endif
+#if !defined(__cpp_lib_byteswap) && defined(_MSC_VER)
+#  include <stdlib.h>
+#endif
+
+// -------------------------------------------------------------
+// C++20 constexpr support: loads/stores, byteswap, varints and
+// StaticWriter are usable in constant expressions when the library
+// has std::bit_cast and std::is_constant_evaluated (C++20). At run
+// time they take the same memcpy/intrinsic paths as before.
+// -------------------------------------------------------------
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+#  define BYTESTREAM_HAS_CONSTEXPR20 1
+#  define BYTESTREAM_CONSTEXPR20 constexpr
+#else
+#  define BYTESTREAM_HAS_CONSTEXPR20 0
+#  define BYTESTREAM_CONSTEXPR20
+#endif
 
 namespace bytestream {
 
+namespace detail {
+// true while constant-evaluating (always false before C++20)
+constexpr bool is_constant_evaluated() noexcept {
+#if BYTESTREAM_HAS_CONSTEXPR20
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+} // namespace detail
+
 // -------------------------------------------------------------
 // Exceptions
 // -------------------------------------------------------------
 struct OverflowException  : std::runtime_error { using std::runtime_error::runtime_error; };
 struct UnderflowException : std::runtime_error { using std::runtime_error::runtime_error; };
+struct AlignmentException : std::runtime_error { using std::runtime_error::runtime_error; };
+struct FormatException    : std::runtime_error { using std::runtime_error::runtime_error; };
+struct LimitException     : std::runtime_error { using std::runtime_error::runtime_error; };
+
+// Every throw in the core headers goes through BYTESTREAM_THROW. Built
+// with -fno-exceptions it aborts instead (define BYTESTREAM_THROW to
+// route errors elsewhere); NothrowReader/NothrowWriter (errc below)
+// report errors without reaching it at all.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#  define BYTESTREAM_HAS_EXCEPTIONS 1
+#else
+#  define BYTESTREAM_HAS_EXCEPTIONS 0
+#endif
+
+#ifndef BYTESTREAM_THROW
+#  if BYTESTREAM_HAS_EXCEPTIONS
+#    define BYTESTREAM_THROW(e) throw e
+#  else
+#    define BYTESTREAM_THROW(e) ((void)sizeof(e), std::abort())
+#  endif
+#endif
+
+// -------------------------------------------------------------
+// Error codes: one per exception type above
+// -------------------------------------------------------------
+enum class errc : std::uint8_t {
+    ok = 0,
+    underflow,    // UnderflowException
+    overflow,     // OverflowException
+    alignment,    // AlignmentException
+    format,       // FormatException
+    limit,        // LimitException
+    out_of_range, // std::out_of_range (seek/subview)
+};
+
+inline constexpr const char* errc_message(errc e) noexcept {
+    switch (e) {
+        case errc::ok:           return "ok";
+        case errc::underflow:    return "underflow";
+        case errc::overflow:     return "overflow";
+        case errc::alignment:    return "misaligned";
+        case errc::format:       return "malformed input";
+        case errc::limit:        return "decode limit exceeded";
+        case errc::out_of_range: return "out of range";
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+[[noreturn]] inline void throw_error(errc e, const char* what) {
+    switch (e) {
+        case errc::overflow:     BYTESTREAM_THROW(OverflowException(what));
+        case errc::alignment:    BYTESTREAM_THROW(AlignmentException(what));
+        case errc::format:       BYTESTREAM_THROW(FormatException(what));
+        case errc::limit:        BYTESTREAM_THROW(LimitException(what));
+        case errc::out_of_range: BYTESTREAM_THROW(std::out_of_range(what));
+        default:                 BYTESTREAM_THROW(UnderflowException(what));
+    }
+}
+
+// Sources/sinks that record errors instead of throwing (sticky_errors = true)
+template <typename T, typename = void>
+struct sticky_errors : std::false_type {};
+template <typename T>
+struct sticky_errors<T, std::enable_if_t<T::sticky_errors>> : std::true_type {};
+
+// Stand-in bytes for fixed-size loads after a sticky error
+template <std::size_t N>
+inline constexpr std::byte zero_bytes[N] = {};
+
+} // namespace detail
 
 // -------------------------------------------------------------
 // Debug-only assertion (no-ops in release unless you override)
@@ -32,6 +139,17 @@ struct UnderflowException : std::runtime_error { using std::runtime_error::runti
 #  endif
 #endif
 
+// -------------------------------------------------------------
+// Keeps cold paths (refills, growth) out of inlined fast paths
+// -------------------------------------------------------------
+#if defined(_MSC_VER)
+#  define BYTESTREAM_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define BYTESTREAM_NOINLINE __attribute__((noinline))
+#else
+#  define BYTESTREAM_NOINLINE
+#endif
+
 // -------------------------------------------------------------
 // span (C++17-friendly)
 // -------------------------------------------------------------
@@ -41,10 +159,10 @@ class span {
     std::size_t n_   = 0;
 public:
     using element_type = T;
-    span() = default;
-    span(T* p, std::size_t n) : ptr_(p), n_(n) {}
-    T* data() const noexcept { return ptr_; }
-    std::size_t size() const noexcept { return n_; }
+    constexpr span() = default;
+    constexpr span(T* p, std::size_t n) : ptr_(p), n_(n) {}
+    constexpr T* data() const noexcept { return ptr_; }
+    constexpr std::size_t size() const noexcept { return n_; }
 };
 
 // -------------------------------------------------------------
@@ -63,16 +181,18 @@ enum class endian { little, big
 inline constexpr bool is_little_endian() noexcept { return endian::native == endian::little; }
 inline constexpr bool is_big_endian()    noexcept { return endian::native == endian::big; }
 
-inline std::uint16_t bswap16(std::uint16_t v) noexcept {
+// Shift-and-mask swaps; what the intrinsics below fall back to
+namespace detail {
+inline constexpr std::uint16_t portable_bswap16(std::uint16_t v) noexcept {
     return static_cast<std::uint16_t>((v >> 8) | (v << 8));
 }
-inline std::uint32_t bswap32(std::uint32_t v) noexcept {
+inline constexpr std::uint32_t portable_bswap32(std::uint32_t v) noexcept {
     return  (v >> 24) |
            ((v & 0x00FF0000u) >> 8) |
            ((v & 0x0000FF00u) << 8) |
             (v << 24);
 }
-inline std::uint64_t bswap64(std::uint64_t v) noexcept {
+inline constexpr std::uint64_t portable_bswap64(std::uint64_t v) noexcept {
     return  (v >> 56) |
            ((v & 0x00FF000000000000ull) >> 40) |
            ((v & 0x0000FF0000000000ull) >> 24) |
@@ -82,24 +202,58 @@ inline std::uint64_t bswap64(std::uint64_t v) noexcept {
            ((v & 0x000000000000FF00ull) << 40) |
             (v << 56);
 }
+} // namespace detail
 
+// Intrinsic-backed swaps: std::byteswap when the library has it,
+// compiler builtins otherwise (all fold to bswap/movbe/rev). MSVC's
+// _byteswap_* are not constexpr, so on MSVC without std::byteswap the
+// swaps are constexpr only from C++20 (shifts while constant-evaluating).
+#if defined(__cpp_lib_byteswap)
+#  define BYTESTREAM_BSWAP_CONSTEXPR constexpr
+inline constexpr std::uint16_t bswap16(std::uint16_t v) noexcept { return std::byteswap(v); }
+inline constexpr std::uint32_t bswap32(std::uint32_t v) noexcept { return std::byteswap(v); }
+inline constexpr std::uint64_t bswap64(std::uint64_t v) noexcept { return std::byteswap(v); }
+#elif defined(__GNUC__) || defined(__clang__)
+#  define BYTESTREAM_BSWAP_CONSTEXPR constexpr
+inline constexpr std::uint16_t bswap16(std::uint16_t v) noexcept { return __builtin_bswap16(v); }
+inline constexpr std::uint32_t bswap32(std::uint32_t v) noexcept { return __builtin_bswap32(v); }
+inline constexpr std::uint64_t bswap64(std::uint64_t v) noexcept { return __builtin_bswap64(v); }
+#elif defined(_MSC_VER)
+#  define BYTESTREAM_BSWAP_CONSTEXPR BYTESTREAM_CONSTEXPR20
+inline BYTESTREAM_CONSTEXPR20 std::uint16_t bswap16(std::uint16_t v) noexcept {
+    return detail::is_constant_evaluated() ? detail::portable_bswap16(v) : _byteswap_ushort(v);
+}
+inline BYTESTREAM_CONSTEXPR20 std::uint32_t bswap32(std::uint32_t v) noexcept {
+    return detail::is_constant_evaluated() ? detail::portable_bswap32(v) : _byteswap_ulong(v);
+}
+inline BYTESTREAM_CONSTEXPR20 std::uint64_t bswap64(std::uint64_t v) noexcept {
+    return detail::is_constant_evaluated() ? detail::portable_bswap64(v) : _byteswap_uint64(v);
+}
+#else
+#  define BYTESTREAM_BSWAP_CONSTEXPR constexpr
+inline constexpr std::uint16_t bswap16(std::uint16_t v) noexcept { return detail::portable_bswap16(v); }
+inline constexpr std::uint32_t bswap32(std::uint32_t v) noexcept { return detail::portable_bswap32(v); }
+inline constexpr std::uint64_t bswap64(std::uint64_t v) noexcept { return detail::portable_bswap64(v); }
+#endif
+
+// Integers and enums swap by size (so long/long long/char16_t are all
+// covered); floating point goes through its bit pattern
 template <typename T>
-inline T byteswap(T v) noexcept {
+inline BYTESTREAM_BSWAP_CONSTEXPR T byteswap(T v) noexcept {
     static_assert(std::is_trivially_copyable<T>::value, "byteswap requires trivially copyable type");
-    if constexpr (std::is_same<T, std::uint16_t>::value || std::is_same<T, std::int16_t>::value) {
-        auto u = static_cast<std::uint16_t>(v);
-        u = bswap16(u);
-        return static_cast<T>(u);
-    } else if constexpr (std::is_same<T, std::uint32_t>::value || std::is_same<T, std::int32_t>::value) {
-        auto u = static_cast<std::uint32_t>(v);
-        u = bswap32(u);
-        return static_cast<T>(u);
-    } else if constexpr (std::is_same<T, std::uint64_t>::value || std::is_same<T, std::int64_t>::value) {
-        auto u = static_cast<std::uint64_t>(v);
-        u = bswap64(u);
-        return static_cast<T>(u);
-    } else if constexpr (std::is_floating_point<T>::value) {
+    if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+        if constexpr (sizeof(T) == 2)      return static_cast<T>(bswap16(static_cast<std::uint16_t>(v)));
+        else if constexpr (sizeof(T) == 4) return static_cast<T>(bswap32(static_cast<std::uint32_t>(v)));
+        else if constexpr (sizeof(T) == 8) return static_cast<T>(bswap64(static_cast<std::uint64_t>(v)));
+        else return v;
+    } else if constexpr (std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)) {
         using U = typename std::conditional<sizeof(T)==4, std::uint32_t, std::uint64_t>::type;
+#if BYTESTREAM_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            const U u = std::bit_cast<U>(v);
+            return std::bit_cast<T>(sizeof(T) == 4 ? U(bswap32(std::uint32_t(u))) : U(bswap64(u)));
+        }
+#endif
         U u{};
         std::memcpy(&u, &v, sizeof(T));
         if constexpr (sizeof(T) == 4) u = bswap32(u); else u = bswap64(u);
@@ -110,12 +264,82 @@ inline T byteswap(T v) noexcept {
     }
 }
 
+// -------------------------------------------------------------
+// Fixed-size loads/stores at unaligned addresses. One memcpy of
+// sizeof(T) plus an optional swap: compilers emit a single mov
+// (movbe / ldr+rev for the swapped order). The std::byte overloads
+// are also constexpr on C++20 (std::bit_cast while constant-evaluating).
+// -------------------------------------------------------------
+template <typename T>
+inline T load_native(const void* p) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "load requires trivially copyable type");
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+template <typename T>
+inline void store_native(void* p, const T& v) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "store requires trivially copyable type");
+    std::memcpy(p, &v, sizeof(T));
+}
+
+template <typename T>
+inline BYTESTREAM_CONSTEXPR20 T load_native(const std::byte* p) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "load requires trivially copyable type");
+#if BYTESTREAM_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated()) {
+        std::array<std::byte, sizeof(T)> b{};
+        for (std::size_t i = 0; i < sizeof(T); ++i) b[i] = p[i];
+        return std::bit_cast<T>(b);
+    }
+#endif
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+template <typename T>
+inline BYTESTREAM_CONSTEXPR20 void store_native(std::byte* p, const T& v) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "store requires trivially copyable type");
+#if BYTESTREAM_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated()) {
+        const auto b = std::bit_cast<std::array<std::byte, sizeof(T)>>(v);
+        for (std::size_t i = 0; i < sizeof(T); ++i) p[i] = b[i];
+        return;
+    }
+#endif
+    std::memcpy(p, &v, sizeof(T));
+}
+
+// P is const void* or const std::byte* (constexpr on C++20)
+template <typename T, typename P>
+inline BYTESTREAM_CONSTEXPR20 T load_le(const P* p) noexcept {
+    T v = load_native<T>(p);
+    if constexpr (is_big_endian()) v = byteswap(v);
+    return v;
+}
+template <typename T, typename P>
+inline BYTESTREAM_CONSTEXPR20 T load_be(const P* p) noexcept {
+    T v = load_native<T>(p);
+    if constexpr (is_little_endian()) v = byteswap(v);
+    return v;
+}
+template <typename T, typename P>
+inline BYTESTREAM_CONSTEXPR20 void store_le(P* p, T v) noexcept {
+    if constexpr (is_big_endian()) v = byteswap(v);
+    store_native(p, v);
+}
+template <typename T, typename P>
+inline BYTESTREAM_CONSTEXPR20 void store_be(P* p, T v) noexcept {
+    if constexpr (is_little_endian()) v = byteswap(v);
+    store_native(p, v);
+}
+
 // -------------------------------------------------------------
 template <typename T>
 struct is_arithmetic : std::integral_constant<bool,
     std::is_integral<T>::value || std::is_floating_point<T>::value> {};
 
-inline std::size_t align_up(std::size_t p, std::size_t a) noexcept {
+inline constexpr std::size_t align_up(std::size_t p, std::size_t a) noexcept {
     if (a==0) return p;
     std::size_t r = p % a;
     return r ? (p + (a - r)) : p;
@@ -0,0 +1,213 @@
+#ifndef BYTESTREAM_CONTAINER_HPP
+#define BYTESTREAM_CONTAINER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <bytestream/mapped_file.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------------
+// Random-access record container.
+//
+//   bytestream::ContainerWriter<bytestream::MappedFileWriter> cw(out);
+//   for (auto& t : trades) {
+//       write_field(cw.begin_record(), t);
+//       cw.end_record();
+//   }
+//   cw.finish();
+//
+//   bytestream::MappedContainer snap("trades.bin");   // maps, reads the footer only
+//   auto t = read_field<Trade>(snap.record(123456789)); // Reader::subview, O(1)
+//
+// Layout (little-endian):
+//   record bytes, back to back
+//   offset table: count + 1 record boundaries relative to the container
+//                 start, either
+//                   plain: u64 each (looked up in place, nothing decoded), or
+//                   delta: varint gaps between boundaries (decoded on open)
+//   trailer: u64 table offset, u64 record count, u32 encoding, u32 magic "BSIX"
+// ------------------------------------------------------------------
+namespace bytestream {
+
+enum class offset_encoding : std::uint32_t { plain = 0, delta_varint = 1 };
+
+namespace detail {
+
+inline constexpr std::uint32_t container_magic        = 0x58495342u; // "BSIX"
+inline constexpr std::size_t   container_trailer_size = 24;
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Writer: records go straight to Sink (any writer), boundaries are
+// kept in memory until finish() appends the table and trailer
+// ------------------------------------------------------------------
+template <typename Sink>
+class ContainerWriter {
+    Sink&                      sink_;
+    offset_encoding            encoding_;
+    std::size_t                base_;
+    std::vector<std::uint64_t> bounds_;
+    bool                       open_     = false;
+    bool                       finished_ = false;
+public:
+    explicit ContainerWriter(Sink& sink, offset_encoding encoding = offset_encoding::plain)
+        : sink_(sink), encoding_(encoding), base_(sink.position()) {
+        bounds_.push_back(0);
+    }
+
+    std::size_t record_count() const noexcept { return bounds_.size() - 1; }
+
+    // Start a record; encode it into the returned sink, then end_record()
+    Sink& begin_record() {
+        BYTESTREAM_ASSERT(!open_ && !finished_);
+        if (sink_.position() - base_ != bounds_.back())
+            BYTESTREAM_THROW(FormatException("bytestream container: bytes written outside a record"));
+        open_ = true;
+        return sink_;
+    }
+    void end_record() {
+        BYTESTREAM_ASSERT(open_);
+        open_ = false;
+        bounds_.push_back(sink_.position() - base_);
+    }
+
+    void add_record(const void* data, std::size_t n) {
+        begin_record().write_bytes(data, n);
+        end_record();
+    }
+
+    // Append the offset table and trailer
+    void finish() {
+        if (finished_) return;
+        BYTESTREAM_ASSERT(!open_);
+        const std::uint64_t table = bounds_.back();
+        if (encoding_ == offset_encoding::plain) {
+            sink_.template write_array_le<std::uint64_t>(span<const std::uint64_t>(bounds_.data(), bounds_.size()));
+        } else {
+            std::uint64_t prev = 0;
+            for (std::uint64_t b : bounds_) {
+                sink_.template write_varint<std::uint64_t>(b - prev);
+                prev = b;
+            }
+        }
+        sink_.template write_le<std::uint64_t>(table);
+        sink_.template write_le<std::uint64_t>(record_count());
+        sink_.template write_le<std::uint32_t>(static_cast<std::uint32_t>(encoding_));
+        sink_.template write_le<std::uint32_t>(detail::container_magic);
+        finished_ = true;
+    }
+};
+
+// ------------------------------------------------------------------
+// Reader over a complete container in memory (or a mapping). Only the
+// trailer and the offset table are touched on construction.
+// ------------------------------------------------------------------
+class ContainerReader {
+    const std::byte*           data_  = nullptr;
+    std::uint64_t              table_ = 0;     // = end of the record area
+    std::size_t                count_ = 0;
+    const std::byte*           plain_ = nullptr; // plain table, read in place
+    std::vector<std::uint64_t> bounds_;          // decoded delta table
+public:
+    ContainerReader() noexcept = default;
+
+    ContainerReader(const void* data, std::size_t size) : data_(static_cast<const std::byte*>(data)) {
+        if (size < detail::container_trailer_size)
+            BYTESTREAM_THROW(FormatException("bytestream container: too small"));
+        Reader trailer(data_ + size - detail::container_trailer_size, detail::container_trailer_size);
+        table_ = trailer.read_le<std::uint64_t>();
+        const std::uint64_t count = trailer.read_le<std::uint64_t>();
+        const auto encoding = static_cast<offset_encoding>(trailer.read_le<std::uint32_t>());
+        if (trailer.read_le<std::uint32_t>() != detail::container_magic)
+            BYTESTREAM_THROW(FormatException("bytestream container: bad magic"));
+
+        const std::size_t footer_end = size - detail::container_trailer_size;
+        if (table_ > footer_end) BYTESTREAM_THROW(FormatException("bytestream container: bad table offset"));
+        const std::size_t table_len = footer_end - std::size_t(table_);
+        const std::byte* table = data_ + table_;
+
+        if (encoding == offset_encoding::plain) {
+            if (count >= table_len / 8 || (count + 1) * 8 != table_len)
+                BYTESTREAM_THROW(FormatException("bytestream container: bad offset table size"));
+            plain_ = table;
+        } else if (encoding == offset_encoding::delta_varint) {
+            // each boundary takes at least one byte: bounds the allocation
+            if (count >= table_len) BYTESTREAM_THROW(FormatException("bytestream container: bad offset table size"));
+            Reader r(table, table_len);
+            bounds_.reserve(std::size_t(count) + 1);
+            std::uint64_t b = 0;
+            for (std::uint64_t i = 0; i <= count; ++i) {
+                const std::uint64_t d = r.read_varint<std::uint64_t>();
+                if (d > table_ - b) BYTESTREAM_THROW(FormatException("bytestream container: offset out of range"));
+                b += d;
+                bounds_.push_back(b);
+            }
+            if (r.remaining()) BYTESTREAM_THROW(FormatException("bytestream container: trailing table bytes"));
+        } else {
+            BYTESTREAM_THROW(FormatException("bytestream container: unknown offset encoding"));
+        }
+        count_ = std::size_t(count);
+    }
+
+    explicit ContainerReader(const Reader& r) : ContainerReader(r.data(), r.size()) {}
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    // bytes of record payload (the table starts here)
+    std::size_t records_bytes() const noexcept { return std::size_t(table_); }
+
+    std::size_t record_offset(std::size_t i) const { return std::size_t(bounds(i).first); }
+    std::size_t record_size(std::size_t i) const {
+        const auto b = bounds(i);
+        return std::size_t(b.second - b.first);
+    }
+
+    // Reader over record i
+    Reader record(std::size_t i) const {
+        const auto b = bounds(i);
+        return Reader(data_ + b.first, std::size_t(b.second - b.first));
+    }
+    Reader operator[](std::size_t i) const { return record(i); }
+
+private:
+    std::pair<std::uint64_t, std::uint64_t> bounds(std::size_t i) const {
+        if (i >= count_) BYTESTREAM_THROW(std::out_of_range("bytestream container: record index out of range"));
+        if (!plain_) return { bounds_[i], bounds_[i + 1] };
+        const std::uint64_t begin = load_le<std::uint64_t>(plain_ + 8 * i);
+        const std::uint64_t end   = load_le<std::uint64_t>(plain_ + 8 * (i + 1));
+        if (begin > end || end > table_) BYTESTREAM_THROW(FormatException("bytestream container: offset out of range"));
+        return { begin, end };
+    }
+};
+
+// ------------------------------------------------------------------
+// ContainerReader over a memory-mapped file (random access hint)
+// ------------------------------------------------------------------
+class MappedContainer {
+    MappedFile      file_;
+    ContainerReader reader_;
+public:
+    explicit MappedContainer(const std::string& path, map_options opts = random_access_options())
+        : file_(path, opts), reader_(file_.data(), file_.size()) {}
+
+    std::size_t size() const noexcept { return reader_.size(); }
+    Reader record(std::size_t i) const { return reader_.record(i); }
+    Reader operator[](std::size_t i) const { return reader_.record(i); }
+    const ContainerReader& index() const noexcept { return reader_; }
+    const MappedFile& file() const noexcept { return file_; }
+
+private:
+    static map_options random_access_options() noexcept {
+        map_options o;
+        o.hint = access_hint::random;
+        return o;
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_CONTAINER_HPP
@@ -4,7 +4,18 @@
 #include <bytestream/config.hpp>
 #include <bytestream/reader.hpp>
 #include <bytestream/writer.hpp>
+#include <bytestream/dynamic_writer.hpp>
+#include <bytestream/counting_writer.hpp>
+#include <bytestream/gather_writer.hpp>
+#include <bytestream/buffer_chain.hpp>
+#include <bytestream/stream_reader.hpp>
+#include <bytestream/checksum.hpp>
+#include <bytestream/bit_stream.hpp>
 #include <bytestream/stream.hpp>
-#include <bytestream/serialization.hpp> 
+#include <bytestream/serialization.hpp>
+#include <bytestream/object_pool.hpp>
+#include <bytestream/columns.hpp>
+#include <bytestream/record_view.hpp>
+#include <bytestream/result.hpp>
 
 #endif // BYTESTREAM_CORE_HPP
@@ -0,0 +1,68 @@
+#ifndef BYTESTREAM_COUNTING_WRITER_HPP
+#define BYTESTREAM_COUNTING_WRITER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/writer.hpp>
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Sizing sink: accepts the full Writer API but only counts bytes.
+// Run an encoder against it to learn the exact output size up front.
+// ------------------------------------------------------------------
+class CountingWriter : public detail::writer_base<CountingWriter> {
+    std::size_t size_ = 0; // high-water mark
+    std::size_t pos_  = 0;
+public:
+    CountingWriter() noexcept = default;
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return pos_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return pos_; }
+
+    void seek(std::size_t p) {
+        if (p > size_) BYTESTREAM_THROW(std::out_of_range("bytestream::CountingWriter seek past end"));
+        pos_ = p;
+    }
+    void ensure(std::size_t) const noexcept {}
+    void clear() noexcept { size_ = pos_ = 0; }
+
+    // ---- counting overrides of the byte-moving primitives
+    void write_bytes(const void*, std::size_t n) { advance(n); }
+    void fill_bytes(std::byte, std::size_t count) { advance(count); }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), void>
+    write_varint(T v) { advance(detail::varint_size(detail::varint_bits(v))); }
+
+    template <typename T>
+    std::enable_if_t<is_arithmetic<T>::value, void>
+    write_array_be(span<const T> arr) { advance(array_bytes<T>(arr.size())); }
+    template <typename T>
+    std::enable_if_t<is_arithmetic<T>::value, void>
+    write_array_le(span<const T> arr) { advance(array_bytes<T>(arr.size())); }
+
+    void write_packed_u32_array(span<const std::uint32_t> arr, packed_coding coding = packed_coding::plain) {
+        advance(detail::svb_encoded_size(arr.data(), arr.size(), coding));
+    }
+
+private:
+    template <typename T>
+    static std::size_t array_bytes(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            BYTESTREAM_THROW(OverflowException("bytestream::CountingWriter overflow"));
+        return n * sizeof(T);
+    }
+
+    void advance(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() - pos_)
+            BYTESTREAM_THROW(OverflowException("bytestream::CountingWriter overflow"));
+        pos_ += n;
+        if (pos_ > size_) size_ = pos_;
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_COUNTING_WRITER_HPP
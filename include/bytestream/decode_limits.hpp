@@ -0,0 +1,80 @@
+#ifndef BYTESTREAM_DECODE_LIMITS_HPP
+#define BYTESTREAM_DECODE_LIMITS_HPP
+
+#include <bytestream/config.hpp>
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Caps for decoding untrusted input. Attach a DecodeBudget to a reader
+// (set_budget) and read_field/read_vector/read_string enforce it,
+// throwing LimitException *before* allocating. A budget tracks one
+// decode; reset() it (or use a fresh one) per message.
+// ------------------------------------------------------------------
+struct decode_limits {
+    std::size_t max_collection_length = std::numeric_limits<std::size_t>::max(); // elements
+    std::size_t max_string_length     = std::numeric_limits<std::size_t>::max(); // bytes
+    std::size_t max_total_bytes       = std::numeric_limits<std::size_t>::max(); // allocated per decode
+    std::size_t max_depth             = 64;                                      // nested containers/records
+};
+
+class DecodeBudget {
+    decode_limits limits_;
+    std::size_t   allocated_ = 0;
+    std::size_t   depth_     = 0;
+public:
+    DecodeBudget() noexcept = default;
+    explicit DecodeBudget(const decode_limits& limits) noexcept : limits_(limits) {}
+
+    const decode_limits& limits() const noexcept { return limits_; }
+    std::size_t allocated() const noexcept { return allocated_; }
+    std::size_t depth() const noexcept { return depth_; }
+    void reset() noexcept { allocated_ = 0; depth_ = 0; }
+
+    bool allows_collection(std::size_t n) const noexcept { return n <= limits_.max_collection_length; }
+    bool allows_string(std::size_t n) const noexcept { return n <= limits_.max_string_length; }
+    // Account for an allocation of n elements of `size` bytes; false (and
+    // nothing charged) when it would exceed the budget
+    bool try_charge(std::size_t n, std::size_t size = 1) noexcept {
+        if (size && n > (limits_.max_total_bytes - allocated_) / size) return false;
+        allocated_ += n * size;
+        return true;
+    }
+    bool try_enter() noexcept {
+        if (depth_ >= limits_.max_depth) return false;
+        ++depth_;
+        return true;
+    }
+
+    // Throwing forms of the above (LimitException)
+    void check_collection(std::size_t n) const {
+        if (!allows_collection(n)) BYTESTREAM_THROW(LimitException("bytestream decode: collection too long"));
+    }
+    void check_string(std::size_t n) const {
+        if (!allows_string(n)) BYTESTREAM_THROW(LimitException("bytestream decode: string too long"));
+    }
+    void charge(std::size_t n, std::size_t size = 1) {
+        if (!try_charge(n, size)) BYTESTREAM_THROW(LimitException("bytestream decode: allocation budget exceeded"));
+    }
+    void enter() {
+        if (!try_enter()) BYTESTREAM_THROW(LimitException("bytestream decode: nesting too deep"));
+    }
+    void leave() noexcept { if (depth_) --depth_; }
+};
+
+namespace detail {
+
+// One nesting level for the lifetime of the scope (no-op without a budget)
+class depth_scope {
+    DecodeBudget* b_;
+public:
+    explicit depth_scope(DecodeBudget* b) : b_(b) { if (b_) b_->enter(); }
+    ~depth_scope() { if (b_) b_->leave(); }
+    depth_scope(const depth_scope&) = delete;
+    depth_scope& operator=(const depth_scope&) = delete;
+};
+
+} // namespace detail
+} // namespace bytestream
+
+#endif // BYTESTREAM_DECODE_LIMITS_HPP
@@ -0,0 +1,203 @@
+#ifndef BYTESTREAM_DETAIL_BYTESWAP_ARRAY_HPP
+#define BYTESTREAM_DETAIL_BYTESWAP_ARRAY_HPP
+
+#include <bytestream/config.hpp>
+#include <cstring>
+
+// -------------------------------------------------------------
+// Bulk byte-reversal kernels used by read_array_* / write_array_*.
+//
+// Selection (best first):
+//   - AVX2 / SSSE3 pshufb when enabled at compile time
+//   - AVX2 / SSSE3 picked at runtime on GCC/Clang x86 builds that
+//     were not compiled for them (target attributes + cpuid)
+//   - NEON vrev on AArch64 / ARMv7 with NEON
+//   - scalar bswap loop
+// Define BYTESTREAM_NO_SIMD to force the scalar path.
+// -------------------------------------------------------------
+#if !defined(BYTESTREAM_NO_SIMD)
+#  if defined(__AVX2__) || defined(__SSSE3__)
+#    include <immintrin.h>
+#    define BYTESTREAM_BSWAP_X86 1
+#  elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <immintrin.h>
+#    define BYTESTREAM_BSWAP_X86 1
+#    define BYTESTREAM_BSWAP_RUNTIME_DISPATCH 1
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define BYTESTREAM_BSWAP_NEON 1
+#  endif
+#endif
+
+namespace bytestream {
+namespace detail {
+
+// Scalar kernel: works from unaligned bytes, one element at a time
+template <std::size_t S>
+inline void byteswap_copy_scalar(std::byte* dst, const std::byte* src, std::size_t count) noexcept {
+    using U = std::conditional_t<S == 2, std::uint16_t,
+              std::conditional_t<S == 4, std::uint32_t, std::uint64_t>>;
+    for (std::size_t i = 0; i < count; ++i) {
+        U u;
+        std::memcpy(&u, src + i * S, S);
+        u = byteswap(u);
+        std::memcpy(dst + i * S, &u, S);
+    }
+}
+
+#if defined(BYTESTREAM_BSWAP_X86)
+
+#  if defined(BYTESTREAM_BSWAP_RUNTIME_DISPATCH)
+#    define BYTESTREAM_TARGET_SSSE3 __attribute__((target("ssse3")))
+#    define BYTESTREAM_TARGET_AVX2  __attribute__((target("avx2")))
+#  else
+#    define BYTESTREAM_TARGET_SSSE3
+#    define BYTESTREAM_TARGET_AVX2
+#  endif
+
+// pshufb controls that reverse every S-byte group of a 16-byte lane
+alignas(16) inline constexpr std::uint8_t bswap_control2[16] = {1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14};
+alignas(16) inline constexpr std::uint8_t bswap_control4[16] = {3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12};
+alignas(16) inline constexpr std::uint8_t bswap_control8[16] = {7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8};
+
+template <std::size_t S>
+inline const std::uint8_t* bswap_control() noexcept {
+    if constexpr (S == 2) return bswap_control2;
+    else if constexpr (S == 4) return bswap_control4;
+    else return bswap_control8;
+}
+
+template <std::size_t S>
+BYTESTREAM_TARGET_SSSE3 inline void byteswap_copy_ssse3(std::byte* dst, const std::byte* src, std::size_t count) noexcept {
+    const __m128i mask  = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_control<S>()));
+    const std::size_t n = count * S;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    byteswap_copy_scalar<S>(dst + i, src + i, (n - i) / S);
+}
+
+#  if defined(__AVX2__) || defined(BYTESTREAM_BSWAP_RUNTIME_DISPATCH)
+template <std::size_t S>
+BYTESTREAM_TARGET_AVX2 inline void byteswap_copy_avx2(std::byte* dst, const std::byte* src, std::size_t count) noexcept {
+    // pshufb works per 128-bit lane, so the same control goes in both halves
+    const __m128i half = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_control<S>()));
+    const __m256i mask = _mm256_broadcastsi128_si256(half);
+    const std::size_t n = count * S;
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),      _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), _mm256_shuffle_epi8(b, mask));
+    }
+    for (; i + 32 <= n; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(a, mask));
+    }
+    byteswap_copy_scalar<S>(dst + i, src + i, (n - i) / S);
+}
+#  endif
+
+#  if defined(BYTESTREAM_BSWAP_RUNTIME_DISPATCH)
+enum class simd_level { scalar, ssse3, avx2 };
+
+inline simd_level detect_simd_level() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))  return simd_level::avx2;
+    if (__builtin_cpu_supports("ssse3")) return simd_level::ssse3;
+    return simd_level::scalar;
+}
+
+inline simd_level cached_simd_level() noexcept {
+    static const simd_level level = detect_simd_level();
+    return level;
+}
+#  endif
+
+#elif defined(BYTESTREAM_BSWAP_NEON)
+
+template <std::size_t S>
+inline uint8x16_t bswap_neon(uint8x16_t v) noexcept {
+    if constexpr (S == 2) return vrev16q_u8(v);
+    else if constexpr (S == 4) return vrev32q_u8(v);
+    else return vrev64q_u8(v);
+}
+
+template <std::size_t S>
+inline void byteswap_copy_neon(std::byte* dst, const std::byte* src, std::size_t count) noexcept {
+    const std::size_t n = count * S;
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint8x16_t a = vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i));
+        uint8x16_t b = vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i + 16));
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(dst + i),      bswap_neon<S>(a));
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(dst + i + 16), bswap_neon<S>(b));
+    }
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t a = vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i));
+        vst1q_u8(reinterpret_cast<std::uint8_t*>(dst + i), bswap_neon<S>(a));
+    }
+    byteswap_copy_scalar<S>(dst + i, src + i, (n - i) / S);
+}
+
+#endif
+
+// Copies `count` elements of size S from src to dst, reversing the bytes
+// of each element. dst and src may be unaligned but must not overlap.
+template <std::size_t S>
+inline void byteswap_copy(void* dst_, const void* src_, std::size_t count) noexcept {
+    auto*       dst = static_cast<std::byte*>(dst_);
+    const auto* src = static_cast<const std::byte*>(src_);
+    if constexpr (S == 1) {
+        if (count) std::memcpy(dst, src, count);
+    } else {
+        static_assert(S == 2 || S == 4 || S == 8, "byteswap_copy: unsupported element size");
+#if defined(BYTESTREAM_BSWAP_X86) || defined(BYTESTREAM_BSWAP_NEON)
+        // below one vector the scalar loop wins
+        if (count * S < 16) { byteswap_copy_scalar<S>(dst, src, count); return; }
+#endif
+#if defined(BYTESTREAM_BSWAP_RUNTIME_DISPATCH)
+        switch (cached_simd_level()) {
+            case simd_level::avx2:  byteswap_copy_avx2<S>(dst, src, count);  return;
+            case simd_level::ssse3: byteswap_copy_ssse3<S>(dst, src, count); return;
+            default:                byteswap_copy_scalar<S>(dst, src, count); return;
+        }
+#elif defined(BYTESTREAM_BSWAP_X86) && defined(__AVX2__)
+        byteswap_copy_avx2<S>(dst, src, count);
+#elif defined(BYTESTREAM_BSWAP_X86)
+        byteswap_copy_ssse3<S>(dst, src, count);
+#elif defined(BYTESTREAM_BSWAP_NEON)
+        byteswap_copy_neon<S>(dst, src, count);
+#else
+        byteswap_copy_scalar<S>(dst, src, count);
+#endif
+    }
+}
+
+// Element-typed front end used by the array readers/writers. Sizes
+// without a kernel (long double, 128-bit integers) go element by element
+// through byteswap<T>, so arrays match write_be/read_be of one value.
+template <typename T>
+inline void byteswap_copy_of(void* dst_, const void* src_, std::size_t count) noexcept {
+    constexpr std::size_t S = sizeof(T);
+    if constexpr (S == 1 || S == 2 || S == 4 || S == 8) {
+        byteswap_copy<S>(dst_, src_, count);
+    } else {
+        auto*       dst = static_cast<std::byte*>(dst_);
+        const auto* src = static_cast<const std::byte*>(src_);
+        for (std::size_t i = 0; i < count; ++i) {
+            T v;
+            std::memcpy(&v, src + i * S, S);
+            v = byteswap(v);
+            std::memcpy(dst + i * S, &v, S);
+        }
+    }
+}
+
+} // namespace detail
+} // namespace bytestream
+
+#endif // BYTESTREAM_DETAIL_BYTESWAP_ARRAY_HPP
@@ -0,0 +1,51 @@
+#ifndef BYTESTREAM_DETAIL_INSTRUMENT_HOOKS_HPP
+#define BYTESTREAM_DETAIL_INSTRUMENT_HOOKS_HPP
+
+#include <bytestream/config.hpp>
+
+// -------------------------------------------------------------
+// Counting hooks placed on the reader/writer hot paths. With
+// BYTESTREAM_INSTRUMENT unset (the default) BYTESTREAM_COUNT expands
+// to nothing; with BYTESTREAM_INSTRUMENT=1 it bumps this thread's
+// counters (instrument.hpp). Pick one setting for the whole program.
+// -------------------------------------------------------------
+#ifndef BYTESTREAM_INSTRUMENT
+#  define BYTESTREAM_INSTRUMENT 0
+#endif
+
+namespace bytestream {
+
+enum class op_family : unsigned {
+    read_fixed,   // read, read_le, read_be
+    read_bytes,   // read_bytes, view_bytes
+    read_array,   // read_array*, view_array, read_packed_u32_array
+    read_varint,
+    read_string,  // read_string*, read_sized_string_*, view_*string*, read_cstring
+    read_vector,  // read_vector / read_vector_into (elements count on their own)
+    write_fixed,
+    write_bytes,
+    write_array,
+    write_varint,
+    write_string,
+    write_vector,
+    underflow,    // UnderflowException thrown by a source
+    overflow,     // OverflowException thrown by a sink
+    grow,         // DynamicWriter reallocation (bytes: new capacity)
+    count_
+};
+
+inline constexpr std::size_t op_family_count = static_cast<std::size_t>(op_family::count_);
+
+} // namespace bytestream
+
+#if BYTESTREAM_INSTRUMENT
+#  include <bytestream/instrument.hpp>
+// (not counted while constant-evaluating: StaticWriter in a constexpr)
+#  define BYTESTREAM_COUNT(family, n) \
+       (::bytestream::detail::is_constant_evaluated() ? (void)0 : \
+        ::bytestream::detail::count_op(::bytestream::op_family::family, static_cast<std::size_t>(n)))
+#else
+#  define BYTESTREAM_COUNT(family, n) ((void)0)
+#endif
+
+#endif // BYTESTREAM_DETAIL_INSTRUMENT_HOOKS_HPP
@@ -0,0 +1,192 @@
+#ifndef BYTESTREAM_DETAIL_STREAM_VBYTE_HPP
+#define BYTESTREAM_DETAIL_STREAM_VBYTE_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/detail/byteswap_array.hpp>
+#include <cstring>
+
+// -------------------------------------------------------------
+// Stream VByte codec for u32 arrays (write/read_packed_u32_array).
+//
+// Layout for n values:
+//   ceil(n / 4) control bytes, 2 bits per value (length - 1, first
+//   value in the low bits; unused codes of the last byte are 0),
+//   then the values' 1-4 low bytes, little-endian, back to back.
+//
+// With packed_coding::delta each value is stored as the (wrapping)
+// difference to its predecessor, starting from 0.
+//
+// Decoding shuffles one control byte's worth (4 values) at a time:
+// SSSE3 pshufb (runtime-picked like the byteswap kernels) or NEON
+// tbl on AArch64, with a scalar loop for the tail.
+// -------------------------------------------------------------
+#if defined(BYTESTREAM_BSWAP_NEON) && defined(__aarch64__)
+#  define BYTESTREAM_SVB_NEON 1
+#endif
+
+namespace bytestream {
+
+enum class packed_coding { plain, delta };
+
+namespace detail {
+
+struct svb_tables {
+    std::uint8_t length[256];              // data bytes of a full control byte
+    alignas(16) std::uint8_t shuffle[256][16]; // data bytes -> 4 x u32 lanes (0xFF zeroes)
+};
+
+constexpr svb_tables make_svb_tables() noexcept {
+    svb_tables t{};
+    for (unsigned c = 0; c < 256; ++c) {
+        unsigned src = 0;
+        for (unsigned j = 0; j < 4; ++j) {
+            const unsigned len = ((c >> (2 * j)) & 3u) + 1;
+            for (unsigned b = 0; b < 4; ++b)
+                t.shuffle[c][4 * j + b] = b < len ? static_cast<std::uint8_t>(src + b) : 0xFF;
+            src += len;
+        }
+        t.length[c] = static_cast<std::uint8_t>(src);
+    }
+    return t;
+}
+
+inline constexpr svb_tables svb_table = make_svb_tables();
+
+constexpr std::size_t svb_control_bytes(std::size_t n) noexcept { return n / 4 + (n % 4 != 0); }
+
+constexpr unsigned svb_code(std::uint32_t v) noexcept {
+    return unsigned(v > 0xFFu) + unsigned(v > 0xFFFFu) + unsigned(v > 0xFFFFFFu);
+}
+
+// Bytes the data section takes, from the control bytes of n values
+inline std::size_t svb_data_bytes(const std::byte* ctrl, std::size_t n) noexcept {
+    std::size_t total = 0;
+    const std::size_t full = n / 4;
+    for (std::size_t g = 0; g < full; ++g) total += svb_table.length[static_cast<std::uint8_t>(ctrl[g])];
+    for (std::size_t i = full * 4; i < n; ++i)
+        total += ((static_cast<std::uint8_t>(ctrl[full]) >> (2 * (i & 3))) & 3u) + 1;
+    return total;
+}
+
+// Total encoded size (control + data) of n values
+inline std::size_t svb_encoded_size(const std::uint32_t* in, std::size_t n, packed_coding coding) noexcept {
+    std::size_t total = svb_control_bytes(n) + n;
+    std::uint32_t prev = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t v = in[i];
+        if (coding == packed_coding::delta) { const std::uint32_t d = v - prev; prev = v; v = d; }
+        total += svb_code(v);
+    }
+    return total;
+}
+
+// Writes exactly svb_encoded_size(in, n, coding) bytes to out
+inline void svb_encode(const std::uint32_t* in, std::size_t n, packed_coding coding, std::byte* out) noexcept {
+    const std::size_t nctrl = svb_control_bytes(n);
+    std::byte* ctrl = out;
+    std::byte* data = out + nctrl;
+    if (nctrl) std::memset(ctrl, 0, nctrl);
+
+    std::uint32_t prev = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t v = in[i];
+        if (coding == packed_coding::delta) { const std::uint32_t d = v - prev; prev = v; v = d; }
+        const unsigned code = svb_code(v);
+        ctrl[i >> 2] |= std::byte(code << (2 * (i & 3)));
+        for (unsigned b = 0; b <= code; ++b) data[b] = std::byte(static_cast<std::uint8_t>(v >> (8 * b)));
+        data += code + 1;
+    }
+}
+
+// Scalar decode of values [i, n); `prev` carries the delta base
+inline void svb_decode_scalar(const std::byte* ctrl, const std::byte* data, std::size_t i, std::size_t n,
+                              packed_coding coding, std::uint32_t prev, std::uint32_t* out) noexcept {
+    for (; i < n; ++i) {
+        const unsigned len = ((static_cast<std::uint8_t>(ctrl[i >> 2]) >> (2 * (i & 3))) & 3u) + 1;
+        std::uint32_t v = 0;
+        for (unsigned b = 0; b < len; ++b) v |= std::uint32_t(static_cast<std::uint8_t>(data[b])) << (8 * b);
+        data += len;
+        if (coding == packed_coding::delta) v = prev += v;
+        out[i] = v;
+    }
+}
+
+#if defined(BYTESTREAM_BSWAP_X86)
+
+template <packed_coding Coding>
+BYTESTREAM_TARGET_SSSE3 inline void svb_decode_ssse3(const std::byte* ctrl, const std::byte* data,
+                                                     std::size_t data_len, std::size_t n,
+                                                     std::uint32_t* out) noexcept {
+    const std::byte* const end = data + data_len;
+    __m128i prev = _mm_setzero_si128();
+    std::size_t i = 0;
+    // each step reads 16 data bytes, so stop once fewer remain
+    for (; i + 4 <= n && end - data >= 16; i += 4) {
+        const auto c = static_cast<std::uint8_t>(ctrl[i >> 2]);
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(svb_table.shuffle[c]));
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+        if constexpr (Coding == packed_coding::delta) {
+            v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+            v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+            v = _mm_add_epi32(v, prev);
+            prev = _mm_shuffle_epi32(v, 0xFF);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        data += svb_table.length[c];
+    }
+    svb_decode_scalar(ctrl, data, i, n, Coding, static_cast<std::uint32_t>(_mm_cvtsi128_si32(prev)), out);
+}
+
+#elif defined(BYTESTREAM_SVB_NEON)
+
+template <packed_coding Coding>
+inline void svb_decode_neon(const std::byte* ctrl, const std::byte* data, std::size_t data_len,
+                            std::size_t n, std::uint32_t* out) noexcept {
+    const std::byte* const end = data + data_len;
+    uint32x4_t prev = vdupq_n_u32(0);
+    const uint32x4_t zero = vdupq_n_u32(0);
+    std::size_t i = 0;
+    for (; i + 4 <= n && end - data >= 16; i += 4) {
+        const auto c = static_cast<std::uint8_t>(ctrl[i >> 2]);
+        const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data));
+        uint32x4_t v = vreinterpretq_u32_u8(vqtbl1q_u8(bytes, vld1q_u8(svb_table.shuffle[c])));
+        if constexpr (Coding == packed_coding::delta) {
+            v = vaddq_u32(v, vextq_u32(zero, v, 3));
+            v = vaddq_u32(v, vextq_u32(zero, v, 2));
+            v = vaddq_u32(v, prev);
+            prev = vdupq_laneq_u32(v, 3);
+        }
+        vst1q_u32(out + i, v);
+        data += svb_table.length[c];
+    }
+    svb_decode_scalar(ctrl, data, i, n, Coding, vgetq_lane_u32(prev, 0), out);
+}
+
+#endif
+
+// Decodes n values from ctrl (svb_control_bytes(n) bytes) and data
+// (data_len == svb_data_bytes(ctrl, n) bytes) into out
+inline void svb_decode(const std::byte* ctrl, const std::byte* data, std::size_t data_len, std::size_t n,
+                       packed_coding coding, std::uint32_t* out) noexcept {
+#if defined(BYTESTREAM_BSWAP_X86)
+#  if defined(BYTESTREAM_BSWAP_RUNTIME_DISPATCH)
+    if (cached_simd_level() == simd_level::scalar) {
+        svb_decode_scalar(ctrl, data, 0, n, coding, 0, out);
+        return;
+    }
+#  endif
+    if (coding == packed_coding::delta) svb_decode_ssse3<packed_coding::delta>(ctrl, data, data_len, n, out);
+    else svb_decode_ssse3<packed_coding::plain>(ctrl, data, data_len, n, out);
+#elif defined(BYTESTREAM_SVB_NEON)
+    if (coding == packed_coding::delta) svb_decode_neon<packed_coding::delta>(ctrl, data, data_len, n, out);
+    else svb_decode_neon<packed_coding::plain>(ctrl, data, data_len, n, out);
+#else
+    (void)data_len;
+    svb_decode_scalar(ctrl, data, 0, n, coding, 0, out);
+#endif
+}
+
+} // namespace detail
+} // namespace bytestream
+
+#endif // BYTESTREAM_DETAIL_STREAM_VBYTE_HPP
@@ -0,0 +1,160 @@
+#ifndef BYTESTREAM_DETAIL_VARINT_HPP
+#define BYTESTREAM_DETAIL_VARINT_HPP
+
+#include <bytestream/config.hpp>
+#include <cstring>
+
+#if defined(__BMI2__)
+#  include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+// -------------------------------------------------------------
+// LEB128 varint + ZigZag kernels used by write_varint/read_varint.
+// -------------------------------------------------------------
+namespace bytestream {
+namespace detail {
+
+inline constexpr std::size_t max_varint_bytes = 10;
+
+// index of the lowest set bit; v must be non-zero
+inline unsigned ctz64(std::uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, v);
+    return static_cast<unsigned>(i);
+#else
+    unsigned n = 0;
+    while (!(v & 1u)) { v >>= 1; ++n; }
+    return n;
+#endif
+}
+
+// number of significant bits (0 for v == 0)
+inline BYTESTREAM_CONSTEXPR20 unsigned bit_width64(std::uint64_t v) noexcept {
+    if (is_constant_evaluated()) {
+        unsigned n = 0;
+        while (v) { v >>= 1; ++n; }
+        return n;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return v ? 64u - static_cast<unsigned>(__builtin_clzll(v)) : 0u;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    return _BitScanReverse64(&i, v) ? static_cast<unsigned>(i) + 1u : 0u;
+#else
+    unsigned n = 0;
+    while (v) { v >>= 1; ++n; }
+    return n;
+#endif
+}
+
+inline BYTESTREAM_CONSTEXPR20 std::size_t varint_size(std::uint64_t v) noexcept {
+    // 1 byte per started group of 7 bits, at least one
+    return (static_cast<std::size_t>(bit_width64(v | 1)) + 6) / 7;
+}
+
+inline constexpr std::uint32_t zigzag_encode(std::int32_t v) noexcept {
+    return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+}
+inline constexpr std::uint64_t zigzag_encode(std::int64_t v) noexcept {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+inline constexpr std::int32_t zigzag_decode(std::uint32_t v) noexcept {
+    return static_cast<std::int32_t>((v >> 1) ^ (~(v & 1u) + 1u));
+}
+inline constexpr std::int64_t zigzag_decode(std::uint64_t v) noexcept {
+    return static_cast<std::int64_t>((v >> 1) ^ (~(v & 1u) + 1u));
+}
+
+// Wire bits of an integral value: unsigned as-is, signed ZigZag-mapped
+template <typename T>
+inline constexpr std::uint64_t varint_bits(T v) noexcept {
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "varint: T must be a 32- or 64-bit integer");
+    if constexpr (std::is_signed<T>::value) {
+        using S = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+        return zigzag_encode(static_cast<S>(v));
+    } else {
+        return static_cast<std::uint64_t>(v);
+    }
+}
+
+// Inverse of varint_bits; the caller has checked that v fits T
+template <typename T>
+inline constexpr T varint_value(std::uint64_t v) noexcept {
+    using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    if constexpr (std::is_signed<T>::value) return static_cast<T>(zigzag_decode(static_cast<U>(v)));
+    else return static_cast<T>(v);
+}
+
+// Writes v at out (room for max_varint_bytes), returns the byte count
+inline constexpr std::size_t encode_varint(std::uint64_t v, std::byte* out) noexcept {
+    std::size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<std::byte>(static_cast<std::uint8_t>(v) | 0x80u);
+        v >>= 7;
+    }
+    out[n++] = static_cast<std::byte>(v);
+    return n;
+}
+
+// Packs the low 7 bits of each byte of x (little-endian groups) together
+inline std::uint64_t compact_varint_groups(std::uint64_t x) noexcept {
+#if defined(__BMI2__)
+    return _pext_u64(x, 0x7F7F7F7F7F7F7F7Full);
+#else
+    x &= 0x7F7F7F7F7F7F7F7Full;
+    x = ((x & 0x7F007F007F007F00ull) >> 1) | (x & 0x007F007F007F007Full);
+    x = ((x & 0x3FFF00003FFF0000ull) >> 2) | (x & 0x00003FFF00003FFFull);
+    x = ((x & 0x0FFFFFFF00000000ull) >> 4) | (x & 0x000000000FFFFFFFull);
+    return x;
+#endif
+}
+
+// Decodes a varint from p[0..avail). Returns the byte count, or 0 when
+// the bytes run out before the terminator or the encoding is malformed
+// (longer than 10 bytes or wider than 64 bits); the reader's byte-wise
+// path then reports which.
+inline std::size_t decode_varint(const std::byte* p, std::size_t avail, std::uint64_t& out) noexcept {
+    if (avail >= 8) {
+        // one unaligned load; the first clear high bit ends the varint
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        if constexpr (is_big_endian()) word = byteswap(word);
+        const std::uint64_t stops = ~word & 0x8080808080808080ull;
+        if (stops) {
+            const unsigned bits = ctz64(stops) + 1;           // 8 * len
+            const std::uint64_t keep = bits == 64 ? ~0ull : ((1ull << bits) - 1);
+            out = compact_varint_groups(word & keep);
+            return bits / 8;
+        }
+        // 9 or 10 bytes: the first 8 carry 56 payload bits
+        std::uint64_t v = compact_varint_groups(word);
+        if (avail < 9) return 0;
+        const auto b8 = static_cast<std::uint8_t>(p[8]);
+        v |= static_cast<std::uint64_t>(b8 & 0x7Fu) << 56;
+        if (!(b8 & 0x80u)) { out = v; return 9; }
+        if (avail < 10) return 0;
+        const auto b9 = static_cast<std::uint8_t>(p[9]);
+        if (b9 > 1u) return 0;
+        out = v | (static_cast<std::uint64_t>(b9) << 63);
+        return 10;
+    }
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < avail; ++i) {
+        const auto b = static_cast<std::uint8_t>(p[i]);
+        v |= static_cast<std::uint64_t>(b & 0x7Fu) << (7 * i);
+        if (!(b & 0x80u)) { out = v; return i + 1; }
+    }
+    return 0;
+}
+
+} // namespace detail
+} // namespace bytestream
+
+#endif // BYTESTREAM_DETAIL_VARINT_HPP
@@ -0,0 +1,153 @@
+#ifndef BYTESTREAM_DYNAMIC_WRITER_HPP
+#define BYTESTREAM_DYNAMIC_WRITER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/writer.hpp>
+#include <bytestream/reader.hpp>
+#include <memory>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+#  include <memory_resource>
+#endif
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Growable writer that owns its storage.
+//
+// Same encoding API as Writer; instead of throwing OverflowException it
+// grows geometrically through Alloc. clear() keeps the capacity, so one
+// instance can be reused across messages without touching the heap.
+// Any allocator with value_type std::byte works, including
+// std::pmr::polymorphic_allocator over a monotonic_buffer_resource.
+// ------------------------------------------------------------------
+template <typename Alloc = std::allocator<std::byte>>
+class BasicDynamicWriter : public detail::writer_base<BasicDynamicWriter<Alloc>> {
+    static_assert(std::is_same<typename std::allocator_traits<Alloc>::value_type, std::byte>::value,
+                  "BasicDynamicWriter: allocator value_type must be std::byte");
+    using traits = std::allocator_traits<Alloc>;
+
+    static constexpr std::size_t min_capacity = 64;
+
+    Alloc       alloc_;
+    std::byte*  data_ = nullptr;
+    std::size_t cap_  = 0;
+    std::size_t size_ = 0; // high-water mark
+    std::size_t pos_  = 0;
+public:
+    using allocator_type = Alloc;
+
+    BasicDynamicWriter() noexcept(noexcept(Alloc())) : alloc_() {}
+    explicit BasicDynamicWriter(const Alloc& a) noexcept : alloc_(a) {}
+    explicit BasicDynamicWriter(std::size_t initial_capacity, const Alloc& a = Alloc())
+        : alloc_(a) { reserve(initial_capacity); }
+
+    BasicDynamicWriter(const BasicDynamicWriter&) = delete;
+    BasicDynamicWriter& operator=(const BasicDynamicWriter&) = delete;
+
+    BasicDynamicWriter(BasicDynamicWriter&& o) noexcept
+        : alloc_(std::move(o.alloc_)), data_(o.data_), cap_(o.cap_), size_(o.size_), pos_(o.pos_) {
+        o.data_ = nullptr; o.cap_ = o.size_ = o.pos_ = 0;
+    }
+    BasicDynamicWriter& operator=(BasicDynamicWriter&& o) {
+        if (this == &o) return *this;
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            release_storage();
+            alloc_ = std::move(o.alloc_);
+        } else if (!(alloc_ == o.alloc_)) {
+            // storage belongs to a different resource: copy instead of stealing
+            clear();
+            this->write_bytes(o.data_, o.size_);
+            pos_ = o.pos_;
+            o.clear();
+            return *this;
+        } else {
+            release_storage();
+        }
+        data_ = o.data_; cap_ = o.cap_; size_ = o.size_; pos_ = o.pos_;
+        o.data_ = nullptr; o.cap_ = o.size_ = o.pos_ = 0;
+        return *this;
+    }
+
+    ~BasicDynamicWriter() { release_storage(); }
+
+    // bytes written so far (high-water mark, unaffected by seeking back)
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return cap_; }
+    std::size_t position() const noexcept { return pos_; }
+    // bytes available before the next reallocation
+    std::size_t remaining() const noexcept { return cap_ - pos_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return pos_; }
+
+    std::byte*       data() noexcept       { return data_; }
+    const std::byte* data() const noexcept { return data_; }
+    span<const std::byte> view() const noexcept { return { data_, size_ }; }
+    span<const std::byte> written_view() const noexcept { return view(); }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    void seek(std::size_t p) {
+        if (p > size_) BYTESTREAM_THROW(std::out_of_range("bytestream::DynamicWriter seek past end"));
+        pos_ = p;
+    }
+
+    // drop the contents, keep the storage
+    void clear() noexcept { size_ = 0; pos_ = 0; }
+
+    void reserve(std::size_t n) { if (n > cap_) reallocate(n); }
+
+    // make room for n more bytes at the cursor
+    void ensure(std::size_t n) {
+        if (n > cap_ - pos_) grow(n);
+    }
+
+    std::byte* claim(std::size_t n) {
+        ensure(n);
+        std::byte* p = data_ + pos_;
+        pos_ += n;
+        if (pos_ > size_) size_ = pos_;
+        return p;
+    }
+
+    Reader as_reader() const noexcept { return Reader{data_, size_}; }
+
+private:
+    void grow(std::size_t n) {
+        if (n > traits::max_size(alloc_) - pos_) {
+            BYTESTREAM_COUNT(overflow, n);
+            BYTESTREAM_THROW(OverflowException("bytestream::DynamicWriter overflow"));
+        }
+        std::size_t want = cap_ < min_capacity ? min_capacity : cap_;
+        while (want - pos_ < n) {
+            want = (want > traits::max_size(alloc_) / 2) ? pos_ + n : want * 2;
+        }
+        reallocate(want);
+    }
+
+    void reallocate(std::size_t new_cap) {
+        BYTESTREAM_COUNT(grow, new_cap);
+        std::byte* p = traits::allocate(alloc_, new_cap);
+        if (size_) std::memcpy(p, data_, size_);
+        release_storage();
+        data_ = p;
+        cap_  = new_cap;
+    }
+
+    void release_storage() noexcept {
+        if (data_) traits::deallocate(alloc_, data_, cap_);
+        data_ = nullptr;
+        cap_  = 0;
+    }
+};
+
+using DynamicWriter = BasicDynamicWriter<>;
+
+#if defined(__cpp_lib_memory_resource)
+// Growable writer drawing from a std::pmr resource (e.g. a per-request arena)
+using PmrDynamicWriter = BasicDynamicWriter<std::pmr::polymorphic_allocator<std::byte>>;
+#endif
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_DYNAMIC_WRITER_HPP
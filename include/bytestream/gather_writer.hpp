@@ -0,0 +1,136 @@
+#ifndef BYTESTREAM_GATHER_WRITER_HPP
+#define BYTESTREAM_GATHER_WRITER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/writer.hpp>
+#include <bytestream/dynamic_writer.hpp>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+#  include <sys/uio.h>
+#  define BYTESTREAM_HAS_IOVEC 1
+#endif
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Scatter/gather sink: small fields are copied into an owned inline
+// buffer, blobs of at least ref_threshold() bytes passed to
+// write_bytes()/write_string() are recorded by reference instead.
+// The message comes out as an ordered list of segments (or iovecs for
+// writev/sendmsg/io_uring).
+//
+// Referenced memory must stay valid and unchanged until the segments
+// have been sent. Segments are resolved on each call, so they are
+// invalidated by the next write. No seek: the output is append-only.
+// ------------------------------------------------------------------
+class GatherWriter : public detail::writer_base<GatherWriter> {
+    struct segment {
+        const std::byte* ref;    // nullptr: inline bytes at `offset`
+        std::size_t      offset;
+        std::size_t      size;
+    };
+
+    DynamicWriter        inline_;
+    std::vector<segment> segments_;
+    std::size_t          threshold_;
+    std::size_t          size_ = 0;
+public:
+    static constexpr std::size_t default_ref_threshold = 4096;
+
+    explicit GatherWriter(std::size_t ref_threshold = default_ref_threshold,
+                          std::size_t inline_capacity = 0)
+        : inline_(inline_capacity), threshold_(ref_threshold ? ref_threshold : 1) {}
+
+    // total message bytes (inline + referenced)
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return size_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return size_; }
+    std::size_t inline_size() const noexcept { return inline_.size(); }
+    std::size_t segment_count() const noexcept { return segments_.size(); }
+    std::size_t ref_threshold() const noexcept { return threshold_; }
+
+    void ensure(std::size_t n) { inline_.ensure(n); }
+
+    // drop the message, keep the inline storage
+    void clear() noexcept {
+        inline_.clear();
+        segments_.clear();
+        size_ = 0;
+    }
+
+    std::byte* claim(std::size_t n) {
+        const std::size_t off = inline_.position();
+        std::byte* p = inline_.claim(n);
+        if (n) {
+            if (!segments_.empty() && !segments_.back().ref &&
+                segments_.back().offset + segments_.back().size == off) {
+                segments_.back().size += n;
+            } else {
+                segments_.push_back({ nullptr, off, n });
+            }
+            size_ += n;
+        }
+        return p;
+    }
+
+    // Scalars and other by-value fields always go inline (they may be temporaries)
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable<T>::value, void>
+    write(const T& v) { std::memcpy(claim(sizeof(T)), &v, sizeof(T)); }
+
+    // Large blobs by reference, the rest copied inline
+    void write_bytes(const void* src, std::size_t n) {
+        if (n >= threshold_) {
+            write_ref(src, n);
+        } else {
+            std::byte* p = claim(n);
+            if (n) std::memcpy(p, src, n);
+        }
+    }
+
+    // Record [src, src + n) by reference regardless of the threshold
+    void write_ref(const void* src, std::size_t n) {
+        if (!n) return;
+        segments_.push_back({ static_cast<const std::byte*>(src), 0, n });
+        size_ += n;
+    }
+
+    // Ordered view of the message
+    std::vector<span<const std::byte>> segments() const {
+        std::vector<span<const std::byte>> out;
+        out.reserve(segments_.size());
+        for (const auto& s : segments_) out.push_back({ resolve(s), s.size });
+        return out;
+    }
+
+#if defined(BYTESTREAM_HAS_IOVEC)
+    // writev/sendmsg input; callers split batches above IOV_MAX
+    std::vector<::iovec> iovecs() const {
+        std::vector<::iovec> out;
+        out.reserve(segments_.size());
+        for (const auto& s : segments_)
+            out.push_back({ const_cast<std::byte*>(resolve(s)), s.size });
+        return out;
+    }
+#endif
+
+    // Copy the whole message into dst (size() bytes)
+    void copy_to(void* dst) const noexcept {
+        auto* out = static_cast<std::byte*>(dst);
+        for (const auto& s : segments_) {
+            std::memcpy(out, resolve(s), s.size);
+            out += s.size;
+        }
+    }
+
+private:
+    const std::byte* resolve(const segment& s) const noexcept {
+        return s.ref ? s.ref : inline_.data() + s.offset;
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_GATHER_WRITER_HPP
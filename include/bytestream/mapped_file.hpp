@@ -0,0 +1,503 @@
+#ifndef BYTESTREAM_MAPPED_FILE_HPP
+#define BYTESTREAM_MAPPED_FILE_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+// ------------------------------------------------------------------
+// Memory-mapped files.
+//
+// MappedFile maps a file read-only (MAP_SHARED, so worker processes
+// mapping the same file share its page cache) and hands out Readers
+// over it. MappedFileWriter is a growable sink like DynamicWriter whose
+// storage is a file: it extends the file (ftruncate / SetEndOfFile)
+// and remaps on growth, then trims the file to the bytes written on
+// close(). OS failures throw std::system_error.
+//
+// Not part of core.hpp since it pulls in the platform headers.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+enum class access_hint {
+    normal,
+    sequential, // aggressive read-ahead, drop pages behind the cursor
+    random,     // no read-ahead
+    willneed,   // start paging in now
+    dontneed    // pages may be dropped
+};
+
+struct map_options {
+    access_hint hint       = access_hint::normal;
+    bool        populate   = false; // prefault the whole mapping (MAP_POPULATE on Linux)
+    bool        huge_pages = false; // MADV_HUGEPAGE where supported, ignored elsewhere
+};
+
+namespace detail {
+
+[[noreturn]] inline void throw_os_error(const char* what) {
+#if defined(_WIN32)
+    throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), what);
+#else
+    throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+inline std::size_t os_page_size() noexcept {
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    ::GetSystemInfo(&si);
+    return si.dwAllocationGranularity;
+#else
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+#endif
+}
+
+// Best-effort: hints never fail the caller
+inline void advise_mapping(void* base, std::size_t size, std::size_t offset, std::size_t length,
+                           access_hint hint) noexcept {
+    if (!base || offset >= size) return;
+    if (length > size - offset) length = size - offset;
+#if defined(_WIN32)
+#  if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if (hint == access_hint::willneed) {
+        WIN32_MEMORY_RANGE_ENTRY range{ static_cast<std::byte*>(base) + offset, length };
+        ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+    }
+#  else
+    (void)hint;
+#  endif
+#else
+    // madvise wants a page-aligned start
+    const std::size_t start = offset - offset % os_page_size();
+    void* p = static_cast<std::byte*>(base) + start;
+    const std::size_t n = length + (offset - start);
+    int advice = POSIX_MADV_NORMAL;
+    switch (hint) {
+        case access_hint::normal:     advice = POSIX_MADV_NORMAL;     break;
+        case access_hint::sequential: advice = POSIX_MADV_SEQUENTIAL; break;
+        case access_hint::random:     advice = POSIX_MADV_RANDOM;     break;
+        case access_hint::willneed:   advice = POSIX_MADV_WILLNEED;   break;
+        case access_hint::dontneed:   advice = POSIX_MADV_DONTNEED;   break;
+    }
+    ::posix_madvise(p, n, advice);
+#endif
+}
+
+inline void advise_huge_pages(void* base, std::size_t size) noexcept {
+#if defined(MADV_HUGEPAGE)
+    if (base && size) ::madvise(base, size, MADV_HUGEPAGE);
+#else
+    (void)base; (void)size;
+#endif
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Read-only mapping of a whole file
+// ------------------------------------------------------------------
+class MappedFile {
+    std::byte*  data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE mapping_ = nullptr;
+#endif
+public:
+    MappedFile() noexcept = default;
+
+    explicit MappedFile(const std::string& path, const map_options& opts = map_options{}) {
+#if defined(_WIN32)
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                    OPEN_EXISTING,
+                                    opts.hint == access_hint::sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                    : opts.hint == access_hint::random   ? FILE_FLAG_RANDOM_ACCESS
+                                                                         : FILE_ATTRIBUTE_NORMAL,
+                                    nullptr);
+        if (file == INVALID_HANDLE_VALUE) detail::throw_os_error("bytestream::MappedFile open");
+        LARGE_INTEGER sz;
+        if (!::GetFileSizeEx(file, &sz)) {
+            ::CloseHandle(file);
+            detail::throw_os_error("bytestream::MappedFile size");
+        }
+        size_ = static_cast<std::size_t>(sz.QuadPart);
+        if (size_) {
+            mapping_ = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_) data_ = static_cast<std::byte*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            if (!data_) {
+                const DWORD err = ::GetLastError();
+                if (mapping_) ::CloseHandle(mapping_);
+                ::CloseHandle(file);
+                throw std::system_error(static_cast<int>(err), std::system_category(), "bytestream::MappedFile map");
+            }
+        }
+        ::CloseHandle(file); // the mapping keeps the file open
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) detail::throw_os_error("bytestream::MappedFile open");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "bytestream::MappedFile stat");
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_) {
+            int flags = MAP_SHARED;
+#  if defined(MAP_POPULATE)
+            if (opts.populate) flags |= MAP_POPULATE;
+#  endif
+            void* p = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+            if (p == MAP_FAILED) {
+                const int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "bytestream::MappedFile map");
+            }
+            data_ = static_cast<std::byte*>(p);
+        }
+        ::close(fd); // the mapping keeps the file open
+#endif
+        if (opts.huge_pages) detail::advise_huge_pages(data_, size_);
+        if (opts.hint != access_hint::normal) advise(opts.hint);
+        if (opts.populate) detail::advise_mapping(data_, size_, 0, size_, access_hint::willneed);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& o) noexcept { swap(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            swap(o);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const std::byte* data() const noexcept { return data_; }
+    span<const std::byte> view() const noexcept { return { data_, size_ }; }
+
+    Reader reader() const noexcept { return Reader{data_, size_}; }
+    // Reader over [offset, offset + length) of the file
+    Reader reader(std::size_t offset, std::size_t length) const { return reader().subview(offset, length); }
+
+    // Apply an access hint to [offset, offset + length) of the mapping
+    void advise(access_hint hint, std::size_t offset = 0, std::size_t length = std::size_t(-1)) const noexcept {
+        detail::advise_mapping(data_, size_, offset, length, hint);
+    }
+
+private:
+    void swap(MappedFile& o) noexcept {
+        std::swap(data_, o.data_);
+        std::swap(size_, o.size_);
+#if defined(_WIN32)
+        std::swap(mapping_, o.mapping_);
+#endif
+    }
+
+    void unmap() noexcept {
+#if defined(_WIN32)
+        if (data_) ::UnmapViewOfFile(data_);
+        if (mapping_) ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        if (data_) ::munmap(data_, size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+};
+
+// ------------------------------------------------------------------
+// Growable writer backed by a file mapping
+// ------------------------------------------------------------------
+// Creates (or truncates) the file. Pointers into the mapping are
+// invalidated by growth, as with DynamicWriter.
+class MappedFileWriter : public detail::writer_base<MappedFileWriter> {
+    std::byte*  data_ = nullptr;
+    std::size_t cap_  = 0; // mapped (and file) size
+    std::size_t size_ = 0; // high-water mark
+    std::size_t pos_  = 0;
+    bool        huge_ = false;
+#if defined(_WIN32)
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+public:
+    static constexpr std::size_t min_capacity = std::size_t{1} << 16;
+
+    MappedFileWriter() noexcept = default;
+
+    explicit MappedFileWriter(const std::string& path, std::size_t initial_capacity = 0,
+                              const map_options& opts = map_options{})
+        : huge_(opts.huge_pages) {
+#if defined(_WIN32)
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) detail::throw_os_error("bytestream::MappedFileWriter open");
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) detail::throw_os_error("bytestream::MappedFileWriter open");
+#endif
+        if (initial_capacity) {
+            try {
+                reserve(initial_capacity);
+            } catch (...) {
+                close_handles();
+                throw;
+            }
+        }
+    }
+
+    MappedFileWriter(const MappedFileWriter&) = delete;
+    MappedFileWriter& operator=(const MappedFileWriter&) = delete;
+
+    MappedFileWriter(MappedFileWriter&& o) noexcept { swap(o); }
+    MappedFileWriter& operator=(MappedFileWriter&& o) noexcept {
+        if (this != &o) {
+            close_noexcept();
+            swap(o);
+        }
+        return *this;
+    }
+
+    ~MappedFileWriter() { close_noexcept(); }
+
+    bool is_open() const noexcept {
+#if defined(_WIN32)
+        return file_ != INVALID_HANDLE_VALUE;
+#else
+        return fd_ >= 0;
+#endif
+    }
+
+    // bytes written so far (high-water mark, unaffected by seeking back)
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return cap_; }
+    std::size_t position() const noexcept { return pos_; }
+    std::size_t remaining() const noexcept { return cap_ - pos_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return pos_; }
+
+    std::byte*       data() noexcept       { return data_; }
+    const std::byte* data() const noexcept { return data_; }
+    span<const std::byte> view() const noexcept { return { data_, size_ }; }
+    Reader as_reader() const noexcept { return Reader{data_, size_}; }
+
+    void seek(std::size_t p) {
+        if (p > size_) throw std::out_of_range("bytestream::MappedFileWriter seek past end");
+        pos_ = p;
+    }
+
+    void reserve(std::size_t n) { if (n > cap_) remap(round_to_page(n)); }
+
+    // make room for n more bytes at the cursor
+    void ensure(std::size_t n) {
+        if (n > cap_ - pos_) grow(n);
+    }
+
+    std::byte* claim(std::size_t n) {
+        ensure(n);
+        std::byte* p = data_ + pos_;
+        pos_ += n;
+        if (pos_ > size_) size_ = pos_;
+        return p;
+    }
+
+    // Write dirty pages of [0, size()) back to the file
+    void flush() {
+        if (!data_ || !size_) return;
+#if defined(_WIN32)
+        if (!::FlushViewOfFile(data_, size_) || !::FlushFileBuffers(file_))
+            detail::throw_os_error("bytestream::MappedFileWriter flush");
+#else
+        if (::msync(data_, size_, MS_SYNC) != 0) detail::throw_os_error("bytestream::MappedFileWriter flush");
+#endif
+    }
+
+    // Unmap, trim the file to size() and close it
+    void close() {
+        if (!is_open()) return;
+        unmap();
+        const bool ok = set_file_size(size_);
+        if (!ok) {
+            const std::system_error err(last_error(), error_category(), "bytestream::MappedFileWriter truncate");
+            close_handles();
+            throw err;
+        }
+        close_handles();
+    }
+
+private:
+    std::size_t round_to_page(std::size_t n) const {
+        const std::size_t page = detail::os_page_size();
+        if (n > std::numeric_limits<std::size_t>::max() - page)
+            throw OverflowException("bytestream::MappedFileWriter overflow");
+        return (n + page - 1) / page * page;
+    }
+
+    void grow(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / 2 - pos_)
+            throw OverflowException("bytestream::MappedFileWriter overflow");
+        std::size_t want = cap_ < min_capacity ? min_capacity : cap_;
+        while (want - pos_ < n) want *= 2;
+        remap(round_to_page(want));
+    }
+
+    static int last_error() noexcept {
+#if defined(_WIN32)
+        return static_cast<int>(::GetLastError());
+#else
+        return errno;
+#endif
+    }
+    static const std::error_category& error_category() noexcept {
+#if defined(_WIN32)
+        return std::system_category();
+#else
+        return std::generic_category();
+#endif
+    }
+
+    bool set_file_size(std::size_t n) noexcept {
+#if defined(_WIN32)
+        LARGE_INTEGER li;
+        li.QuadPart = static_cast<LONGLONG>(n);
+        return ::SetFilePointerEx(file_, li, nullptr, FILE_BEGIN) && ::SetEndOfFile(file_);
+#else
+        return ::ftruncate(fd_, static_cast<off_t>(n)) == 0;
+#endif
+    }
+
+    // Grow the file and the mapping to new_cap. On failure the writer
+    // keeps its old mapping (POSIX), or on Windows, where the view must
+    // go before the file can grow, remaps the old size; only if that
+    // fails too is it left empty (cap_ == pos_ == size_ == 0).
+    void remap(std::size_t new_cap) {
+        if (!is_open()) throw std::logic_error("bytestream::MappedFileWriter is closed");
+#if defined(_WIN32)
+        const std::size_t old_cap = cap_;
+        unmap();
+        if (!set_file_size(new_cap) || !map_view()) {
+            const std::system_error err(last_error(), error_category(), "bytestream::MappedFileWriter map");
+            if (!old_cap || !set_file_size(old_cap) || !map_view()) {
+                unmap();
+                pos_ = size_ = 0;
+            } else {
+                cap_ = old_cap;
+            }
+            throw err;
+        }
+#else
+        if (!set_file_size(new_cap)) detail::throw_os_error("bytestream::MappedFileWriter resize");
+        void* p = MAP_FAILED;
+        bool moved = false;
+#  if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        if (data_) {
+            p = ::mremap(data_, cap_, new_cap, MREMAP_MAYMOVE); // the old mapping stays on failure
+            moved = true;
+        } else
+#  endif
+        {
+            p = ::mmap(nullptr, new_cap, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        }
+        if (p == MAP_FAILED) {
+            const int err = errno;
+            (void)set_file_size(cap_); // best effort: back to the mapped size
+            throw std::system_error(err, std::generic_category(), "bytestream::MappedFileWriter map");
+        }
+        if (data_ && !moved) ::munmap(data_, cap_);
+        data_ = static_cast<std::byte*>(p);
+#endif
+        cap_ = new_cap;
+        if (huge_) detail::advise_huge_pages(data_, cap_);
+    }
+
+#if defined(_WIN32)
+    // Map the whole file; false (nothing mapped) on failure
+    bool map_view() noexcept {
+        mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        if (!mapping_) return false;
+        data_ = static_cast<std::byte*>(::MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, 0));
+        if (data_) return true;
+        const DWORD err = ::GetLastError();
+        ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+        ::SetLastError(err);
+        return false;
+    }
+#endif
+
+    void unmap() noexcept {
+#if defined(_WIN32)
+        if (data_) ::UnmapViewOfFile(data_);
+        if (mapping_) ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        if (data_) ::munmap(data_, cap_);
+#endif
+        data_ = nullptr;
+        cap_  = 0;
+    }
+
+    void close_handles() noexcept {
+        unmap();
+#if defined(_WIN32)
+        if (file_ != INVALID_HANDLE_VALUE) ::CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+    }
+
+    void close_noexcept() noexcept {
+        try { close(); } catch (...) { close_handles(); }
+        data_ = nullptr;
+        cap_ = size_ = pos_ = 0;
+    }
+
+    void swap(MappedFileWriter& o) noexcept {
+        std::swap(data_, o.data_);
+        std::swap(cap_, o.cap_);
+        std::swap(size_, o.size_);
+        std::swap(pos_, o.pos_);
+        std::swap(huge_, o.huge_);
+#if defined(_WIN32)
+        std::swap(file_, o.file_);
+        std::swap(mapping_, o.mapping_);
+#else
+        std::swap(fd_, o.fd_);
+#endif
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_MAPPED_FILE_HPP
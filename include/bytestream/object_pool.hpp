@@ -0,0 +1,77 @@
+#ifndef BYTESTREAM_OBJECT_POOL_HPP
+#define BYTESTREAM_OBJECT_POOL_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/serialization.hpp>
+#include <memory>
+#include <vector>
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Pool of reusable decode targets.
+//
+//   bytestream::ObjectPool<Order> pool;
+//   for (;;) {
+//       auto order = pool.decode(reader);     // read_field_into a recycled Order
+//       handle(*order);
+//   }                                          // back to the pool here
+//
+// Released objects keep their members (and so their string/vector
+// capacity); the next decode overwrites them in place. Once the pool
+// and its objects are warm, acquire/decode/release do not allocate.
+// Not thread-safe: use one pool per consumer thread. The pool must
+// outlive its handles.
+// ------------------------------------------------------------------
+template <typename T>
+class ObjectPool {
+    std::vector<std::unique_ptr<T>> free_;
+    std::size_t                     max_cached_;
+
+    struct releaser {
+        ObjectPool* pool;
+        void operator()(T* p) const noexcept { pool->give_back(p); }
+    };
+public:
+    using handle = std::unique_ptr<T, releaser>;
+
+    explicit ObjectPool(std::size_t max_cached = 64) : max_cached_(max_cached) { free_.reserve(max_cached); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    std::size_t cached() const noexcept { return free_.size(); }
+
+    // Default-construct up to n objects ahead of time
+    void prewarm(std::size_t n) {
+        while (free_.size() < n && free_.size() < max_cached_) free_.push_back(std::make_unique<T>());
+    }
+
+    // A recycled object (previous contents intact) or a new T{}
+    handle acquire() {
+        if (free_.empty()) return handle(new T(), releaser{ this });
+        T* p = free_.back().release();
+        free_.pop_back();
+        return handle(p, releaser{ this });
+    }
+
+    // acquire() + read_field_into
+    template <length_prefix P = length_prefix::u32_le, typename R>
+    handle decode(R& r) {
+        handle h = acquire();
+        read_field_into<P>(r, *h);
+        return h;
+    }
+
+private:
+    void give_back(T* p) noexcept {
+        if (free_.size() < max_cached_) {
+            free_.emplace_back(p); // capacity reserved up front: no allocation
+        } else {
+            delete p;
+        }
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_OBJECT_POOL_HPP
@@ -0,0 +1,162 @@
+#ifndef BYTESTREAM_PARALLEL_HPP
+#define BYTESTREAM_PARALLEL_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/serialization.hpp>
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------------
+// Parallel decoding of length-prefixed record streams.
+//
+//   auto index = bytestream::index_records(reader);       // prefixes only
+//   auto trades = bytestream::parallel_decode(reader, index,
+//       [](bytestream::Reader& rec) { return read_field<Trade>(rec); });
+//
+// index_records() walks the length prefixes (the write_sized_string_le /
+// write_field(string) layout, or varint prefixes) without touching the
+// payloads. parallel_decode() then splits the index into contiguous
+// ranges, decodes each on its own thread with a Reader::subview per
+// record, and returns the results in record order.
+//
+// The decoder runs concurrently: it must not share mutable state
+// without synchronization. A DecodeBudget attached to the source is not
+// propagated (budgets are single-threaded); attach one per record
+// inside the decoder if needed. The first exception thrown by any
+// decoder is rethrown on the calling thread after all workers stop.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+// Payload location of one record inside the source buffer
+struct record_span {
+    std::size_t offset;
+    std::size_t size;
+};
+
+struct parallel_options {
+    std::size_t threads = 0;             // 0: std::thread::hardware_concurrency()
+    std::size_t min_records_per_thread = 256;
+};
+
+// Scan length prefixes from r's cursor to its end; r is left at the end.
+// Throws UnderflowException on a truncated record.
+template <length_prefix P = length_prefix::u32_le>
+std::vector<record_span> index_records(Reader& r) {
+    std::vector<record_span> out;
+    while (r.remaining()) {
+        const std::size_t n   = detail::read_length<P>(r);
+        const std::size_t off = r.position();
+        r.skip(n);
+        out.push_back({ off, n });
+    }
+    return out;
+}
+
+template <length_prefix P = length_prefix::u32_le>
+std::vector<record_span> index_records(const void* data, std::size_t size) {
+    Reader r(data, size);
+    return index_records<P>(r);
+}
+
+namespace detail {
+
+inline std::size_t parallel_worker_count(std::size_t records, const parallel_options& opt) noexcept {
+    std::size_t t = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t grain = std::max<std::size_t>(1, opt.min_records_per_thread);
+    t = std::min(t, (records + grain - 1) / grain);
+    return std::max<std::size_t>(1, t);
+}
+
+// Subview over one record without the source's DecodeBudget (which
+// is not thread-safe and would be shared by every worker)
+inline Reader record_reader(const Reader& src, const record_span& rec) {
+    Reader r = src.subview(rec.offset, rec.size);
+    r.set_budget(nullptr);
+    return r;
+}
+
+// Run body(begin, end, worker) over [0, count) split into `workers` contiguous
+// ranges; worker 0 runs on the calling thread
+template <typename Body>
+void parallel_ranges(std::size_t count, std::size_t workers, Body&& body) {
+    if (workers <= 1) {
+        body(std::size_t{0}, count, std::size_t{0});
+        return;
+    }
+    std::exception_ptr error;
+    std::mutex         error_mutex;
+    auto run = [&](std::size_t w) {
+        const std::size_t begin = count * w / workers;
+        const std::size_t end   = count * (w + 1) / workers;
+        try {
+            body(begin, end, w);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    try {
+        for (std::size_t w = 1; w < workers; ++w) pool.emplace_back(run, w);
+    } catch (...) {
+        for (auto& t : pool) t.join();
+        throw;
+    }
+    run(0);
+    for (auto& t : pool) t.join();
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace detail
+
+// Call visit(index, record_reader) for every record, in parallel
+template <typename Visit>
+void parallel_for_records(const Reader& src, const std::vector<record_span>& index, Visit&& visit,
+                          const parallel_options& opt = {}) {
+    const std::size_t workers = detail::parallel_worker_count(index.size(), opt);
+    detail::parallel_ranges(index.size(), workers, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Reader rec = detail::record_reader(src, index[i]);
+            visit(i, rec);
+        }
+    });
+}
+
+// Decode every record with decode(Reader&) and return the results in order
+template <typename Decode>
+auto parallel_decode(const Reader& src, const std::vector<record_span>& index, Decode&& decode,
+                     const parallel_options& opt = {}) {
+    using result_type = std::decay_t<decltype(decode(std::declval<Reader&>()))>;
+    static_assert(!std::is_void<result_type>::value, "parallel_decode: use parallel_for_records for void decoders");
+
+    const std::size_t workers = detail::parallel_worker_count(index.size(), opt);
+    std::vector<std::vector<result_type>> parts(workers);
+    detail::parallel_ranges(index.size(), workers, [&](std::size_t begin, std::size_t end, std::size_t w) {
+        auto& part = parts[w];
+        part.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) {
+            Reader rec = detail::record_reader(src, index[i]);
+            part.push_back(decode(rec));
+        }
+    });
+
+    if (workers == 1) return std::move(parts[0]);
+    std::vector<result_type> out;
+    out.reserve(index.size());
+    for (auto& part : parts)
+        out.insert(out.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+    return out;
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_PARALLEL_HPP
@@ -2,84 +2,441 @@
 #define BYTESTREAM_READER_HPP
 
 #include <bytestream/config.hpp>
+#include <bytestream/decode_limits.hpp>
+#include <bytestream/detail/byteswap_array.hpp>
+#include <bytestream/detail/instrument_hooks.hpp>
+#include <bytestream/detail/stream_vbyte.hpp>
+#include <bytestream/detail/varint.hpp>
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace bytestream {
 
-class Reader {
+class UncheckedReader; // fwd
+
+namespace detail {
+
+// ------------------------------------------------------------------
+// Shared decoding surface for every reader-like source (CRTP).
+// Derived provides:
+//   const std::byte*      take(std::size_t n)  // consume n bytes at the cursor, return them
+//   span<const std::byte> peek_contiguous()    // bytes readable without a refill
+// Sources with sticky_errors (NothrowReader) also provide fail(errc) and
+// return nullptr from a take() that fails; every use of take() here
+// copes with that, and with the throwing sources it compiles away.
+// ------------------------------------------------------------------
+template <typename Derived>
+class reader_base {
+    constexpr Derived& self() noexcept { return static_cast<Derived&>(*this); }
+    static constexpr bool sticky() noexcept { return sticky_errors<Derived>::value; }
+public:
+    // Optional decode limits for untrusted input (not owned)
+    void set_budget(DecodeBudget* b) noexcept { budget_ = b; }
+    DecodeBudget* budget() const noexcept { return budget_; }
+
+    BYTESTREAM_CONSTEXPR20 void skip(std::size_t n) { self().take(n); }
+
+    // ---- raw bytes
+    void read_bytes(void* dst, std::size_t n) {
+        BYTESTREAM_COUNT(read_bytes, n);
+        const std::byte* p = self().take(n);
+        if (n) std::memcpy(dst, source_or_zeros(p, n, dst), n);
+    }
+    void read_bytes(span<std::byte> out) { self().read_bytes(out.data(), out.size()); }
+
+    // ---- trivially-copyable read
+    template <typename T>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<std::is_trivially_copyable<T>::value, T>
+    read() {
+        BYTESTREAM_COUNT(read_fixed, sizeof(T));
+        return load_native<T>(take_fixed<sizeof(T)>());
+    }
+
+    // ---- arithmetic endian-aware (one load, swapped in register)
+    template <typename T>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<is_arithmetic<T>::value, T>
+    read_le() {
+        BYTESTREAM_COUNT(read_fixed, sizeof(T));
+        return load_le<T>(take_fixed<sizeof(T)>());
+    }
+    template <typename T>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<is_arithmetic<T>::value, T>
+    read_be() {
+        BYTESTREAM_COUNT(read_fixed, sizeof(T));
+        return load_be<T>(take_fixed<sizeof(T)>());
+    }
+
+    // ---- arrays
+    template <typename T>
+    void read_array(span<T> out) {
+        const std::size_t n = array_bytes<T>(out.size());
+        BYTESTREAM_COUNT(read_array, n);
+        copy_out(out.data(), n);
+    }
+    // one bounds check per array; bulk byteswap (SIMD where available)
+    // or a single memcpy when the wire order matches the host
+    template <typename T>
+    std::enable_if_t<is_arithmetic<T>::value, void>
+    read_array_be(span<T> out) { read_array_ordered<T, endian::big>(out); }
+    template <typename T>
+    std::enable_if_t<is_arithmetic<T>::value, void>
+    read_array_le(span<T> out) { read_array_ordered<T, endian::little>(out); }
+
+    // Counterpart of write_packed_u32_array; out.size() values, same coding
+    void read_packed_u32_array(span<std::uint32_t> out, packed_coding coding = packed_coding::plain) {
+        const std::size_t n     = out.size();
+        const std::size_t nctrl = detail::svb_control_bytes(n);
+        BYTESTREAM_COUNT(read_array, n * sizeof(std::uint32_t));
+        const span<const std::byte> avail = self().peek_contiguous();
+        if (avail.size() >= nctrl) {
+            // one take for control + data: an underflow leaves the cursor alone
+            const std::size_t data = detail::svb_data_bytes(avail.data(), n);
+            const std::byte* p = self().take(nctrl + data);
+            if (!p) return zero_fill(out.data(), n);
+            detail::svb_decode(p, p + nctrl, data, n, coding, out.data());
+            return;
+        }
+        // control bytes span a refill: keep a copy while the data is taken
+        const std::byte* c = self().take(nctrl);
+        if (!c) return zero_fill(out.data(), n);
+        std::vector<std::byte> ctrl(c, c + nctrl);
+        const std::size_t data = detail::svb_data_bytes(ctrl.data(), n);
+        const std::byte* p = self().take(data);
+        if (!p) return zero_fill(out.data(), n);
+        detail::svb_decode(ctrl.data(), p, data, n, coding, out.data());
+    }
+
+    // ---- varints (LEB128; signed types are ZigZag-encoded)
+    template <typename T>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), T>
+    read_varint() {
+        const std::uint64_t bits = read_varint_bits();
+        BYTESTREAM_COUNT(read_varint, detail::varint_size(bits));
+        if constexpr (sizeof(T) == 4) {
+            if (bits > 0xFFFFFFFFull) {
+                raise(errc::format, "bytestream::Reader varint out of range");
+                return T{};
+            }
+        }
+        return detail::varint_value<T>(bits);
+    }
+
+    // ---- strings
+    std::string read_string(std::size_t n) {
+        std::string s;
+        self().read_string_into(s, n);
+        return s;
+    }
+    // Decode into s, reusing its capacity (no allocation once it is large enough)
+    void read_string_into(std::string& s, std::size_t n) {
+        BYTESTREAM_COUNT(read_string, n);
+        string_into(s, n);
+    }
+    std::string read_sized_string_le() {
+        const std::size_t n = load_le<std::uint32_t>(take_fixed<4>());
+        BYTESTREAM_COUNT(read_string, n);
+        std::string s;
+        string_into(s, n);
+        return s;
+    }
+    std::string read_sized_string_be() {
+        const std::size_t n = load_be<std::uint32_t>(take_fixed<4>());
+        BYTESTREAM_COUNT(read_string, n);
+        std::string s;
+        string_into(s, n);
+        return s;
+    }
+    std::string_view view_string(std::size_t n) {
+        BYTESTREAM_COUNT(read_string, n);
+        return string_view_of(n);
+    }
+    std::string_view view_sized_string_le() {
+        const std::size_t n = load_le<std::uint32_t>(take_fixed<4>());
+        BYTESTREAM_COUNT(read_string, n);
+        return string_view_of(n);
+    }
+    std::string read_sized_string_varint() {
+        const std::size_t n = read_varint_length();
+        BYTESTREAM_COUNT(read_string, n);
+        std::string s;
+        string_into(s, n);
+        return s;
+    }
+    std::string_view view_sized_string_varint() {
+        const std::size_t n = read_varint_length();
+        BYTESTREAM_COUNT(read_string, n);
+        return string_view_of(n);
+    }
+
+    // ---- zero-copy views (valid while the source buffer is)
+    span<const std::byte> view_bytes(std::size_t n) {
+        BYTESTREAM_COUNT(read_bytes, n);
+        const std::byte* p = self().take(n);
+        if (!p) return {};
+        return { p, n };
+    }
+
+    // n native-layout elements in place; the data must be aligned for T
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable<T>::value, span<const T>>
+    view_array(std::size_t n) {
+        BYTESTREAM_COUNT(read_array, n * sizeof(T));
+        const std::size_t bytes = array_bytes<T>(n);
+        // reject misaligned data before the cursor moves
+        const span<const std::byte> avail = self().peek_contiguous();
+        if (avail.size() >= bytes && reinterpret_cast<std::uintptr_t>(avail.data()) % alignof(T) != 0) {
+            raise(errc::alignment, "bytestream::Reader view_array misaligned");
+            return {};
+        }
+        const std::byte* p = self().take(bytes);
+        if (!p) return {};
+        if (reinterpret_cast<std::uintptr_t>(p) % alignof(T) != 0) { // stitched copy
+            raise(errc::alignment, "bytestream::Reader view_array misaligned");
+            return {};
+        }
+        return { reinterpret_cast<const T*>(p), n };
+    }
+
+    // ---- native helper used by serialization.hpp
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable<T>::value, T>
+    read_native() { return self().template read<T>(); }
+
+    BYTESTREAM_CONSTEXPR20 std::size_t read_varint_length() {
+        const std::uint64_t n = read_varint_bits();
+        if (n > std::numeric_limits<std::size_t>::max()) {
+            raise(errc::underflow, "bytestream::Reader underflow");
+            return 0;
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+protected:
+    DecodeBudget* budget_ = nullptr;
+
+    // Throwing sources raise the matching exception; sticky ones record it
+    BYTESTREAM_CONSTEXPR20 void raise(errc e, const char* what) {
+        if constexpr (sticky()) self().fail(e);
+        else throw_error(e, what);
+    }
+
+    // take() for a fixed-size load: zeros once a sticky source has failed
+    template <std::size_t N>
+    BYTESTREAM_CONSTEXPR20 const std::byte* take_fixed() {
+        const std::byte* p = self().take(N);
+        if constexpr (sticky()) {
+            if (!p) return zero_bytes<N>;
+        }
+        return p;
+    }
+
+private:
+    template <typename T>
+    std::size_t array_bytes(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            raise(errc::underflow, "bytestream::Reader underflow");
+            return std::numeric_limits<std::size_t>::max(); // the take() fails too
+        }
+        return n * sizeof(T);
+    }
+
+    // p, or (sticky source, failed take) dst cleared and returned
+    static const void* source_or_zeros(const std::byte* p, std::size_t n, void* dst) noexcept {
+        if constexpr (sticky()) {
+            if (!p) return std::memset(dst, 0, n);
+        }
+        return p;
+    }
+    template <typename T>
+    static void zero_fill(T* out, std::size_t n) noexcept {
+        if (n) std::memset(out, 0, n * sizeof(T));
+    }
+
+    // read_bytes without counting it again; sources whose own read_bytes
+    // avoids stitching (StreamReader) still get it when a refill is due
+    void copy_out(void* dst, std::size_t n) {
+        if (self().peek_contiguous().size() >= n) {
+            if (n) std::memcpy(dst, self().take(n), n);
+        } else {
+            self().read_bytes(dst, n);
+        }
+    }
+
+    bool budget_allows_string(std::size_t n, bool charge) {
+        if (!budget_) return true;
+        if constexpr (sticky()) {
+            if (budget_->allows_string(n) && (!charge || budget_->try_charge(n))) return true;
+            self().fail(errc::limit);
+            return false;
+        } else {
+            budget_->check_string(n);
+            if (charge) budget_->charge(n);
+            return true;
+        }
+    }
+
+    void string_into(std::string& s, std::size_t n) {
+        if (!budget_allows_string(n, true)) return s.clear();
+        if (self().peek_contiguous().size() >= n) {
+            // bounds-checked before allocating
+            const std::byte* p = self().take(n);
+            s.assign(reinterpret_cast<const char*>(p), n);
+            return;
+        }
+        // source refills (or is short): grow only as far as bytes arrive
+        s.clear();
+        for (std::size_t done = 0; done < n;) {
+            const std::size_t k = std::min(n - done, std::size_t{64} << 10);
+            s.resize(done + k);
+            self().read_bytes(&s[done], k);
+            done += k;
+            if constexpr (sticky()) {
+                if (!self().ok()) return s.clear();
+            }
+        }
+    }
+
+    std::string_view string_view_of(std::size_t n) {
+        if (!budget_allows_string(n, false)) return {};
+        const std::byte* p = self().take(n);
+        if (!p) return {};
+        return std::string_view(reinterpret_cast<const char*>(p), n);
+    }
+
+    BYTESTREAM_CONSTEXPR20 std::uint64_t read_varint_bits() {
+        std::uint64_t v = 0;
+        // fast path: whole varint within the contiguous bytes
+        if (!is_constant_evaluated()) {
+            const span<const std::byte> avail = self().peek_contiguous();
+            if (const std::size_t n = detail::decode_varint(avail.data(), avail.size(), v)) {
+                self().take(n);
+                return v;
+            }
+        }
+        // slow path: byte at a time across refills / up to the underflow
+        v = 0;
+        for (std::size_t i = 0; i < detail::max_varint_bytes; ++i) {
+            const auto b = static_cast<std::uint8_t>(*take_fixed<1>());
+            if (i == detail::max_varint_bytes - 1 && b > 1u) break;
+            v |= static_cast<std::uint64_t>(b & 0x7Fu) << (7 * i);
+            if (!(b & 0x80u)) return v;
+        }
+        raise(errc::format, "bytestream::Reader malformed varint");
+        return 0;
+    }
+
+    template <typename T, endian Order>
+    void read_array_ordered(span<T> out) {
+        const std::size_t n = out.size();
+        const std::byte* p = self().take(array_bytes<T>(n));
+        if (!p) return zero_fill(out.data(), n);
+        if constexpr (Order == endian::native) {
+            if (n) std::memcpy(out.data(), p, n * sizeof(T));
+        } else {
+            byteswap_copy_of<T>(out.data(), p, n);
+        }
+    }
+};
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Cursor over a range that was bounds-checked once up front.
+// Obtain it from Reader::unchecked(n); overruns are caught by
+// BYTESTREAM_ASSERT in debug builds only.
+// ------------------------------------------------------------------
+class UncheckedReader : public detail::reader_base<UncheckedReader> {
     const std::byte* data_;
     std::size_t      size_;
     std::size_t      pos_;
 public:
-    Reader(const void* data, std::size_t size) noexcept
+    UncheckedReader(const void* data, std::size_t size) noexcept
         : data_(static_cast<const std::byte*>(data)), size_(size), pos_(0) {}
 
-    template <class T>
-    explicit Reader(span<T> s) noexcept
-        : data_(reinterpret_cast<const std::byte*>(s.data())), size_(s.size()*sizeof(T)), pos_(0) {}
-
     std::size_t size() const noexcept { return size_; }
     std::size_t position() const noexcept { return pos_; }
     std::size_t remaining() const noexcept { return size_ - pos_; }
-    bool empty() const noexcept { return size_ == 0; }
     bool exhausted() const noexcept { return pos_ >= size_; }
     const std::byte* data() const noexcept { return data_; }
-    // Zero-copy peek at all bytes left to read
-    span<const std::byte> remaining_bytes_view() const noexcept {
-        return { data_ + pos_, size_ - pos_ };
-    }
 
-    void ensure(std::size_t n) const {
-        if (n > (size_ - pos_)) throw UnderflowException("bytestream::Reader underflow");
+    span<const std::byte> peek_contiguous() const noexcept { return { data_ + pos_, size_ - pos_ }; }
+
+    void ensure(std::size_t n) const noexcept { BYTESTREAM_ASSERT(n <= size_ - pos_); (void)n; }
+
+    const std::byte* take(std::size_t n) noexcept {
+        ensure(n);
+        const std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
     }
+};
 
-    void seek(std::size_t p) {
-        if (p > size_) throw std::out_of_range("bytestream::Reader seek past end");
-        pos_ = p;
+class Reader : public detail::reader_base<Reader> {
+    const std::byte* data_;
+    std::size_t      size_;
+    std::size_t      pos_;
+public:
+    Reader(const void* data, std::size_t size) noexcept
+        : data_(static_cast<const std::byte*>(data)), size_(size), pos_(0) {}
+    // constexpr for std::byte data (StaticWriter::as_reader, compile-time
+    // tables); a template so Reader(nullptr, 0) still picks the one above
+    template <class B, std::enable_if_t<std::is_same<B, std::byte>::value, int> = 0>
+    constexpr Reader(const B* data, std::size_t size) noexcept
+        : data_(data), size_(size), pos_(0) {}
+
+    template <class T>
+    constexpr explicit Reader(span<T> s) noexcept
+        : data_(bytes_of(s.data())), size_(s.size()*sizeof(T)), pos_(0) {}
+
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr std::size_t position() const noexcept { return pos_; }
+    constexpr std::size_t remaining() const noexcept { return size_ - pos_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr bool exhausted() const noexcept { return pos_ >= size_; }
+    constexpr const std::byte* data() const noexcept { return data_; }
+    // Zero-copy peek at all bytes left to read
+    constexpr span<const std::byte> remaining_bytes_view() const noexcept {
+        return { data_ + pos_, size_ - pos_ };
     }
-    void rewind() noexcept { pos_ = 0; }
-    void skip(std::size_t n) { ensure(n); pos_ += n; }
+    constexpr span<const std::byte> peek_contiguous() const noexcept { return remaining_bytes_view(); }
 
-    bool is_aligned(std::size_t a) const noexcept { return a == 0 || (pos_ % a) == 0; }
-    void align(std::size_t a) {
-        std::size_t next = align_up(pos_, a);
-        if (next > size_) throw UnderflowException("bytestream::Reader align beyond end");
-        pos_ = next;
+    BYTESTREAM_CONSTEXPR20 void ensure(std::size_t n) const {
+        if (n > (size_ - pos_)) {
+            BYTESTREAM_COUNT(underflow, n);
+            BYTESTREAM_THROW(UnderflowException("bytestream::Reader underflow"));
+        }
     }
 
-    // ---- raw bytes
-    void read_bytes(void* dst, std::size_t n) {
+    // Consume n bytes at the cursor and return a pointer to them
+    BYTESTREAM_CONSTEXPR20 const std::byte* take(std::size_t n) {
         ensure(n);
-        std::memcpy(dst, data_ + pos_, n);
+        const std::byte* p = data_ + pos_;
         pos_ += n;
+        return p;
     }
-    void read_bytes(span<std::byte> out) { read_bytes(out.data(), out.size()); }
 
-    // ---- trivially-copyable read
-    template <typename T>
-    std::enable_if_t<std::is_trivially_copyable<T>::value, T>
-    read() {
-        T v{};
-        read_bytes(&v, sizeof(T));
-        return v;
+    // Validate n bytes once, consume them, and return an unchecked cursor
+    // over exactly that range (fixed-layout frames)
+    UncheckedReader unchecked(std::size_t n) {
+        UncheckedReader u{take(n), n};
+        u.set_budget(budget_);
+        return u;
     }
 
-    // ---- arithmetic endian-aware
-    template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, T>
-    read_le() {
-        T v = read<T>();
-        if constexpr (is_big_endian()) v = byteswap(v);
-        return v;
+    void seek(std::size_t p) {
+        if (p > size_) BYTESTREAM_THROW(std::out_of_range("bytestream::Reader seek past end"));
+        pos_ = p;
     }
-    template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, T>
-    read_be() {
-        T v = read<T>();
-        if constexpr (is_little_endian()) v = byteswap(v);
-        return v;
+    constexpr void rewind() noexcept { pos_ = 0; }
+
+    bool is_aligned(std::size_t a) const noexcept { return a == 0 || (pos_ % a) == 0; }
+    void align(std::size_t a) {
+        std::size_t next = align_up(pos_, a);
+        if (next > size_) BYTESTREAM_THROW(UnderflowException("bytestream::Reader align beyond end"));
+        pos_ = next;
     }
 
     // ---- peek (no advance)
@@ -98,71 +455,104 @@ public:
         return v;
     }
 
-    // ---- arrays
-    template <typename T>
-    void read_array(span<T> out) {
-        read_bytes(out.data(), out.size() * sizeof(T));
-    }
-    template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, void>
-    read_array_be(span<T> out) {
-        for (std::size_t i = 0; i < out.size(); ++i) out.data()[i] = read_be<T>();
-    }
-    template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, void>
-    read_array_le(span<T> out) {
-        for (std::size_t i = 0; i < out.size(); ++i) out.data()[i] = read_le<T>();
-    }
-
     // ---- strings
-    std::string read_string(std::size_t n) {
-        std::string s;
-        s.resize(n);
-        if (n) read_bytes(&s[0], n);
-        return s;
-    }
-    std::string read_sized_string_le() {
-        auto len = read_le<std::uint32_t>();
-        return read_string(len);
-    }
-    std::string read_sized_string_be() {
-        auto len = read_be<std::uint32_t>();
-        return read_string(len);
-    }
     std::string read_cstring() {
         // scan for 0 byte
         std::size_t i = pos_;
         for (; i < size_; ++i) {
             if (data_[i] == std::byte{0}) break;
         }
-        if (i == size_) throw UnderflowException("bytestream::Reader cstring unterminated");
+        if (i == size_) BYTESTREAM_THROW(UnderflowException("bytestream::Reader cstring unterminated"));
         std::size_t n = i - pos_;
         std::string s = read_string(n);
         // consume terminator
         skip(1);
         return s;
     }
-    std::string_view view_string(std::size_t n) {
-        ensure(n);
-        auto sv = std::string_view(reinterpret_cast<const char*>(data_ + pos_), n);
-        pos_ += n;
-        return sv;
-    }
 
     // ---- subviews
     Reader subview(std::size_t offset, std::size_t length) const {
-        if (offset > size_ || length > (size_ - offset)) throw std::out_of_range("bytestream::Reader subview OOB");
-        return Reader{data_ + offset, length};
+        if (offset > size_ || length > (size_ - offset)) BYTESTREAM_THROW(std::out_of_range("bytestream::Reader subview OOB"));
+        Reader r{data_ + offset, length};
+        r.set_budget(budget_);
+        return r;
     }
     Reader subview(std::size_t offset) const {
-        if (offset > size_) throw std::out_of_range("bytestream::Reader subview OOB");
-        return Reader{data_ + offset, size_ - offset};
+        if (offset > size_) BYTESTREAM_THROW(std::out_of_range("bytestream::Reader subview OOB"));
+        Reader r{data_ + offset, size_ - offset};
+        r.set_budget(budget_);
+        return r;
     }
 
-    // ---- native helper used by serialization.hpp
-    template <typename T>
-    std::enable_if_t<std::is_trivially_copyable<T>::value, T>
-    read_native() { return read<T>(); }
+private:
+    // byte spans need no cast (so stay constexpr)
+    template <class T>
+    static constexpr const std::byte* bytes_of(T* p) noexcept {
+        if constexpr (std::is_same<std::remove_cv_t<T>, std::byte>::value) return p;
+        else return reinterpret_cast<const std::byte*>(p);
+    }
+};
+
+// ------------------------------------------------------------------
+// Reader that never throws. The first error (underflow, malformed
+// varint, decode limit, ...) is kept in error() and exhausts the
+// reader: every later read returns zeros / empty values without
+// touching memory, so a whole record is decoded and checked once.
+//
+//   bytestream::NothrowReader r(buf, n);
+//   auto id  = r.read_le<std::uint32_t>();
+//   auto sym = r.view_sized_string_le();
+//   if (!r) return r.error();
+// ------------------------------------------------------------------
+class NothrowReader : public detail::reader_base<NothrowReader> {
+    const std::byte* data_;
+    std::size_t      size_;
+    std::size_t      pos_;
+    errc             error_ = errc::ok;
+public:
+    static constexpr bool sticky_errors = true;
+
+    NothrowReader(const void* data, std::size_t size) noexcept
+        : data_(static_cast<const std::byte*>(data)), size_(size), pos_(0) {}
+
+    template <class T>
+    explicit NothrowReader(span<T> s) noexcept
+        : data_(reinterpret_cast<const std::byte*>(s.data())), size_(s.size()*sizeof(T)), pos_(0) {}
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return pos_; }
+    std::size_t remaining() const noexcept { return size_ - pos_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool exhausted() const noexcept { return pos_ >= size_; }
+    const std::byte* data() const noexcept { return data_; }
+    span<const std::byte> peek_contiguous() const noexcept { return { data_ + pos_, size_ - pos_ }; }
+
+    bool ok() const noexcept { return error_ == errc::ok; }
+    errc error() const noexcept { return error_; }
+    explicit operator bool() const noexcept { return ok(); }
+
+    // Record e (the first error wins) and stop reading
+    void fail(errc e) noexcept {
+        if (error_ == errc::ok) error_ = e;
+        pos_ = size_;
+    }
+
+    // n bytes at the cursor, or nullptr (and error() set) when short
+    const std::byte* take(std::size_t n) noexcept {
+        if (n > (size_ - pos_)) {
+            BYTESTREAM_COUNT(underflow, n);
+            fail(errc::underflow);
+            return nullptr;
+        }
+        const std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    void seek(std::size_t p) noexcept {
+        if (p > size_) return fail(errc::out_of_range);
+        if (ok()) pos_ = p;
+    }
 };
 
 } // namespace bytestream
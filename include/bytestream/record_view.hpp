@@ -0,0 +1,268 @@
+#ifndef BYTESTREAM_RECORD_VIEW_HPP
+#define BYTESTREAM_RECORD_VIEW_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/counting_writer.hpp>
+#include <bytestream/serialization.hpp>
+#include <array>
+#include <limits>
+#include <string_view>
+
+// ------------------------------------------------------------------
+// Lazy field access for schema records.
+//
+//   bytestream::RecordView<Trade> t(container.record(i));    // nothing decoded yet
+//   if (t.get<&Trade::qty>() > 1000)                         // one load
+//       hits.push_back(t.get<&Trade::venue, std::string_view>()); // no allocation
+//
+// A field is decoded only when get() asks for it. Fixed fields before
+// the first variable-length one sit at compile-time offsets. Later
+// fields are found by skipping over the variable ones (length prefixes
+// only: strings and memcpy vectors are not touched), and every offset
+// found is cached in the view.
+//
+// write_indexed() encodes the normal schema bytes followed by an offset
+// table: one u32 LE per variable-length field (the offset just past
+// it, from the record start). A view opened with record_index::trailer
+// locates any field in O(1) from that table. Plain read_field of the
+// schema bytes still works; the table is simply trailing data.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+enum class record_index { none, trailer };
+
+namespace detail {
+
+template <length_prefix P, typename T, typename R>
+void skip_field(R& r);
+
+template <typename S, length_prefix P, typename R, std::size_t... Is>
+void skip_schema(R& r, std::index_sequence<Is...>) {
+    (skip_field<P, typename schema_field_t<S, Is>::member_type>(r), ...);
+}
+
+// Step over one encoded T without building it where the wire format allows
+template <length_prefix P, typename T, typename R>
+void skip_field(R& r) {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        r.skip(read_length<P>(r));
+    } else if constexpr (is_span<T>::value) {
+        using E = std::remove_const_t<typename T::element_type>;
+        const std::size_t n = read_length<P>(r);
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(E))
+            return source_error(r, errc::underflow, "bytestream::Reader underflow");
+        r.skip(n * sizeof(E));
+    } else if constexpr (has_deserialize_static<T, R>::value) {
+        (void)read_field<T, P>(r); // opaque format: decode and drop
+    } else if constexpr (has_tagged_schema<T>::value) {
+        r.skip(r.read_varint_length());
+    } else if constexpr (has_schema<T>::value) {
+        using S = typename schema_of<T>::type;
+        if constexpr (S::all_fixed) r.skip(S::fixed_size);
+        else skip_schema<S, P>(r, std::make_index_sequence<S::field_count>{});
+    } else if constexpr (is_native_value_v<T>) {
+        r.skip(sizeof(T));
+    } else if constexpr (is_std_vector<T>::value) {
+        using E = typename T::value_type;
+        const std::size_t n = read_length<P>(r);
+        if constexpr (is_memcpy_element<E>::value) {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(E))
+            return source_error(r, errc::underflow, "bytestream::Reader underflow");
+            r.skip(n * sizeof(E));
+        } else {
+            for (std::size_t i = 0; i < n && source_ok(r); ++i) skip_field<P, E>(r);
+        }
+    } else if constexpr (is_std_array<T>::value) {
+        if constexpr (is_memcpy_element<typename T::value_type>::value) r.skip(sizeof(T));
+        else for (std::size_t i = 0; i < std::tuple_size<T>::value; ++i) skip_field<P, typename T::value_type>(r);
+    } else {
+        (void)read_field<T, P>(r);
+    }
+}
+
+// Number of variable-length fields before field I
+template <typename S, std::size_t I>
+constexpr std::size_t variable_fields_before() noexcept {
+    if constexpr (I == 0) return 0;
+    else return variable_fields_before<S, I - 1>() + (schema_field_t<S, I - 1>::fixed ? 0 : 1);
+}
+
+// Bytes of fixed fields between the last variable field before I and I
+template <typename S, std::size_t I>
+constexpr std::size_t fixed_bytes_before() noexcept {
+    if constexpr (I == 0) return 0;
+    else if constexpr (!schema_field_t<S, I - 1>::fixed) return 0;
+    else return fixed_bytes_before<S, I - 1>() + schema_field_t<S, I - 1>::size;
+}
+
+template <typename S, std::size_t I, length_prefix P, typename W, typename C, std::size_t N>
+void write_indexed_from(W& w, const C& obj, std::size_t base, std::array<std::uint32_t, N>& ends, std::size_t k) {
+    if constexpr (I < S::field_count) {
+        using F = schema_field_t<S, I>;
+        F::template write<P>(w, obj);
+        if constexpr (!F::fixed) {
+            const std::size_t end = w.position() - base;
+            if (end > std::numeric_limits<std::uint32_t>::max())
+                BYTESTREAM_THROW(OverflowException("bytestream::write_indexed: record larger than 4 GiB"));
+            ends[k++] = static_cast<std::uint32_t>(end);
+        }
+        write_indexed_from<S, I + 1, P>(w, obj, base, ends, k);
+    }
+}
+
+} // namespace detail
+
+// Schema bytes of v followed by its offset table
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_indexed(W& w, const T& v) {
+    using S = typename schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "write_indexed: schema describes another type");
+    constexpr std::size_t vars = detail::variable_fields_before<S, S::field_count>();
+    std::array<std::uint32_t, vars> ends{};
+    detail::write_indexed_from<S, 0, P>(w, v, w.position(), ends, 0);
+    for (std::uint32_t e : ends) w.template write_le<std::uint32_t>(e);
+}
+
+// write_indexed behind a length prefix (read back with read_view)
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_indexed_field(W& w, const T& v) {
+    CountingWriter size;
+    write_indexed<P>(size, v);
+    detail::write_length<P>(w, size.size());
+    write_indexed<P>(w, v);
+}
+
+// ------------------------------------------------------------------
+// View over one encoded record (the bytes of a Reader/subview)
+// ------------------------------------------------------------------
+template <typename T, length_prefix P = length_prefix::u32_le>
+class RecordView {
+    using S = typename schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "RecordView: schema describes another type");
+    static constexpr std::size_t vars = detail::variable_fields_before<S, S::field_count>();
+
+    const std::byte* data_ = nullptr;
+    std::size_t      size_ = 0; // schema bytes (without the table)
+    // end offset of each variable field, filled lazily (table mode: all at once)
+    mutable std::array<std::size_t, vars> ends_{};
+    mutable std::size_t                   known_ = 0;
+public:
+    using value_type = T;
+
+    RecordView() noexcept = default;
+
+    RecordView(const void* data, std::size_t size, record_index index = record_index::none)
+        : data_(static_cast<const std::byte*>(data)), size_(size) {
+        if (index == record_index::trailer) load_table();
+    }
+    explicit RecordView(const Reader& r, record_index index = record_index::none)
+        : RecordView(r.data() + r.position(), r.remaining(), index) {}
+
+    // size of the schema encoding (excludes a trailing offset table)
+    std::size_t size() const noexcept { return size_; }
+    const std::byte* data() const noexcept { return data_; }
+
+    // Decode one member; As may be a view type (std::string_view, span<const E>)
+    template <auto Member, typename As = typename detail::member_pointer_traits<decltype(Member)>::member_type>
+    As get() const {
+        constexpr std::size_t I = detail::schema_field_index<S, Member>();
+        using F = detail::schema_field_t<S, I>;
+        const std::size_t off = field_offset<I>();
+        if constexpr (F::fixed) {
+            if (F::size > size_ - off) BYTESTREAM_THROW(UnderflowException("bytestream::RecordView underflow"));
+            typename F::member_type v;
+            F::load_value(data_ + off, v);
+            return As(v);
+        } else {
+            Reader r(data_ + off, size_ - off);
+            return read_field<As, P>(r);
+        }
+    }
+
+    // Byte offset of a member inside the record
+    template <auto Member>
+    std::size_t offset_of() const { return field_offset<detail::schema_field_index<S, Member>()>(); }
+
+    // Everything (same as read_field<T>)
+    T decode() const {
+        Reader r(data_, size_);
+        return read_field<T, P>(r);
+    }
+
+private:
+    // Offset of field I; a record that ends before it underflows
+    template <std::size_t I>
+    std::size_t field_offset() const {
+        constexpr std::size_t k = detail::variable_fields_before<S, I>();
+        std::size_t off = detail::fixed_bytes_before<S, I>();
+        if constexpr (k != 0) {
+            if (known_ < k) resolve<0>(k);
+            off += ends_[k - 1];
+        }
+        if (off > size_) BYTESTREAM_THROW(UnderflowException("bytestream::RecordView underflow"));
+        return off;
+    }
+
+    // Walk variable fields [known_, want) and record where each ends
+    template <std::size_t I>
+    void resolve(std::size_t want) const {
+        if constexpr (I < S::field_count) {
+            using F = detail::schema_field_t<S, I>;
+            constexpr std::size_t k = detail::variable_fields_before<S, I>();
+            if constexpr (!F::fixed) {
+                if (k >= known_) {
+                    const std::size_t start = (k ? ends_[k - 1] : 0) + detail::fixed_bytes_before<S, I>();
+                    if (start > size_) BYTESTREAM_THROW(UnderflowException("bytestream::RecordView underflow"));
+                    Reader r(data_ + start, size_ - start);
+                    detail::skip_field<P, typename F::member_type>(r);
+                    ends_[k] = start + r.position();
+                    known_   = k + 1;
+                }
+                if (known_ >= want) return;
+            }
+            resolve<I + 1>(want);
+        }
+    }
+
+    void load_table() {
+        constexpr std::size_t table = vars * 4;
+        if (size_ < table) BYTESTREAM_THROW(FormatException("bytestream::RecordView: missing offset table"));
+        size_ -= table;
+        for (std::size_t k = 0; k < vars; ++k)
+            ends_[k] = load_le<std::uint32_t>(data_ + size_ + 4 * k);
+        check_table<0>();
+        known_ = vars;
+    }
+
+    // Every variable field starts (after the fixed fields in front of it)
+    // no later than the table says it ends; the fixed tail fits as well
+    template <std::size_t I>
+    void check_table() const {
+        if constexpr (I < S::field_count) {
+            if constexpr (!detail::schema_field_t<S, I>::fixed) {
+                constexpr std::size_t k = detail::variable_fields_before<S, I>();
+                const std::size_t start = (k ? ends_[k - 1] : 0) + detail::fixed_bytes_before<S, I>();
+                if (start > ends_[k] || ends_[k] > size_)
+                    BYTESTREAM_THROW(FormatException("bytestream::RecordView: bad offset table"));
+            }
+            check_table<I + 1>();
+        } else {
+            const std::size_t tail = (vars ? ends_[vars - 1] : 0) + detail::fixed_bytes_before<S, S::field_count>();
+            if (tail > size_) BYTESTREAM_THROW(FormatException("bytestream::RecordView: bad offset table"));
+        }
+    }
+};
+
+// Read a length prefix and return a view over that many bytes (r advances past them)
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+RecordView<T, P> read_view(R& r, record_index index = record_index::none) {
+    const std::size_t n = detail::read_length<P>(r);
+    const std::byte* p = r.take(n);
+    if (!detail::source_ok(r)) return {};
+    return RecordView<T, P>(p, n, index);
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_RECORD_VIEW_HPP
@@ -0,0 +1,84 @@
+#ifndef BYTESTREAM_RESULT_HPP
+#define BYTESTREAM_RESULT_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <bytestream/serialization.hpp>
+#include <utility>
+
+// ------------------------------------------------------------------
+// Error codes instead of exceptions for one field at a time.
+//
+//   bytestream::Reader r(buf, n);
+//   auto q = bytestream::try_read_field<Quote>(r);   // r advances only on success
+//   if (!q) return q.error();                        // errc::underflow, errc::limit, ...
+//   use(*q);
+//
+//   if (bytestream::try_write_field(w, reply) != bytestream::errc::ok) ...
+//
+// Both decode through NothrowReader / NothrowWriter over the rest of
+// the buffer, so nothing on the way throws. For whole messages use
+// those directly: read every field, then test the reader once.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+// A value or the errc that prevented it (T must be default-constructible)
+template <typename T>
+class result {
+    T    value_{};
+    errc error_ = errc::ok;
+public:
+    result(T v) noexcept(std::is_nothrow_move_constructible<T>::value) : value_(std::move(v)) {}
+    result(errc e) noexcept(std::is_nothrow_default_constructible<T>::value) : error_(e) {}
+
+    bool ok() const noexcept { return error_ == errc::ok; }
+    errc error() const noexcept { return error_; }
+    explicit operator bool() const noexcept { return ok(); }
+
+    // The value; throws the matching exception when there is none
+    T& value() & {
+        if (!ok()) detail::throw_error(error_, errc_message(error_));
+        return value_;
+    }
+    const T& value() const& {
+        if (!ok()) detail::throw_error(error_, errc_message(error_));
+        return value_;
+    }
+    T&& value() && {
+        if (!ok()) detail::throw_error(error_, errc_message(error_));
+        return std::move(value_);
+    }
+    T value_or(T fallback) const& { return ok() ? value_ : std::move(fallback); }
+
+    // Unchecked access
+    T& operator*() & noexcept { return value_; }
+    const T& operator*() const& noexcept { return value_; }
+    T&& operator*() && noexcept { return std::move(value_); }
+    T* operator->() noexcept { return &value_; }
+    const T* operator->() const noexcept { return &value_; }
+};
+
+// read_field<T, P> from r's cursor; r advances only when it succeeds
+template <typename T, length_prefix P = length_prefix::u32_le>
+result<T> try_read_field(Reader& r) {
+    NothrowReader n(r.data() + r.position(), r.remaining());
+    n.set_budget(r.budget());
+    T v = read_field<T, P>(n);
+    if (!n) return n.error();
+    r.skip(n.position());
+    return v;
+}
+
+// write_field<P>(v) at w's cursor; w advances only when all of it fits
+template <length_prefix P = length_prefix::u32_le, typename T>
+errc try_write_field(Writer& w, const T& v) {
+    NothrowWriter n(w.claim(0), w.remaining());
+    write_field<P>(n, v);
+    if (n) w.claim(n.written_bytes());
+    return n.error();
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_RESULT_HPP
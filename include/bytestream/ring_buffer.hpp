@@ -0,0 +1,263 @@
+#ifndef BYTESTREAM_RING_BUFFER_HPP
+#define BYTESTREAM_RING_BUFFER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <bytestream/writer.hpp>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+// ------------------------------------------------------------------
+// Lock-free frame ring over a caller-provided region (heap, or shared
+// memory mapped by several processes).
+//
+//   auto ring = bytestream::RingBuffer<>::create(region, bytes);   // once
+//
+//   // producer thread
+//   if (auto f = ring.try_reserve(max_frame)) {
+//       write_field(f->writer, msg);      // encode in place
+//       ring.commit(*f);
+//   }
+//
+//   // consumer thread
+//   if (auto f = ring.try_acquire()) {
+//       auto msg = read_field<Msg>(f->reader);   // decode in place
+//       ring.release(*f);
+//   }
+//
+// ring_mode::spsc: one producer, one consumer. ring_mode::mpsc: any
+// number of producers; frames become visible in reservation order,
+// each once committed. Frames never wrap: a frame that does not fit
+// before the end of the buffer leaves a skip marker and starts at 0,
+// so writers and readers always see one contiguous range.
+//
+// RingBuffer is a small view (pointer + cached positions): give each
+// thread its own copy. Release a frame before acquiring the next; a
+// reserved frame that is never committed stalls the consumer (mpsc) or
+// is simply overwritten (spsc).
+//
+// Region layout: ring_header (cache-line aligned atomics), then the
+// data area (power-of-two capacity). Frames: 8-byte header (state word
+// + span), body padded to 8 bytes.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+enum class ring_mode : std::uint32_t { spsc = 1, mpsc = 2 };
+
+namespace detail {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+              std::atomic<std::uint32_t>::is_always_lock_free,
+              "RingBuffer needs lock-free 32/64-bit atomics (shared memory)");
+
+struct ring_header {
+    std::uint32_t magic;
+    std::uint32_t mode;
+    std::uint64_t capacity;
+    // spsc: committed end; mpsc: reserved end
+    alignas(64) std::atomic<std::uint64_t> write_pos;
+    alignas(64) std::atomic<std::uint64_t> read_pos;
+};
+
+struct ring_frame_header {
+    std::atomic<std::uint32_t> state; // 0: not committed
+    std::uint32_t              span;  // bytes this frame occupies (header + padded body)
+};
+
+inline constexpr std::uint32_t ring_magic      = 0x474E5242u; // "BRNG"
+inline constexpr std::uint32_t ring_committed  = 0x80000000u;
+inline constexpr std::uint32_t ring_skip       = 0x40000000u; // padding up to the end of the buffer
+inline constexpr std::uint32_t ring_length_mask = ring_skip - 1;
+inline constexpr std::size_t   ring_frame_overhead = sizeof(ring_frame_header);
+
+static_assert(sizeof(ring_frame_header) == 8, "ring frame header must be 8 bytes");
+
+constexpr std::size_t ring_span(std::size_t n) noexcept { return ring_frame_overhead + ((n + 7) & ~std::size_t{7}); }
+
+} // namespace detail
+
+// Space reserved by a producer; encode into `writer`, then commit()
+struct ring_reservation {
+    Writer        writer;
+    std::uint64_t pos;  // ring position of the frame header
+    std::uint64_t end;  // end of the reserved range
+};
+
+// A committed frame handed to the consumer; decode from `reader`, then release()
+struct ring_frame {
+    Reader        reader;
+    std::uint64_t pos;
+    std::uint64_t end;
+};
+
+template <ring_mode Mode = ring_mode::spsc>
+class RingBuffer {
+    detail::ring_header* hdr_  = nullptr;
+    std::byte*           data_ = nullptr;
+    std::uint64_t        mask_ = 0;
+    std::uint64_t        cached_read_  = 0; // producer side
+    std::uint64_t        cached_write_ = 0; // consumer side (spsc)
+public:
+    static constexpr std::size_t header_size = (sizeof(detail::ring_header) + 63) & ~std::size_t{63};
+
+    RingBuffer() noexcept = default;
+
+    // Initialize a ring in [region, region + bytes); region must be
+    // 64-byte aligned. Capacity is the largest power of two that fits.
+    static RingBuffer create(void* region, std::size_t bytes) {
+        if (reinterpret_cast<std::uintptr_t>(region) % 64 != 0)
+            BYTESTREAM_THROW(std::invalid_argument("bytestream::RingBuffer region must be 64-byte aligned"));
+        if (bytes < header_size + 64) BYTESTREAM_THROW(std::invalid_argument("bytestream::RingBuffer region too small"));
+        std::uint64_t cap = 64;
+        while (cap * 2 <= bytes - header_size && cap * 2 <= (std::uint64_t{1} << 31)) cap *= 2;
+
+        auto* h = new (region) detail::ring_header{};
+        h->magic    = detail::ring_magic;
+        h->mode     = static_cast<std::uint32_t>(Mode);
+        h->capacity = cap;
+        h->write_pos.store(0, std::memory_order_relaxed);
+        auto* data = static_cast<std::byte*>(region) + header_size;
+        std::memset(data, 0, std::size_t(cap)); // mpsc relies on zeroed frame headers
+        h->read_pos.store(0, std::memory_order_release);
+        return RingBuffer(h);
+    }
+
+    // View of a ring created elsewhere (e.g. by another process)
+    static RingBuffer attach(void* region, std::size_t bytes) {
+        if (bytes < header_size) BYTESTREAM_THROW(std::invalid_argument("bytestream::RingBuffer region too small"));
+        auto* h = std::launder(static_cast<detail::ring_header*>(region));
+        if (h->magic != detail::ring_magic || h->mode != static_cast<std::uint32_t>(Mode) ||
+            h->capacity > bytes - header_size)
+            BYTESTREAM_THROW(FormatException("bytestream::RingBuffer attach: not a ring of this mode"));
+        return RingBuffer(h);
+    }
+
+    std::size_t capacity() const noexcept { return std::size_t(mask_ + 1); }
+    // largest body a single frame can carry
+    std::size_t max_frame_size() const noexcept { return capacity() / 2 - detail::ring_frame_overhead; }
+
+    // bytes in flight (reserved/committed and not yet released); approximate under concurrency
+    std::size_t used() const noexcept {
+        return std::size_t(hdr_->write_pos.load(std::memory_order_acquire) -
+                           hdr_->read_pos.load(std::memory_order_acquire));
+    }
+
+    // ---- producer
+    std::optional<ring_reservation> try_reserve(std::size_t max_n) {
+        if (max_n > max_frame_size()) BYTESTREAM_THROW(OverflowException("bytestream::RingBuffer frame too large"));
+        const std::uint64_t span = detail::ring_span(max_n);
+        std::uint64_t w = hdr_->write_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::uint64_t off = w & mask_;
+            const std::uint64_t to_end = capacity() - off;
+            const std::uint64_t pad = to_end < span ? to_end : 0;
+            const std::uint64_t end = w + pad + span;
+            if (end - cached_read_ > capacity()) {
+                cached_read_ = hdr_->read_pos.load(std::memory_order_acquire);
+                if (cached_read_ > w) { // w went stale while other producers moved on
+                    w = hdr_->write_pos.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (end - cached_read_ > capacity()) return std::nullopt;
+            }
+            if constexpr (Mode == ring_mode::mpsc) {
+                if (!hdr_->write_pos.compare_exchange_weak(w, end, std::memory_order_relaxed,
+                                                           std::memory_order_relaxed))
+                    continue;
+            }
+            if (pad) mark_skip(off, pad);
+            const std::uint64_t pos = w + pad;
+            std::byte* body = data_ + (pos & mask_) + detail::ring_frame_overhead;
+            return ring_reservation{ Writer(body, max_n), pos, end };
+        }
+    }
+
+    // Spin (yielding) until space is available
+    ring_reservation reserve(std::size_t max_n) {
+        for (;;) {
+            if (auto r = try_reserve(max_n)) return std::move(*r);
+            std::this_thread::yield();
+        }
+    }
+
+    // Publish the bytes written through res.writer
+    void commit(ring_reservation& res) noexcept {
+        auto* fh = frame_at(res.pos);
+        const std::size_t len = res.writer.position();
+        if constexpr (Mode == ring_mode::spsc) {
+            // shrink to what was written; the rest of the reservation is free again
+            fh->span = std::uint32_t(detail::ring_span(len));
+            fh->state.store(detail::ring_committed | std::uint32_t(len), std::memory_order_relaxed);
+            hdr_->write_pos.store(res.pos + fh->span, std::memory_order_release);
+        } else {
+            // the range is shared with later reservations: keep the full span
+            fh->span = std::uint32_t(res.end - res.pos);
+            fh->state.store(detail::ring_committed | std::uint32_t(len), std::memory_order_release);
+        }
+    }
+
+    // ---- consumer
+    std::optional<ring_frame> try_acquire() noexcept {
+        for (;;) {
+            const std::uint64_t r = hdr_->read_pos.load(std::memory_order_relaxed);
+            if constexpr (Mode == ring_mode::spsc) {
+                if (r == cached_write_) {
+                    cached_write_ = hdr_->write_pos.load(std::memory_order_acquire);
+                    if (r == cached_write_) return std::nullopt;
+                }
+            }
+            auto* fh = frame_at(r);
+            const std::uint32_t state = fh->state.load(std::memory_order_acquire);
+            if (!(state & detail::ring_committed)) return std::nullopt;
+            const std::uint64_t end = r + fh->span;
+            if (state & detail::ring_skip) {
+                retire(r, end);
+                continue;
+            }
+            const std::byte* body = reinterpret_cast<const std::byte*>(fh) + detail::ring_frame_overhead;
+            return ring_frame{ Reader(body, state & detail::ring_length_mask), r, end };
+        }
+    }
+
+    ring_frame acquire() {
+        for (;;) {
+            if (auto f = try_acquire()) return std::move(*f);
+            std::this_thread::yield();
+        }
+    }
+
+    // Hand the frame's space back to the producers
+    void release(const ring_frame& f) noexcept { retire(f.pos, f.end); }
+
+private:
+    explicit RingBuffer(detail::ring_header* h) noexcept
+        : hdr_(h), data_(reinterpret_cast<std::byte*>(h) + header_size), mask_(h->capacity - 1) {}
+
+    detail::ring_frame_header* frame_at(std::uint64_t pos) const noexcept {
+        return std::launder(reinterpret_cast<detail::ring_frame_header*>(data_ + (pos & mask_)));
+    }
+
+    void mark_skip(std::uint64_t off, std::uint64_t pad) noexcept {
+        auto* fh = reinterpret_cast<detail::ring_frame_header*>(data_ + off);
+        fh->span = std::uint32_t(pad);
+        fh->state.store(detail::ring_committed | detail::ring_skip,
+                        Mode == ring_mode::spsc ? std::memory_order_relaxed : std::memory_order_release);
+    }
+
+    void retire(std::uint64_t pos, std::uint64_t end) noexcept {
+        if constexpr (Mode == ring_mode::mpsc) {
+            // frame headers may land anywhere in this range next lap: clear it
+            frame_at(pos)->state.store(0, std::memory_order_relaxed);
+            std::memset(data_ + (pos & mask_) + 4, 0, std::size_t(end - pos) - 4);
+        }
+        hdr_->read_pos.store(end, std::memory_order_release);
+    }
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_RING_BUFFER_HPP
@@ -0,0 +1,242 @@
+#ifndef BYTESTREAM_SCHEMA_HPP
+#define BYTESTREAM_SCHEMA_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/serialization.hpp>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+// ------------------------------------------------------------------
+// Compile-time field lists.
+//
+//   struct Trade {
+//       std::uint64_t id;
+//       double        px;
+//       std::string   venue;
+//       using bytestream_schema = bytestream::schema<
+//           bytestream::field_le<&Trade::id>,
+//           bytestream::field_le<&Trade::px>,
+//           bytestream::field<&Trade::venue>>;
+//   };
+//
+// (or specialize bytestream::schema_of<Trade> with `using type = ...`
+// to keep the type untouched). write_field/read_field then encode the
+// fields in order. field_le/field_be are fixed-width arithmetic or
+// enum fields in that byte order; field<> uses the write_field wire
+// format of the member (native layout for trivially-copyable types).
+//
+// Adjacent fixed-size fields form runs that are encoded with one
+// claim()/take() and direct stores, i.e. one bounds check per run.
+// Sinks without claim() (CountingWriter) are written field by field.
+// ------------------------------------------------------------------
+namespace bytestream {
+
+namespace detail {
+
+template <typename>
+struct member_pointer_traits;
+template <typename C, typename M>
+struct member_pointer_traits<M C::*> {
+    using class_type  = C;
+    using member_type = M;
+};
+
+template <typename T, typename = void>
+struct wire_integer { using type = T; };
+template <typename T>
+struct wire_integer<T, std::enable_if_t<std::is_enum<T>::value>> { using type = std::underlying_type_t<T>; };
+
+// Order == endian::native with Raw: memcpy of the member (field<>)
+template <auto Member, endian Order, bool Raw>
+struct field_desc {
+    using traits      = member_pointer_traits<decltype(Member)>;
+    using class_type  = typename traits::class_type;
+    using member_type = typename traits::member_type;
+    using wire_type   = typename wire_integer<member_type>::type;
+
+    static_assert(Raw || is_arithmetic<wire_type>::value,
+                  "field_le/field_be: member must be arithmetic or an enum");
+
+    static constexpr bool fixed = Raw ? is_native_value_v<member_type>
+                                      : true;
+    static constexpr std::size_t size = fixed ? sizeof(member_type) : 0;
+
+    static constexpr auto member = Member;
+
+    // one value <-> its wire bytes (fixed fields only)
+    static void store_value(std::byte* p, const member_type& v) noexcept {
+        if constexpr (Raw || Order == endian::native) {
+            std::memcpy(p, &v, sizeof(member_type));
+        } else {
+            wire_type w;
+            std::memcpy(&w, &v, sizeof(w));
+            w = byteswap(w);
+            std::memcpy(p, &w, sizeof(w));
+        }
+    }
+    static void load_value(const std::byte* p, member_type& v) noexcept {
+        if constexpr (Raw || Order == endian::native) {
+            std::memcpy(&v, p, sizeof(member_type));
+        } else {
+            wire_type w;
+            std::memcpy(&w, p, sizeof(w));
+            w = byteswap(w);
+            std::memcpy(&v, &w, sizeof(w));
+        }
+    }
+
+    static void store(std::byte* p, const class_type& obj) noexcept { store_value(p, obj.*Member); }
+    static void load(const std::byte* p, class_type& obj) noexcept { load_value(p, obj.*Member); }
+
+    template <length_prefix P, typename W>
+    static void write(W& w, const class_type& obj) {
+        if constexpr (fixed) {
+            std::byte buf[sizeof(member_type)];
+            store(buf, obj);
+            w.write_bytes(buf, sizeof(buf));
+        } else {
+            write_field<P>(w, obj.*Member);
+        }
+    }
+    template <length_prefix P, typename R>
+    static void read(R& r, class_type& obj) {
+        if constexpr (fixed) {
+            load(take_fixed<size>(r), obj);
+        } else {
+            read_field_into<P>(r, obj.*Member);
+        }
+    }
+};
+
+} // namespace detail
+
+template <auto Member>
+using field = detail::field_desc<Member, endian::native, true>;
+template <auto Member>
+using field_le = detail::field_desc<Member, endian::little, false>;
+template <auto Member>
+using field_be = detail::field_desc<Member, endian::big, false>;
+
+template <typename... Fields>
+struct schema {
+    static_assert(sizeof...(Fields) > 0, "schema: at least one field");
+    using fields     = std::tuple<Fields...>;
+    using class_type = typename std::tuple_element_t<0, fields>::class_type;
+    static_assert((std::is_same<typename Fields::class_type, class_type>::value && ...),
+                  "schema: all fields must belong to the same class");
+
+    static constexpr std::size_t field_count = sizeof...(Fields);
+    static constexpr bool        all_fixed   = (Fields::fixed && ...);
+    // wire size when every field is fixed, 0 otherwise
+    static constexpr std::size_t fixed_size  = all_fixed ? (Fields::size + ...) : 0;
+};
+
+namespace detail {
+
+template <typename S, std::size_t I>
+using schema_field_t = std::tuple_element_t<I, typename S::fields>;
+
+// End of the run of fixed fields starting at I
+template <typename S, std::size_t I>
+constexpr std::size_t fixed_run_end() noexcept {
+    if constexpr (I < S::field_count) {
+        if constexpr (schema_field_t<S, I>::fixed) return fixed_run_end<S, I + 1>();
+        else return I;
+    } else {
+        return I;
+    }
+}
+
+// Index of the field describing Member
+template <typename S, auto Member, std::size_t I = 0>
+constexpr std::size_t schema_field_index() noexcept {
+    static_assert(I < S::field_count, "schema: member is not part of the schema");
+    using F = schema_field_t<S, I>;
+    if constexpr (std::is_same<std::remove_cv_t<decltype(F::member)>, decltype(Member)>::value) {
+        if constexpr (F::member == Member) return I;
+        else return schema_field_index<S, Member, I + 1>();
+    } else {
+        return schema_field_index<S, Member, I + 1>();
+    }
+}
+
+template <typename S, std::size_t Begin, std::size_t... Is>
+constexpr std::size_t fixed_run_size(std::index_sequence<Is...>) noexcept {
+    return (std::size_t{0} + ... + schema_field_t<S, Begin + Is>::size);
+}
+
+template <typename S, std::size_t Begin, typename C, std::size_t... Is>
+void store_run(std::byte* p, const C& obj, std::index_sequence<Is...>) noexcept {
+    std::size_t off = 0;
+    ((schema_field_t<S, Begin + Is>::store(p + off, obj), off += schema_field_t<S, Begin + Is>::size), ...);
+}
+
+template <typename S, std::size_t Begin, typename C, std::size_t... Is>
+void load_run(const std::byte* p, C& obj, std::index_sequence<Is...>) noexcept {
+    std::size_t off = 0;
+    ((schema_field_t<S, Begin + Is>::load(p + off, obj), off += schema_field_t<S, Begin + Is>::size), ...);
+}
+
+template <typename S, std::size_t I, length_prefix P, typename W, typename C>
+void write_schema_from(W& w, const C& obj) {
+    if constexpr (I < S::field_count) {
+        constexpr std::size_t end = fixed_run_end<S, I>();
+        if constexpr (end > I && has_claim<W>::value) {
+            using run = std::make_index_sequence<end - I>;
+            std::byte* p = w.claim(fixed_run_size<S, I>(run{}));
+            if constexpr (sticky_errors<W>::value) {
+                if (!p) return;
+            }
+            store_run<S, I>(p, obj, run{});
+            write_schema_from<S, end, P>(w, obj);
+        } else {
+            schema_field_t<S, I>::template write<P>(w, obj);
+            write_schema_from<S, I + 1, P>(w, obj);
+        }
+    }
+}
+
+template <typename S, std::size_t I, length_prefix P, typename R, typename C>
+void read_schema_from(R& r, C& obj) {
+    if constexpr (I < S::field_count) {
+        constexpr std::size_t end = fixed_run_end<S, I>();
+        if constexpr (end > I) {
+            using run = std::make_index_sequence<end - I>;
+            load_run<S, I>(take_fixed<fixed_run_size<S, I>(run{})>(r), obj, run{});
+            read_schema_from<S, end, P>(r, obj);
+        } else {
+            schema_field_t<S, I>::template read<P>(r, obj);
+            read_schema_from<S, I + 1, P>(r, obj);
+        }
+    }
+}
+
+} // namespace detail
+
+// Encode/decode v through its schema (write_field/read_field call these)
+template <length_prefix P, typename W, typename T>
+void write_schema(W& w, const T& v) {
+    using S = typename schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "write_schema: schema describes another type");
+    detail::write_schema_from<S, 0, P>(w, v);
+}
+
+template <typename T, length_prefix P, typename R>
+T read_schema(R& r) {
+    T v{};
+    read_schema_into<P>(r, v);
+    return v;
+}
+
+// Decode over an existing object (members keep their capacity)
+template <length_prefix P, typename R, typename T>
+void read_schema_into(R& r, T& v) {
+    using S = typename schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "read_schema: schema describes another type");
+    detail::read_schema_from<S, 0, P>(r, v);
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_SCHEMA_HPP
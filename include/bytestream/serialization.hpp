@@ -4,9 +4,12 @@
 #include <bytestream/config.hpp>
 #include <bytestream/reader.hpp>
 #include <bytestream/writer.hpp>
+#include <bytestream/counting_writer.hpp>
 #include <type_traits>
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <memory>
 #include <string>
 
 namespace bytestream {
@@ -14,138 +17,629 @@ namespace bytestream {
 // ------------------------------------------------------------------
 // CRTP base (first so traits can see it)
 // ------------------------------------------------------------------
+// serialize()/deserialize() forward whatever sink/source they get; declare
+// `template <class W> void serialize_impl(W&) const` and
+// `template <class R> void deserialize_impl(R&)` to accept any of them
+// (DynamicWriter, CountingWriter, UncheckedReader, ...), or take
+// Writer&/Reader& only.
 template <typename Derived>
 struct Serializable {
-    void serialize(Writer& w) const {
+    template <typename W, typename D = Derived>
+    auto serialize(W& w) const -> decltype(std::declval<const D&>().serialize_impl(w)) {
         static_cast<const Derived*>(this)->serialize_impl(w);
     }
     void deserialize_impl(Reader&); // defined by Derived
-    static Derived deserialize(Reader& r) {
+    template <typename R, typename D = Derived>
+    static auto deserialize(R& r) -> decltype(std::declval<D&>().deserialize_impl(r), D{}) {
         Derived d{};
         d.deserialize_impl(r);
         return d;
     }
 };
 
+// ------------------------------------------------------------------
+// Field-list customization point (schema.hpp): a nested
+// `using bytestream_schema = schema<...>`, or a specialization
+// providing `using type = schema<...>`
+// ------------------------------------------------------------------
+template <typename T, typename = void>
+struct schema_of {};
+template <typename T>
+struct schema_of<T, std::void_t<typename T::bytestream_schema>> { using type = typename T::bytestream_schema; };
+
+// Same for tagged records (tagged.hpp): `using bytestream_tagged = tagged_schema<...>`
+template <typename T, typename = void>
+struct tagged_schema_of {};
+template <typename T>
+struct tagged_schema_of<T, std::void_t<typename T::bytestream_tagged>> { using type = typename T::bytestream_tagged; };
+
 // ------------------------------------------------------------------
 // Traits (detail) — CRTP-aware
 // ------------------------------------------------------------------
 namespace detail {
 
-template <typename T, typename = void>
+template <typename T, typename W = Writer, typename = void>
 struct has_serialize_method : std::false_type {};
-template <typename T>
-struct has_serialize_method<T, std::void_t<decltype(std::declval<const T&>().serialize(std::declval<Writer&>()))>> : std::true_type {};
+template <typename T, typename W>
+struct has_serialize_method<T, W, std::void_t<decltype(std::declval<const T&>().serialize(std::declval<W&>()))>> : std::true_type {};
 
-template <typename T, typename = void>
+template <typename T, typename R = Reader, typename = void>
 struct has_deserialize_static : std::false_type {};
-template <typename T>
-struct has_deserialize_static<T, std::void_t<decltype(T::deserialize(std::declval<Reader&>()))>> : std::true_type {};
+template <typename T, typename R>
+struct has_deserialize_static<T, R, std::void_t<decltype(T::deserialize(std::declval<R&>()))>> : std::true_type {};
+
+// deserialize_impl(R&) callable on an existing object (in-place decode)
+template <typename T, typename R = Reader, typename = void>
+struct has_deserialize_impl : std::false_type {};
+template <typename T, typename R>
+struct has_deserialize_impl<T, R, std::void_t<decltype(std::declval<T&>().deserialize_impl(std::declval<R&>()))>> : std::true_type {};
 
 template <typename T>
 struct is_trivially_serializable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+// views are trivially copyable but serialize what they point at
+template <>
+struct is_trivially_serializable<std::string_view> : std::false_type {};
+template <typename T>
+struct is_trivially_serializable<span<T>> : std::false_type {};
 template <typename T>
 inline constexpr bool is_trivially_serializable_v = is_trivially_serializable<T>::value;
 
 template <typename T>
 struct is_crtp_serializable : std::is_base_of<Serializable<T>, T> {};
 
+template <typename T, typename = void>
+struct has_schema : std::false_type {};
+template <typename T>
+struct has_schema<T, std::void_t<typename schema_of<T>::type>> : std::true_type {};
+
+template <typename T, typename = void>
+struct has_tagged_schema : std::false_type {};
+template <typename T>
+struct has_tagged_schema<T, std::void_t<typename tagged_schema_of<T>::type>> : std::true_type {};
+
 template <typename T>
 struct is_serializable : std::integral_constant<bool,
-    has_serialize_method<T>::value || has_deserialize_static<T>::value || is_crtp_serializable<T>::value> {};
+    has_serialize_method<T>::value || has_deserialize_static<T>::value || is_crtp_serializable<T>::value ||
+    has_schema<T>::value || has_tagged_schema<T>::value> {};
 template <typename T>
 inline constexpr bool is_serializable_v = is_serializable<T>::value;
 
+// values whose wire format is their native bytes: trivially copyable,
+// no serializer of their own, and (for std::array) elements of the same
+// kind, so an array of schema types is encoded element by element
+template <typename T>
+struct is_native_value : std::integral_constant<bool, is_trivially_serializable_v<T> && !is_serializable_v<T>> {};
+template <typename T, std::size_t N>
+struct is_native_value<std::array<T, N>> : is_native_value<T> {};
+template <typename T>
+inline constexpr bool is_native_value_v = is_native_value<T>::value;
+
+template <typename T>
+struct is_span : std::false_type {};
+template <typename T>
+struct is_span<span<T>> : std::true_type {};
+
+template <typename T>
+struct is_std_vector : std::false_type {};
+template <typename T, typename A>
+struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+struct is_std_array : std::false_type {};
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+// elements whose wire format is their native bytes, so a whole
+// contiguous container can move with one memcpy
+template <typename T>
+struct is_memcpy_element : std::integral_constant<bool,
+    is_native_value_v<T> && !std::is_same<T, bool>::value> {};
+
 // helper for static_assert fallthrough
 template <class> struct dependent_false : std::false_type {};
 
 } // namespace detail
 
+// ------------------------------------------------------------------
+// Length prefix used for strings, views and vectors
+// ------------------------------------------------------------------
+enum class length_prefix {
+    u32_le, // fixed 4-byte little-endian count (default)
+    varint  // LEB128 count
+};
+
+namespace detail {
+
+template <length_prefix P, typename W>
+void write_length(W& w, std::size_t n) {
+    if constexpr (P == length_prefix::varint) w.template write_varint<std::uint64_t>(n);
+    else w.template write_le<std::uint32_t>(static_cast<std::uint32_t>(n));
+}
+
+template <length_prefix P, typename R>
+std::size_t read_length(R& r) {
+    if constexpr (P == length_prefix::varint) return r.read_varint_length();
+    else return r.template read_le<std::uint32_t>();
+}
+
+// the source's DecodeBudget, if it has one
+template <typename R, typename = void>
+struct has_budget : std::false_type {};
+template <typename R>
+struct has_budget<R, std::void_t<decltype(std::declval<const R&>().budget())>> : std::true_type {};
+
+template <typename R>
+DecodeBudget* budget_of(const R& r) noexcept {
+    if constexpr (has_budget<R>::value) return r.budget();
+    else return nullptr;
+}
+
+// Error plumbing shared with sticky sources (NothrowReader): they record
+// the error and keep going on zeros; every other source throws
+template <typename R>
+bool source_ok(const R& r) noexcept {
+    if constexpr (sticky_errors<R>::value) return r.ok();
+    else return true;
+}
+
+template <typename R>
+void source_error(R& r, errc e, const char* what) {
+    if constexpr (sticky_errors<R>::value) r.fail(e);
+    else throw_error(e, what);
+}
+
+// r.take(N) for a fixed-size load
+template <std::size_t N, typename R>
+const std::byte* take_fixed(R& r) {
+    const std::byte* p = r.take(N);
+    if constexpr (sticky_errors<R>::value) {
+        if (!p) return zero_bytes<N>;
+    }
+    return p;
+}
+
+// Budget checks before allocating n elements of `size` bytes
+template <typename R>
+bool budget_collection(R& r, std::size_t n, std::size_t size) {
+    DecodeBudget* b = budget_of(r);
+    if (!b) return true;
+    if constexpr (sticky_errors<R>::value) {
+        if (b->allows_collection(n) && b->try_charge(n, size)) return true;
+        r.fail(errc::limit);
+        return false;
+    } else {
+        b->check_collection(n);
+        b->charge(n, size);
+        return true;
+    }
+}
+
+// One nesting level of r's budget for the lifetime of the scope
+template <typename R>
+class nested_scope {
+    DecodeBudget* b_;
+public:
+    explicit nested_scope(R& r) : b_(budget_of(r)) {
+        if (!b_) return;
+        if constexpr (sticky_errors<R>::value) {
+            if (!b_->try_enter()) {
+                r.fail(errc::limit);
+                b_ = nullptr;
+            }
+        } else {
+            b_->enter();
+        }
+    }
+    ~nested_scope() { if (b_) b_->leave(); }
+    nested_scope(const nested_scope&) = delete;
+    nested_scope& operator=(const nested_scope&) = delete;
+};
+
+} // namespace detail
+
+// defined in schema.hpp
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_schema(W& w, const T& v);
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+T read_schema(R& r);
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void read_schema_into(R& r, T& v);
+
+// defined in tagged.hpp
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_tagged(W& w, const T& v);
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_tagged_body(W& w, const T& v);
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+T read_tagged(R& r);
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void read_tagged_into(R& r, T& v);
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void read_tagged_body(R& r, T& v);
+
 // ------------------------------------------------------------------
 // Single-dispatch write_field (no overload ambiguity)
+// W is any writer-like sink: Writer, DynamicWriter, CountingWriter, ...
+// P selects the length prefix of strings/views/vectors, including those
+// nested in vectors, arrays and schema/tagged fields. Custom serialize()
+// and CRTP serialize_impl members pick their own prefixes.
 // ------------------------------------------------------------------
-template <typename T>
-void write_field(Writer& w, const T& v) {
-    if constexpr (std::is_same_v<T, std::string>) {
-        w.write_sized_string_le(v);
-    } else if constexpr (detail::has_serialize_method<T>::value) {
+template <length_prefix P = length_prefix::u32_le, typename W, typename T, std::size_t N>
+void write_array(W& w, const std::array<T, N>& a);
+template <length_prefix P = length_prefix::u32_le, typename W, typename T, typename A>
+void write_vector(W& w, const std::vector<T, A>& v);
+
+template <length_prefix P = length_prefix::u32_le, typename W, typename T>
+void write_field(W& w, const T& v) {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        detail::write_length<P>(w, v.size());
+        w.write_string(v);
+    } else if constexpr (detail::is_span<T>::value) {
+        // same wire format as write_vector of trivially-copyable elements
+        using E = std::remove_const_t<typename T::element_type>;
+        static_assert(detail::is_memcpy_element<E>::value,
+                      "write_field: span elements must be trivially serializable (use std::vector for others)");
+        detail::write_length<P>(w, v.size());
+        w.template write_array<E>({ v.data(), v.size() });
+    } else if constexpr (detail::has_serialize_method<T, W>::value) {
         // custom serializable (incl. CRTP types via serialize_impl)
         v.serialize(w);
-    } else if constexpr (detail::is_trivially_serializable_v<T> && !detail::is_serializable_v<T>) {
+    } else if constexpr (detail::has_tagged_schema<T>::value) {
+        // id-tagged field list (tagged.hpp)
+        write_tagged<P>(w, v);
+    } else if constexpr (detail::has_schema<T>::value) {
+        // field list (schema.hpp)
+        write_schema<P>(w, v);
+    } else if constexpr (detail::is_native_value_v<T>) {
         // plain POD/trivial types with no custom serialize/deserialize
         w.write_native(v);
+    } else if constexpr (detail::is_std_vector<T>::value) {
+        write_vector<P>(w, v);
+    } else if constexpr (detail::is_std_array<T>::value) {
+        write_array<P>(w, v);
+    } else if constexpr (detail::is_serializable_v<T>) {
+        static_assert(detail::dependent_false<T>::value,
+                      "write_field: T::serialize does not accept this sink (take the sink as a template parameter)");
     } else {
         static_assert(detail::dependent_false<T>::value, "write_field: unsupported type T");
     }
 }
 
 // convenience variadic
-template <typename... Ts>
-void write_fields(Writer& w, const Ts&... ts) { (write_field(w, ts), ...); }
+template <length_prefix P = length_prefix::u32_le, typename W, typename... Ts>
+void write_fields(W& w, const Ts&... ts) { (write_field<P>(w, ts), ...); }
 
 // endian-explicit for arithmetic
-template <typename T>
+template <typename W, typename T>
 std::enable_if_t<is_arithmetic<T>::value, void>
-write_field_le(Writer& w, T v) { w.write_le<T>(v); }
+write_field_le(W& w, T v) { w.template write_le<T>(v); }
 
-template <typename T>
+template <typename W, typename T>
 std::enable_if_t<is_arithmetic<T>::value, void>
-write_field_be(Writer& w, T v) { w.write_be<T>(v); }
+write_field_be(W& w, T v) { w.template write_be<T>(v); }
 
-// vectors/arrays
-template <typename T>
-void write_vector(Writer& w, const std::vector<T>& v) {
-    w.write_le<std::uint32_t>(static_cast<std::uint32_t>(v.size()));
-    for (const auto& x : v) write_field(w, x);
+// vectors/arrays; trivially serializable elements go out as one block
+template <length_prefix P, typename W, typename T, typename A>
+void write_vector(W& w, const std::vector<T, A>& v) {
+    BYTESTREAM_COUNT(write_vector, v.size() * sizeof(T));
+    detail::write_length<P>(w, v.size());
+    if constexpr (detail::is_memcpy_element<T>::value) {
+        w.template write_array<T>({ v.data(), v.size() });
+    } else {
+        for (const auto& x : v) write_field<P>(w, x);
+    }
 }
+template <length_prefix P, typename W, typename T, std::size_t N>
+void write_array(W& w, const std::array<T, N>& a) {
+    if constexpr (detail::is_memcpy_element<T>::value) {
+        w.template write_array<T>({ a.data(), N });
+    } else {
+        for (const auto& x : a) write_field<P>(w, x);
+    }
+}
+
+// ------------------------------------------------------------------
+// Size precomputation
+// ------------------------------------------------------------------
+namespace detail {
+
+// Wire size known at compile time (0 when it depends on the value)
+template <typename T, typename = void>
+struct fixed_serialized_size : std::integral_constant<std::size_t, 0> {};
+template <typename T>
+struct fixed_serialized_size<T, std::enable_if_t<is_native_value_v<T>>>
+    : std::integral_constant<std::size_t, sizeof(T)> {};
 template <typename T, std::size_t N>
-void write_array(Writer& w, const std::array<T, N>& a) {
-    for (const auto& x : a) write_field(w, x);
+struct fixed_serialized_size<std::array<T, N>,
+                             std::enable_if_t<!is_native_value_v<std::array<T, N>>>>
+    : std::integral_constant<std::size_t, N * fixed_serialized_size<T>::value> {};
+// field lists made only of fixed-size fields
+template <typename T>
+struct fixed_serialized_size<T, std::enable_if_t<has_schema<T>::value && !has_serialize_method<T>::value>>
+    : std::integral_constant<std::size_t, schema_of<T>::type::fixed_size> {};
+
+} // namespace detail
+
+template <typename T>
+inline constexpr bool has_fixed_serialized_size_v = detail::fixed_serialized_size<T>::value != 0;
+
+// Exact wire size of a fixed-size type, usable in constant expressions
+template <typename T>
+constexpr std::size_t serialized_size() noexcept {
+    static_assert(has_fixed_serialized_size_v<T>,
+                  "serialized_size<T>(): T has no fixed wire size; use serialized_size(value)");
+    return detail::fixed_serialized_size<T>::value;
+}
+
+// Exact wire size of a value: runs the write_field dispatch against a CountingWriter
+template <length_prefix P = length_prefix::u32_le, typename T>
+std::size_t serialized_size(const T& v) {
+    if constexpr (has_fixed_serialized_size_v<T>) {
+        return detail::fixed_serialized_size<T>::value;
+    } else {
+        CountingWriter c;
+        write_field<P>(c, v);
+        return c.size();
+    }
 }
 
 // ------------------------------------------------------------------
 // Single-dispatch read_field (no overload ambiguity)
+// R is any reader-like source: Reader, UncheckedReader, ...
+// P must match the length_prefix the data was written with
 // ------------------------------------------------------------------
-template <typename T>
-T read_field(Reader& r) {
+namespace detail {
+template <typename V, length_prefix P, typename R> V read_vector_of(R& r);
+} // namespace detail
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+span<const T> read_vector_view(R& r);
+template <typename T, std::size_t N, length_prefix P = length_prefix::u32_le, typename R>
+std::array<T, N> read_array(R& r);
+
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+T read_field(R& r) {
     if constexpr (std::is_same_v<T, std::string>) {
-        return r.read_sized_string_le();
-    } else if constexpr (detail::has_deserialize_static<T>::value || detail::is_crtp_serializable<T>::value) {
+        return r.read_string(detail::read_length<P>(r));
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        // zero-copy: points into the source buffer
+        return r.view_string(detail::read_length<P>(r));
+    } else if constexpr (detail::is_span<T>::value) {
+        static_assert(std::is_const<typename T::element_type>::value, "read_field: view spans must be span<const T>");
+        return read_vector_view<std::remove_const_t<typename T::element_type>, P>(r);
+    } else if constexpr (detail::has_deserialize_static<T, R>::value) {
         // custom serializable (incl. CRTP types via T::deserialize)
+        detail::nested_scope<R> nested(r);
         return T::deserialize(r);
-    } else if constexpr (detail::is_trivially_serializable_v<T> && !detail::is_serializable_v<T>) {
+    } else if constexpr (detail::has_tagged_schema<T>::value) {
+        return read_tagged<T, P>(r); // one nesting level for the body
+    } else if constexpr (detail::has_schema<T>::value) {
+        detail::nested_scope<R> nested(r);
+        return read_schema<T, P>(r);
+    } else if constexpr (detail::is_native_value_v<T>) {
         // plain POD/trivial types with no custom serialize/deserialize
-        return r.read_native<T>();
+        return r.template read_native<T>();
+    } else if constexpr (detail::is_std_vector<T>::value) {
+        detail::nested_scope<R> nested(r);
+        return detail::read_vector_of<T, P>(r);
+    } else if constexpr (detail::is_std_array<T>::value) {
+        detail::nested_scope<R> nested(r);
+        return read_array<typename T::value_type, std::tuple_size<T>::value, P>(r);
+    } else if constexpr (detail::is_serializable_v<T>) {
+        static_assert(detail::dependent_false<T>::value,
+                      "read_field: T::deserialize does not accept this source (take the source as a template parameter)");
     } else {
         static_assert(detail::dependent_false<T>::value, "read_field: unsupported type T");
     }
 }
 
 // endian-explicit for arithmetic
-template <typename T>
+template <typename T, typename R>
 std::enable_if_t<is_arithmetic<T>::value, T>
-read_field_le(Reader& r) { return r.read_le<T>(); }
+read_field_le(R& r) { return r.template read_le<T>(); }
 
-template <typename T>
+template <typename T, typename R>
 std::enable_if_t<is_arithmetic<T>::value, T>
-read_field_be(Reader& r) { return r.read_be<T>(); }
+read_field_be(R& r) { return r.template read_be<T>(); }
+
+// ------------------------------------------------------------------
+// Allocator adaptor whose value-less construct() default-initializes:
+// resize() on a vector of trivial T then leaves the new elements
+// uninitialized instead of zeroing them. read_field of
+// std::vector<T, default_init_allocator<T>> decodes with one memcpy.
+// ------------------------------------------------------------------
+template <typename T, typename A = std::allocator<T>>
+class default_init_allocator : public A {
+    using traits = std::allocator_traits<A>;
+public:
+    template <typename U>
+    struct rebind {
+        using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+    default_init_allocator() = default;
+    default_init_allocator(const A& a) noexcept : A(a) {}
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void*>(p)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        traits::construct(static_cast<A&>(*this), p, std::forward<Args>(args)...);
+    }
+};
 
 // vectors/arrays
-template <typename T>
-std::vector<T> read_vector(Reader& r) {
-    std::uint32_t n = r.read_le<std::uint32_t>();
-    std::vector<T> out;
-    out.reserve(n);
-    for (std::uint32_t i = 0; i < n; ++i) out.push_back(read_field<T>(r));
+namespace detail {
+
+// n memcpy-able elements into a fresh vector; the bytes are bounds-checked
+// before anything is allocated
+template <typename V, typename R>
+void read_memcpy_elements(R& r, V& out, std::size_t n) {
+    using E = typename V::value_type;
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(E))
+        return source_error(r, errc::underflow, "bytestream::Reader underflow");
+    const std::size_t bytes = n * sizeof(E);
+    if (r.peek_contiguous().size() >= bytes) {
+        const std::byte* p = r.take(bytes);
+        out.resize(n);
+        if (bytes) std::memcpy(out.data(), p, bytes);
+        return;
+    }
+    // source refills (or is short): grow only as far as bytes arrive
+    constexpr std::size_t step = (std::size_t{64} << 10) / sizeof(E) ? (std::size_t{64} << 10) / sizeof(E) : 1;
+    for (std::size_t done = 0; done < n;) {
+        const std::size_t k = std::min(step, n - done);
+        out.resize(done + k);
+        r.read_bytes(out.data() + done, k * sizeof(E));
+        done += k;
+        if (!source_ok(r)) return out.clear();
+    }
+}
+
+// Elements worth reserving for n decoded entries: no more memory than the
+// contiguous bytes at hand, and no more entries than their minimum wire
+// size could fit, so a bogus n can't allocate
+template <typename E, typename R>
+std::size_t reserve_bound(const R& r, std::size_t n) noexcept {
+    constexpr std::size_t wire = fixed_serialized_size<E>::value;
+    constexpr std::size_t unit = wire > sizeof(E) ? wire : sizeof(E);
+    return std::min(n, r.peek_contiguous().size() / unit);
+}
+
+template <typename V, length_prefix P, typename R>
+V read_vector_of(R& r) {
+    using E = typename V::value_type;
+    const std::size_t n = read_length<P>(r);
+    BYTESTREAM_COUNT(read_vector, n * sizeof(E));
+    V out;
+    if (!budget_collection(r, n, sizeof(E))) return out;
+    if constexpr (is_memcpy_element<E>::value) {
+        read_memcpy_elements(r, out, n);
+    } else {
+        out.reserve(reserve_bound<E>(r, n));
+        for (std::size_t i = 0; i < n && source_ok(r); ++i) out.push_back(read_field<E, P>(r));
+    }
     return out;
 }
-template <typename T, std::size_t N>
-std::array<T, N> read_array(Reader& r) {
-    std::array<T, N> a{};
-    for (auto& x : a) x = read_field<T>(r);
-    return a;
+
+} // namespace detail
+
+template <typename T, length_prefix P = length_prefix::u32_le, typename R>
+std::vector<T> read_vector(R& r) { return detail::read_vector_of<std::vector<T>, P>(r); }
+
+// Zero-copy counterpart of read_vector for trivially-copyable T: the span
+// points into the source buffer (which must outlive it and be aligned for T)
+template <typename T, length_prefix P, typename R>
+span<const T> read_vector_view(R& r) {
+    static_assert(detail::is_native_value_v<T>,
+                  "read_vector_view: T must be trivially serializable");
+    const std::size_t n = detail::read_length<P>(r);
+    if (!detail::budget_collection(r, n, 0)) return {};
+    return r.template view_array<T>(n);
 }
 
+template <typename T, std::size_t N, length_prefix P, typename R>
+std::array<T, N> read_array(R& r) {
+    if constexpr (detail::is_memcpy_element<T>::value) {
+        std::array<T, N> a; // every byte is overwritten below
+        r.read_bytes(a.data(), N * sizeof(T));
+        return a;
+    } else {
+        std::array<T, N> a{};
+        for (auto& x : a) x = read_field<T, P>(r);
+        return a;
+    }
+}
+
+// ------------------------------------------------------------------
+// In-place decoding: overwrite an existing value, reusing the capacity
+// of its strings/vectors (and of nested elements). With warm targets a
+// decode loop does no heap allocation. CRTP types are decoded through
+// their deserialize_impl; have it use read_field_into for its members
+// to get the reuse all the way down. Types without an in-place path
+// fall back to assignment from read_field.
+// ------------------------------------------------------------------
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void read_field_into(R& r, T& out);
+
+namespace detail {
+
+template <typename V, length_prefix P, typename R>
+void read_vector_into_impl(R& r, V& out) {
+    using E = typename V::value_type;
+    const std::size_t n = read_length<P>(r);
+    BYTESTREAM_COUNT(read_vector, n * sizeof(E));
+    if (!budget_collection(r, n, sizeof(E))) return out.clear();
+    if constexpr (is_memcpy_element<E>::value) {
+        read_memcpy_elements(r, out, n);
+    } else if constexpr (std::is_default_constructible<E>::value) {
+        // decode over the live elements first, then append (bounded like read_vector_of)
+        const std::size_t live = std::min(n, out.size());
+        for (std::size_t i = 0; i < live && source_ok(r); ++i) read_field_into<P>(r, out[i]);
+        if (n < out.size()) {
+            out.erase(out.begin() + std::ptrdiff_t(n), out.end());
+            return;
+        }
+        out.reserve(live + reserve_bound<E>(r, n - live));
+        for (std::size_t i = live; i < n && source_ok(r); ++i) {
+            out.emplace_back();
+            read_field_into<P>(r, out.back());
+        }
+    } else {
+        out.clear();
+        out.reserve(reserve_bound<E>(r, n));
+        for (std::size_t i = 0; i < n && source_ok(r); ++i) out.push_back(read_field<E, P>(r));
+    }
+}
+
+} // namespace detail
+
+template <length_prefix P = length_prefix::u32_le, typename R, typename T, typename A>
+void read_vector_into(R& r, std::vector<T, A>& out) {
+    detail::nested_scope<R> nested(r);
+    detail::read_vector_into_impl<std::vector<T, A>, P>(r, out);
+}
+
+template <length_prefix P, typename R, typename T>
+void read_field_into(R& r, T& out) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        r.read_string_into(out, detail::read_length<P>(r));
+    } else if constexpr (detail::has_deserialize_impl<T, R>::value) {
+        detail::nested_scope<R> nested(r);
+        out.deserialize_impl(r);
+    } else if constexpr (detail::has_deserialize_static<T, R>::value) {
+        out = read_field<T, P>(r);
+    } else if constexpr (detail::has_tagged_schema<T>::value) {
+        read_tagged_into<P>(r, out);
+    } else if constexpr (detail::has_schema<T>::value) {
+        detail::nested_scope<R> nested(r);
+        read_schema_into<P>(r, out);
+    } else if constexpr (detail::is_std_vector<T>::value) {
+        read_vector_into<P>(r, out);
+    } else if constexpr (detail::is_std_array<T>::value) {
+        if constexpr (detail::is_memcpy_element<typename T::value_type>::value) {
+            r.read_bytes(out.data(), sizeof(out));
+        } else {
+            detail::nested_scope<R> nested(r);
+            for (auto& x : out) read_field_into<P>(r, x);
+        }
+    } else {
+        // trivial values, views, memcpy arrays: nothing to reuse
+        out = read_field<T, P>(r);
+    }
+}
+
+// Same as read_field_into; reads naturally for message types
+template <length_prefix P = length_prefix::u32_le, typename R, typename T>
+void deserialize_into(R& r, T& out) { read_field_into<P>(r, out); }
+
 } // namespace bytestream
 
+// Provide write_schema/read_schema
+#include <bytestream/schema.hpp>
+// Provide write_tagged/read_tagged
+#include <bytestream/tagged.hpp>
+
 #endif // BYTESTREAM_SERIALIZATION_HPP
@@ -0,0 +1,158 @@
+#ifndef BYTESTREAM_STREAM_READER_HPP
+#define BYTESTREAM_STREAM_READER_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/reader.hpp>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace bytestream {
+
+// ------------------------------------------------------------------
+// Reader over a byte stream that arrives in chunks (sockets, pipes,
+// files). Same decoding API as Reader; bytes are pulled on demand.
+//
+// Two kinds of source:
+//   chunk_source: returns the next chunk in place (an empty span ends
+//                 the stream). The chunk must stay valid until the
+//                 source is called again.
+//   pull_source:  fills the given buffer like read(2) and returns the
+//                 byte count (0 ends the stream); the reader owns the
+//                 buffer.
+//
+// Reads within the current chunk take the same path as Reader. A field
+// that crosses a chunk boundary is stitched together in a small
+// internal buffer first. Pointers and views returned by take(),
+// view_string() and friends stay valid only until the next read.
+// Underflow at the end of the stream throws UnderflowException, and
+// the bytes of the partial field are lost.
+// ------------------------------------------------------------------
+class StreamReader : public detail::reader_base<StreamReader> {
+public:
+    using chunk_source = std::function<span<const std::byte>()>;
+    using pull_source  = std::function<std::size_t(span<std::byte>)>;
+
+    static constexpr std::size_t default_buffer_size = std::size_t{64} << 10;
+
+    explicit StreamReader(chunk_source next) : next_(std::move(next)) {}
+
+    explicit StreamReader(pull_source pull, std::size_t buffer_size = default_buffer_size)
+        : pull_(std::move(pull)), buffer_(buffer_size ? buffer_size : 1) {}
+
+    StreamReader(const StreamReader&) = delete;
+    StreamReader& operator=(const StreamReader&) = delete;
+
+    // bytes consumed so far
+    std::size_t position() const noexcept { return consumed_ + std::size_t(cur_ - begin_); }
+    // bytes readable without pulling from the source
+    std::size_t buffered() const noexcept { return std::size_t(end_ - cur_); }
+    // true once the source is drained; may pull to find out
+    bool exhausted() { return cur_ == end_ && !refill(); }
+
+    span<const std::byte> peek_contiguous() const noexcept { return { cur_, buffered() }; }
+
+    // Consume n bytes at the cursor and return a pointer to them
+    const std::byte* take(std::size_t n) {
+        if (n <= buffered()) {
+            const std::byte* p = cur_;
+            cur_ += n;
+            return p;
+        }
+        return stitch(n);
+    }
+
+    UncheckedReader unchecked(std::size_t n) {
+        UncheckedReader u{take(n), n};
+        u.set_budget(budget_);
+        return u;
+    }
+
+    // ---- overrides that copy/drop straight across chunks (no stitching)
+    void read_bytes(void* dst, std::size_t n) {
+        if (n <= buffered()) {
+            if (n) std::memcpy(dst, cur_, n);
+            cur_ += n;
+            return;
+        }
+        read_bytes_across(static_cast<std::byte*>(dst), n);
+    }
+    void read_bytes(span<std::byte> out) { read_bytes(out.data(), out.size()); }
+
+    void skip(std::size_t n) {
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            cur_ += k;
+            n    -= k;
+            if (!n) return;
+            if (!refill()) underflow(n);
+        }
+    }
+
+private:
+    BYTESTREAM_NOINLINE void read_bytes_across(std::byte* out, std::size_t n) {
+        for (;;) {
+            const std::size_t k = std::min(n, buffered());
+            if (k) std::memcpy(out, cur_, k);
+            cur_ += k;
+            out  += k;
+            n    -= k;
+            if (!n) return;
+            if (!refill()) underflow(n);
+        }
+    }
+
+    [[noreturn]] static void underflow(std::size_t missing) {
+        BYTESTREAM_COUNT(underflow, missing);
+        (void)missing;
+        BYTESTREAM_THROW(UnderflowException("bytestream::StreamReader underflow"));
+    }
+
+    // Make the next chunk current; false at the end of the stream
+    BYTESTREAM_NOINLINE bool refill() {
+        consumed_ += std::size_t(end_ - begin_);
+        span<const std::byte> chunk;
+        if (pull_) {
+            const std::size_t n = pull_({ buffer_.data(), buffer_.size() });
+            chunk = { buffer_.data(), n };
+        } else if (next_) {
+            chunk = next_();
+        }
+        begin_ = cur_ = chunk.data();
+        end_ = begin_ + chunk.size();
+        return chunk.size() != 0;
+    }
+
+    // Gather n bytes spanning chunks into stitch_. n comes off the wire:
+    // growing it is charged to the budget up front, and the buffer only
+    // grows as bytes actually arrive
+    BYTESTREAM_NOINLINE const std::byte* stitch(std::size_t n) {
+        if (budget_ && n > stitch_.capacity()) budget_->charge(n - stitch_.capacity());
+        const std::size_t pos = position();
+        stitch_.assign(cur_, end_);
+        cur_ = end_;
+        while (stitch_.size() < n) {
+            if (!refill()) underflow(n - stitch_.size());
+            const std::size_t k = std::min(n - stitch_.size(), buffered());
+            stitch_.insert(stitch_.end(), cur_, cur_ + k);
+            cur_ += k;
+        }
+        // the stitched bytes count as consumed from the chunks they came from
+        BYTESTREAM_ASSERT(position() == pos + n);
+        (void)pos;
+        return stitch_.data();
+    }
+
+    chunk_source           next_;
+    pull_source            pull_;
+    std::vector<std::byte> buffer_; // pull_source target
+    std::vector<std::byte> stitch_; // fields crossing chunk boundaries
+    const std::byte*       begin_    = nullptr; // current chunk
+    const std::byte*       cur_      = nullptr;
+    const std::byte*       end_      = nullptr;
+    std::size_t            consumed_ = 0; // bytes of chunks before the current one
+};
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_STREAM_READER_HPP
@@ -0,0 +1,315 @@
+#ifndef BYTESTREAM_TAGGED_HPP
+#define BYTESTREAM_TAGGED_HPP
+
+#include <bytestream/config.hpp>
+#include <bytestream/serialization.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+// ------------------------------------------------------------------
+// Tagged (schema-evolving) records.
+//
+//   struct Quote {
+//       std::uint64_t id;
+//       double        px;
+//       std::string   venue;
+//       using bytestream_tagged = bytestream::tagged_schema<
+//           bytestream::tag<1, bytestream::field_le<&Quote::id>>,
+//           bytestream::tag<2, bytestream::field_le<&Quote::px>>,
+//           bytestream::tag<4, bytestream::field<&Quote::venue>>>;  // 3 retired
+//   };
+//
+//   bytestream::write_field(w, quote);            // or write_tagged(w, quote)
+//   auto q = bytestream::read_field<Quote>(r);    // ids it does not know are skipped
+//
+// Wire format: varint body length, then one entry per field:
+//   varint key (id << 3 | wire type), payload
+// wire types 0-3 are fixed 1/2/4/8-byte values (field_le/field_be and
+// trivially-copyable field<> members of that size); 4 is a varint
+// length followed by that many bytes (strings as raw bytes, nested
+// tagged records as their body, anything else in its write_field
+// format). Every payload is skippable without decoding, so readers
+// and writers can add and retire ids independently; unknown ids cost
+// one skip(). Known ids go through a table indexed by id, built at
+// compile time, so keep ids small (at most max_tag_id).
+// Fields absent from the input keep their value (T{} for read_tagged).
+// ------------------------------------------------------------------
+namespace bytestream {
+
+inline constexpr std::uint32_t max_tag_id = 4096;
+
+enum class tag_wire : std::uint8_t { fixed8 = 0, fixed16 = 1, fixed32 = 2, fixed64 = 3, bytes = 4 };
+
+// A schema field with its id on the wire (1..max_tag_id, never reused)
+template <std::uint32_t Id, typename Field>
+struct tag : Field {
+    static_assert(Id >= 1 && Id <= max_tag_id, "tag: id must be in 1..max_tag_id");
+    static constexpr std::uint32_t id = Id;
+};
+
+namespace detail {
+
+template <typename... Tags>
+constexpr bool unique_tag_ids() noexcept {
+    constexpr std::uint32_t ids[] = { Tags::id... };
+    for (std::size_t i = 0; i < sizeof...(Tags); ++i)
+        for (std::size_t j = i + 1; j < sizeof...(Tags); ++j)
+            if (ids[i] == ids[j]) return false;
+    return true;
+}
+
+} // namespace detail
+
+template <typename... Tags>
+struct tagged_schema {
+    static_assert(sizeof...(Tags) > 0, "tagged_schema: at least one field");
+    using fields     = std::tuple<Tags...>;
+    using class_type = typename std::tuple_element_t<0, fields>::class_type;
+    static_assert((std::is_same<typename Tags::class_type, class_type>::value && ...),
+                  "tagged_schema: all fields must belong to the same class");
+    static_assert(detail::unique_tag_ids<Tags...>(), "tagged_schema: duplicate tag id");
+
+    static constexpr std::size_t   field_count = sizeof...(Tags);
+    static constexpr std::uint32_t max_id      = std::max({ Tags::id... });
+};
+
+namespace detail {
+
+template <typename Tag>
+constexpr tag_wire tag_wire_of() noexcept {
+    if constexpr (Tag::fixed && Tag::size == 1) return tag_wire::fixed8;
+    else if constexpr (Tag::fixed && Tag::size == 2) return tag_wire::fixed16;
+    else if constexpr (Tag::fixed && Tag::size == 4) return tag_wire::fixed32;
+    else if constexpr (Tag::fixed && Tag::size == 8) return tag_wire::fixed64;
+    else return tag_wire::bytes;
+}
+
+constexpr std::uint64_t tag_key(std::uint32_t id, tag_wire wire) noexcept {
+    return (std::uint64_t{ id } << 3) | static_cast<std::uint64_t>(wire);
+}
+// varint_size of a key, at compile time
+constexpr std::size_t tag_key_size(std::uint64_t key) noexcept {
+    std::size_t n = 1;
+    for (; key >= 0x80; key >>= 7) ++n;
+    return n;
+}
+
+// Sub-reader over one payload: errors of a sticky source stay sticky
+template <typename R>
+using tagged_reader_t = std::conditional_t<sticky_errors<R>::value, NothrowReader, Reader>;
+
+template <typename Outer, typename Inner>
+void join_errors(Outer& outer, const Inner& inner) noexcept {
+    if constexpr (sticky_errors<Outer>::value && sticky_errors<Inner>::value) {
+        if (!inner.ok()) outer.fail(inner.error());
+    }
+}
+
+template <typename S, length_prefix P, typename T>
+std::size_t tagged_body_size(const T& v);
+
+// Bytes of a length-delimited payload
+template <length_prefix P, typename M>
+std::size_t tag_payload_size(const M& m) {
+    if constexpr (std::is_same_v<M, std::string> || std::is_same_v<M, std::string_view>) {
+        return m.size();
+    } else if constexpr (has_tagged_schema<M>::value) {
+        return tagged_body_size<typename tagged_schema_of<M>::type, P>(m);
+    } else {
+        CountingWriter size;
+        write_field<P>(size, m);
+        return size.size();
+    }
+}
+
+template <length_prefix P, typename W, typename M>
+void write_tag_payload(W& w, const M& m) {
+    if constexpr (std::is_same_v<M, std::string> || std::is_same_v<M, std::string_view>) {
+        w.write_string(m);
+    } else if constexpr (has_tagged_schema<M>::value) {
+        write_tagged_body<P>(w, m);
+    } else {
+        write_field<P>(w, m);
+    }
+}
+
+template <typename Tag, length_prefix P, typename C>
+std::size_t tag_entry_size(const C& obj) {
+    constexpr std::size_t key = tag_key_size(tag_key(Tag::id, tag_wire_of<Tag>()));
+    if constexpr (tag_wire_of<Tag>() != tag_wire::bytes) {
+        return key + Tag::size;
+    } else {
+        const std::size_t n = tag_payload_size<P>(obj.*Tag::member);
+        return key + varint_size(n) + n;
+    }
+}
+
+template <typename S, length_prefix P, typename C, std::size_t... Is>
+std::size_t tagged_body_size_of(const C& obj, std::index_sequence<Is...>) {
+    return (std::size_t{0} + ... + tag_entry_size<schema_field_t<S, Is>, P>(obj));
+}
+template <typename S, length_prefix P, typename T>
+std::size_t tagged_body_size(const T& v) {
+    return tagged_body_size_of<S, P>(v, std::make_index_sequence<S::field_count>{});
+}
+
+template <typename Tag, length_prefix P, typename W, typename C>
+void write_tag_entry(W& w, const C& obj) {
+    constexpr tag_wire wire = tag_wire_of<Tag>();
+    w.template write_varint<std::uint64_t>(tag_key(Tag::id, wire));
+    if constexpr (wire != tag_wire::bytes) {
+        if constexpr (has_claim<W>::value) {
+            // straight into the sink: a by-reference sink must not see a temporary
+            if (std::byte* p = w.claim(Tag::size)) Tag::store(p, obj);
+        } else {
+            std::byte buf[Tag::size];
+            Tag::store(buf, obj);
+            w.write_bytes(buf, sizeof(buf));
+        }
+    } else {
+        const auto& m = obj.*Tag::member;
+        w.template write_varint<std::uint64_t>(tag_payload_size<P>(m));
+        write_tag_payload<P>(w, m);
+    }
+}
+
+// Keys of ids below 16 and lengths below 128 are one byte: read those
+// inline and leave the rest to read_varint
+template <typename R>
+std::uint64_t read_tag_varint(R& r) {
+    const span<const std::byte> avail = r.peek_contiguous();
+    if (avail.size() && static_cast<std::uint8_t>(avail.data()[0]) < 0x80u)
+        return static_cast<std::uint8_t>(*r.take(1));
+    return r.template read_varint<std::uint64_t>();
+}
+template <typename R>
+std::size_t read_tag_length(R& r) {
+    const span<const std::byte> avail = r.peek_contiguous();
+    if (avail.size() && static_cast<std::uint8_t>(avail.data()[0]) < 0x80u)
+        return static_cast<std::uint8_t>(*r.take(1));
+    return r.read_varint_length();
+}
+
+// Step over one entry's payload without decoding it
+template <typename R>
+void skip_tag_payload(R& r, unsigned wire) {
+    if (wire < 4) return r.skip(std::size_t{1} << wire);
+    if (wire == static_cast<unsigned>(tag_wire::bytes)) return r.skip(read_tag_length(r));
+    source_error(r, errc::format, "bytestream tagged: unknown wire type");
+}
+
+template <length_prefix P, typename R, typename M>
+void read_tag_payload(R& r, std::size_t n, M& m) {
+    if constexpr (std::is_same_v<M, std::string>) {
+        r.read_string_into(m, n);
+    } else if constexpr (std::is_same_v<M, std::string_view>) {
+        m = r.view_string(n);
+    } else {
+        const std::byte* p = r.take(n);
+        if (!source_ok(r)) return;
+        R inner(p, n);
+        inner.set_budget(r.budget());
+        if constexpr (has_tagged_schema<M>::value) {
+            nested_scope<R> nested(inner);
+            read_tagged_body<P>(inner, m);
+        } else {
+            read_field_into<P>(inner, m);
+            if (source_ok(inner) && !inner.exhausted())
+                source_error(inner, errc::format, "bytestream tagged: payload longer than its field");
+        }
+        join_errors(r, inner);
+    }
+}
+
+// Decodes the entry of Tag whose key has just been read
+template <typename Tag, length_prefix P, typename R>
+void read_tag_entry(R& r, unsigned wire, typename Tag::class_type& obj) {
+    constexpr tag_wire expect = tag_wire_of<Tag>();
+    if (wire != static_cast<unsigned>(expect))
+        return source_error(r, errc::format, "bytestream tagged: wire type mismatch");
+    if constexpr (expect != tag_wire::bytes) {
+        Tag::load(take_fixed<Tag::size>(r), obj);
+    } else {
+        read_tag_payload<P>(r, read_tag_length(r), obj.*Tag::member);
+    }
+}
+
+// handler per id (nullptr: unknown id)
+template <typename S, length_prefix P, typename R>
+struct tag_dispatch {
+    using class_type = typename S::class_type;
+    using handler    = void (*)(R&, unsigned, class_type&);
+
+    template <std::size_t... Is>
+    static constexpr std::array<handler, S::max_id + 1> make(std::index_sequence<Is...>) {
+        std::array<handler, S::max_id + 1> t{};
+        ((t[schema_field_t<S, Is>::id] = &read_tag_entry<schema_field_t<S, Is>, P, R>), ...);
+        return t;
+    }
+    static constexpr std::array<handler, S::max_id + 1> table = make(std::make_index_sequence<S::field_count>{});
+};
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Entries only (no body length)
+// ------------------------------------------------------------------
+template <length_prefix P, typename W, typename T>
+void write_tagged_body(W& w, const T& v) {
+    using S = typename tagged_schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "write_tagged: schema describes another type");
+    std::apply([&](auto... tags) { (detail::write_tag_entry<decltype(tags), P>(w, v), ...); }, typename S::fields{});
+}
+
+// Decode entries until r is exhausted; r is a Reader or NothrowReader
+// over exactly the body
+template <length_prefix P, typename R, typename T>
+void read_tagged_body(R& r, T& v) {
+    using S = typename tagged_schema_of<T>::type;
+    static_assert(std::is_same<typename S::class_type, T>::value, "read_tagged: schema describes another type");
+    constexpr auto& table = detail::tag_dispatch<S, P, R>::table;
+    while (!r.exhausted() && detail::source_ok(r)) {
+        const std::uint64_t key  = detail::read_tag_varint(r);
+        const auto          wire = static_cast<unsigned>(key & 7u);
+        const std::uint64_t id   = key >> 3;
+        if (id < table.size() && table[id]) table[id](r, wire, v);
+        else detail::skip_tag_payload(r, wire);
+    }
+}
+
+// ------------------------------------------------------------------
+// Body length + entries (write_field/read_field of tagged types)
+// ------------------------------------------------------------------
+template <length_prefix P, typename W, typename T>
+void write_tagged(W& w, const T& v) {
+    using S = typename tagged_schema_of<T>::type;
+    w.template write_varint<std::uint64_t>(detail::tagged_body_size<S, P>(v));
+    write_tagged_body<P>(w, v);
+}
+
+template <length_prefix P, typename R, typename T>
+void read_tagged_into(R& r, T& v) {
+    const std::size_t n = detail::read_tag_length(r);
+    const std::byte* p = r.take(n);
+    if (!detail::source_ok(r)) return;
+    detail::tagged_reader_t<R> body(p, n);
+    body.set_budget(detail::budget_of(r));
+    {
+        detail::nested_scope<detail::tagged_reader_t<R>> nested(body);
+        read_tagged_body<P>(body, v);
+    }
+    detail::join_errors(r, body);
+}
+
+template <typename T, length_prefix P, typename R>
+T read_tagged(R& r) {
+    T v{};
+    read_tagged_into<P>(r, v);
+    return v;
+}
+
+} // namespace bytestream
+
+#endif // BYTESTREAM_TAGGED_HPP
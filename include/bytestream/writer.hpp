@@ -2,6 +2,11 @@
 #define BYTESTREAM_WRITER_HPP
 
 #include <bytestream/config.hpp>
+#include <bytestream/detail/byteswap_array.hpp>
+#include <bytestream/detail/instrument_hooks.hpp>
+#include <bytestream/detail/stream_vbyte.hpp>
+#include <bytestream/detail/varint.hpp>
+#include <array>
 #include <cstring>
 #include <string>
 #include <string_view>
@@ -9,106 +14,434 @@
 namespace bytestream {
 
 class Reader; // fwd
+class UncheckedWriter; // fwd
 
-class Writer {
-    std::byte*  data_;
-    std::size_t size_;
-    std::size_t pos_;
-public:
-    Writer(void* data, std::size_t size) noexcept
-        : data_(static_cast<std::byte*>(data)), size_(size), pos_(0) {}
+namespace detail {
 
-    std::size_t size() const noexcept { return size_; }
-    std::size_t position() const noexcept { return pos_; }
-    std::size_t remaining() const noexcept { return size_ - pos_; }
-    // Convenience alias for readability
-    std::size_t written_bytes() const noexcept { return pos_; }
+// Sinks that hand out their own memory (claim); CountingWriter does not
+template <typename W, typename = void>
+struct has_claim : std::false_type {};
+template <typename W>
+struct has_claim<W, std::void_t<decltype(std::declval<W&>().claim(std::size_t{}))>> : std::true_type {};
 
-    void seek(std::size_t p) {
-        if (p > size_) throw std::out_of_range("bytestream::Writer seek past end");
-        pos_ = p;
+// Copy bytes built on the stack (length prefixes, terminators, packed
+// words) into the sink's own memory. Never goes through write_bytes,
+// which by-reference sinks (GatherWriter) may keep a pointer from;
+// sinks without claim() only count.
+template <typename W>
+BYTESTREAM_CONSTEXPR20 void write_inline(W& w, const std::byte* src, std::size_t n) {
+    if constexpr (has_claim<W>::value) {
+        std::byte* p = w.claim(n);
+        if (!n || !p) return; // a sticky sink refused the claim
+        if (is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) p[i] = src[i];
+        } else {
+            std::memcpy(p, src, n);
+        }
+    } else {
+        w.write_bytes(src, n);
     }
+}
 
-    void ensure(std::size_t n) const {
-        if (n > (size_ - pos_)) throw OverflowException("bytestream::Writer overflow");
+// ------------------------------------------------------------------
+// Shared encoding surface for every writer-like sink (CRTP).
+// Derived provides:
+//   std::byte*  claim(std::size_t n)  // reserve n bytes at the cursor, advance, return them
+//   std::size_t position() const
+// Sinks with sticky_errors (NothrowWriter) also provide fail(errc) and
+// return nullptr from a claim() that fails; nothing is stored then.
+// ------------------------------------------------------------------
+template <typename Derived>
+class writer_base {
+    constexpr Derived&       self() noexcept       { return static_cast<Derived&>(*this); }
+    constexpr const Derived& self() const noexcept { return static_cast<const Derived&>(*this); }
+    static constexpr bool sticky() noexcept { return sticky_errors<Derived>::value; }
+    // false when a sticky sink refused the claim
+    static constexpr bool claimed(const std::byte* p) noexcept {
+        if constexpr (sticky()) return p != nullptr;
+        else return (void)p, true;
     }
-
+public:
     // ---- raw bytes
     void write_bytes(const void* src, std::size_t n) {
-        ensure(n);
-        std::memcpy(data_ + pos_, src, n);
-        pos_ += n;
+        BYTESTREAM_COUNT(write_bytes, n);
+        std::byte* p = self().claim(n);
+        if (n && claimed(p)) std::memcpy(p, src, n);
     }
 
     // ---- trivially-copyable write
     template <typename T>
-    std::enable_if_t<std::is_trivially_copyable<T>::value, void>
-    write(const T& v) { write_bytes(&v, sizeof(T)); }
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<std::is_trivially_copyable<T>::value, void>
+    write(const T& v) {
+        BYTESTREAM_COUNT(write_fixed, sizeof(T));
+        if constexpr (inherits_write_bytes<Derived>::value) {
+            std::byte* p = self().claim(sizeof(T));
+            if (claimed(p)) store_native(p, v);
+        } else {
+            self().write_bytes(&v, sizeof(T));
+        }
+    }
 
     // ---- arithmetic endian-aware
     template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, void>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<is_arithmetic<T>::value, void>
     write_le(T v) {
         if constexpr (is_big_endian()) v = byteswap(v);
-        write(v);
+        self().write(v);
     }
     template <typename T>
-    std::enable_if_t<is_arithmetic<T>::value, void>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<is_arithmetic<T>::value, void>
     write_be(T v) {
         if constexpr (is_little_endian()) v = byteswap(v);
-        write(v);
+        self().write(v);
     }
 
     // ---- arrays
     template <typename T>
     void write_array(span<const T> arr) {
-        write_bytes(arr.data(), arr.size() * sizeof(T));
+        const std::size_t n = array_bytes<T>(arr.size());
+        BYTESTREAM_COUNT(write_array, n);
+        put(arr.data(), n);
     }
+    // one bounds check per array; bulk byteswap (SIMD where available)
+    // or a single memcpy when the wire order matches the host
+    template <typename T>
+    std::enable_if_t<is_arithmetic<T>::value, void>
+    write_array_be(span<const T> arr) { write_array_ordered<T, endian::big>(arr); }
     template <typename T>
     std::enable_if_t<is_arithmetic<T>::value, void>
-    write_array_be(span<const T> arr) {
-        for (std::size_t i = 0; i < arr.size(); ++i) write_be<T>(arr.data()[i]);
+    write_array_le(span<const T> arr) { write_array_ordered<T, endian::little>(arr); }
+
+    // Stream VByte: 2-bit lengths up front, then 1-4 bytes per value;
+    // optional delta coding for sorted data. The count is not written.
+    void write_packed_u32_array(span<const std::uint32_t> arr, packed_coding coding = packed_coding::plain) {
+        const std::size_t n = detail::svb_encoded_size(arr.data(), arr.size(), coding);
+        BYTESTREAM_COUNT(write_array, arr.size() * sizeof(std::uint32_t));
+        std::byte* p = self().claim(n);
+        if (claimed(p)) detail::svb_encode(arr.data(), arr.size(), coding, p);
+    }
+
+    // ---- varints (LEB128; signed types are ZigZag-encoded)
+    template <typename T>
+    BYTESTREAM_CONSTEXPR20 std::enable_if_t<std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), void>
+    write_varint(T v) {
+        const std::uint64_t bits = detail::varint_bits(v);
+        const std::size_t   n    = detail::varint_size(bits);
+        BYTESTREAM_COUNT(write_varint, n);
+        std::byte* p = self().claim(n);
+        if (claimed(p)) detail::encode_varint(bits, p);
     }
 
     // ---- strings
-    void write_string(std::string_view s) { write_bytes(s.data(), s.size()); }
+    BYTESTREAM_CONSTEXPR20 void write_string(std::string_view s) {
+        BYTESTREAM_COUNT(write_string, s.size());
+        put_bytes(s.data(), s.size());
+    }
 
-    void write_sized_string_le(std::string_view s) {
-        write_le<std::uint32_t>(static_cast<std::uint32_t>(s.size()));
-        write_string(s);
+    BYTESTREAM_CONSTEXPR20 void write_sized_string_le(std::string_view s) {
+        BYTESTREAM_COUNT(write_string, s.size());
+        std::byte len[4]{};
+        store_le(len, static_cast<std::uint32_t>(s.size()));
+        write_inline(self(), len, sizeof(len));
+        put_bytes(s.data(), s.size());
     }
-    void write_sized_string_be(std::string_view s) {
-        write_be<std::uint32_t>(static_cast<std::uint32_t>(s.size()));
-        write_string(s);
+    BYTESTREAM_CONSTEXPR20 void write_sized_string_be(std::string_view s) {
+        BYTESTREAM_COUNT(write_string, s.size());
+        std::byte len[4]{};
+        store_be(len, static_cast<std::uint32_t>(s.size()));
+        write_inline(self(), len, sizeof(len));
+        put_bytes(s.data(), s.size());
     }
-    void write_cstring(std::string_view s) {
-        write_string(s);
-        const std::uint8_t zero = 0;
-        write(zero);
+    BYTESTREAM_CONSTEXPR20 void write_sized_string_varint(std::string_view s) {
+        BYTESTREAM_COUNT(write_string, s.size());
+        std::byte len[detail::max_varint_bytes]{};
+        write_inline(self(), len, detail::encode_varint(s.size(), len));
+        put_bytes(s.data(), s.size());
+    }
+    BYTESTREAM_CONSTEXPR20 void write_cstring(std::string_view s) {
+        BYTESTREAM_COUNT(write_string, s.size());
+        put_bytes(s.data(), s.size());
+        const std::byte zero{0};
+        write_inline(self(), &zero, 1);
     }
 
     // ---- fills & alignment
-    void fill_bytes(std::byte value, std::size_t count) {
-        ensure(count);
-        std::memset(data_ + pos_, int(value), count);
-        pos_ += count;
+    BYTESTREAM_CONSTEXPR20 void fill_bytes(std::byte value, std::size_t count) {
+        std::byte* p = self().claim(count);
+        if (!count || !claimed(p)) return;
+        if (is_constant_evaluated()) {
+            for (std::size_t i = 0; i < count; ++i) p[i] = value;
+        } else {
+            std::memset(p, int(value), count);
+        }
     }
-    void zero_fill(std::size_t count) { fill_bytes(std::byte{0}, count); }
+    BYTESTREAM_CONSTEXPR20 void zero_fill(std::size_t count) { self().fill_bytes(std::byte{0}, count); }
 
-    void align(std::size_t alignment, std::byte fill = std::byte{0}) {
-        std::size_t next = align_up(pos_, alignment);
-        std::size_t pad  = next - pos_;
-        if (pad) fill_bytes(fill, pad);
+    BYTESTREAM_CONSTEXPR20 void align(std::size_t alignment, std::byte fill = std::byte{0}) {
+        const std::size_t pos  = self().position();
+        const std::size_t pad  = align_up(pos, alignment) - pos;
+        if (pad) self().fill_bytes(fill, pad);
     }
 
     // ---- native helpers used by serialization.hpp
     template <typename T>
     std::enable_if_t<std::is_trivially_copyable<T>::value, void>
-    write_native(const T& v) { write(v); }
+    write_native(const T& v) { self().write(v); }
+
+    // Claim n bytes once and return an unchecked cursor over exactly
+    // that range (fixed-layout frames)
+    template <typename D = Derived>
+    UncheckedWriter unchecked(std::size_t n);
+
+private:
+    template <typename T>
+    std::size_t array_bytes(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            if constexpr (sticky()) {
+                self().fail(errc::overflow);
+                return std::numeric_limits<std::size_t>::max(); // the claim() fails too
+            } else {
+                BYTESTREAM_THROW(OverflowException("bytestream::Writer overflow"));
+            }
+        }
+        return n * sizeof(T);
+    }
+
+    // write_bytes without counting it again (sinks that replace
+    // write_bytes, e.g. to keep large blobs by reference, still get it)
+    void put(const void* src, std::size_t n) {
+        if constexpr (inherits_write_bytes<Derived>::value) {
+            std::byte* p = self().claim(n);
+            if (n && claimed(p)) std::memcpy(p, src, n);
+        } else {
+            self().write_bytes(src, n);
+        }
+    }
+    // put() from char/byte data; a plain copy loop while constant-evaluating
+    template <typename C>
+    BYTESTREAM_CONSTEXPR20 void put_bytes(const C* src, std::size_t n) {
+        static_assert(sizeof(C) == 1, "put_bytes: byte-sized elements only");
+        if constexpr (inherits_write_bytes<Derived>::value) {
+            if (is_constant_evaluated()) {
+                std::byte* p = self().claim(n);
+                if (!claimed(p)) return;
+                for (std::size_t i = 0; i < n; ++i)
+                    p[i] = static_cast<std::byte>(static_cast<unsigned char>(src[i]));
+                return;
+            }
+        }
+        put(src, n);
+    }
+
+    template <typename D, typename = void>
+    struct inherits_write_bytes : std::false_type {};
+    template <typename D>
+    struct inherits_write_bytes<D, std::enable_if_t<std::is_same<
+        decltype(&D::write_bytes), void (writer_base::*)(const void*, std::size_t)>::value>> : std::true_type {};
+
+    template <typename T, endian Order>
+    void write_array_ordered(span<const T> arr) {
+        const std::size_t n = arr.size();
+        BYTESTREAM_COUNT(write_array, n * sizeof(T));
+        std::byte* p = self().claim(array_bytes<T>(n));
+        if (!claimed(p)) return;
+        if constexpr (Order == endian::native) {
+            if (n) std::memcpy(p, arr.data(), n * sizeof(T));
+        } else {
+            byteswap_copy_of<T>(p, arr.data(), n);
+        }
+    }
+};
+
+} // namespace detail
+
+// ------------------------------------------------------------------
+// Cursor over a range that was bounds-checked once up front.
+// Obtain it from Writer::unchecked(n); overruns are caught by
+// BYTESTREAM_ASSERT in debug builds only.
+// ------------------------------------------------------------------
+class UncheckedWriter : public detail::writer_base<UncheckedWriter> {
+    std::byte*  data_;
+    std::size_t size_;
+    std::size_t pos_;
+public:
+    UncheckedWriter(void* data, std::size_t size) noexcept
+        : data_(static_cast<std::byte*>(data)), size_(size), pos_(0) {}
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return pos_; }
+    std::size_t remaining() const noexcept { return size_ - pos_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return pos_; }
+
+    void ensure(std::size_t n) const noexcept { BYTESTREAM_ASSERT(n <= size_ - pos_); (void)n; }
+
+    std::byte* claim(std::size_t n) noexcept {
+        ensure(n);
+        std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+};
+
+template <typename Derived>
+template <typename D>
+inline UncheckedWriter detail::writer_base<Derived>::unchecked(std::size_t n) {
+    return UncheckedWriter{static_cast<D&>(*this).claim(n), n};
+}
 
+class Writer : public detail::writer_base<Writer> {
+    std::byte*  data_;
+    std::size_t size_;
+    std::size_t pos_;
+public:
+    Writer(void* data, std::size_t size) noexcept
+        : data_(static_cast<std::byte*>(data)), size_(size), pos_(0) {}
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return pos_; }
+    std::size_t remaining() const noexcept { return size_ - pos_; }
+    // Convenience alias for readability
+    std::size_t written_bytes() const noexcept { return pos_; }
+    // the bytes in front of the cursor, in place
+    span<const std::byte> written_view() const noexcept { return { data_, pos_ }; }
+
+    void seek(std::size_t p) {
+        if (p > size_) BYTESTREAM_THROW(std::out_of_range("bytestream::Writer seek past end"));
+        pos_ = p;
+    }
+
+    void ensure(std::size_t n) const {
+        if (n > (size_ - pos_)) {
+            BYTESTREAM_COUNT(overflow, n);
+            BYTESTREAM_THROW(OverflowException("bytestream::Writer overflow"));
+        }
+    }
+
+    // Reserve n bytes at the cursor and hand them out for in-place encoding
+    std::byte* claim(std::size_t n) {
+        ensure(n);
+        std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    // Reader over written_view() (no copy)
     Reader as_reader() const noexcept;
 };
 
+// ------------------------------------------------------------------
+// Writer over its own N-byte array. On C++20 (BYTESTREAM_HAS_CONSTEXPR20)
+// the fixed-width, varint, string and fill writes run in constant
+// expressions, so headers and lookup tables can be encoded at compile
+// time; an overflow there is a compile error.
+//
+//   constexpr auto header = [] {
+//       bytestream::StaticWriter<8> w;
+//       w.write_be<std::uint32_t>(0x89504E47);
+//       w.write_le<std::uint16_t>(1);
+//       return w;
+//   }();
+//   static_assert(header.written_bytes() == 6);
+//   out.write_bytes(header.data(), header.written_bytes());
+// ------------------------------------------------------------------
+template <std::size_t N>
+class StaticWriter : public detail::writer_base<StaticWriter<N>> {
+    std::array<std::byte, N> buf_{};
+    std::size_t              pos_ = 0;
+public:
+    constexpr StaticWriter() noexcept = default;
+
+    static constexpr std::size_t size() noexcept { return N; }
+    constexpr std::size_t position() const noexcept { return pos_; }
+    constexpr std::size_t remaining() const noexcept { return N - pos_; }
+    constexpr std::size_t written_bytes() const noexcept { return pos_; }
+
+    constexpr std::byte* data() noexcept { return buf_.data(); }
+    constexpr const std::byte* data() const noexcept { return buf_.data(); }
+    // whole buffer (bytes past written_bytes() are zero)
+    constexpr const std::array<std::byte, N>& array() const noexcept { return buf_; }
+    constexpr span<const std::byte> written_view() const noexcept { return { buf_.data(), pos_ }; }
+
+    BYTESTREAM_CONSTEXPR20 void seek(std::size_t p) {
+        if (p > N) BYTESTREAM_THROW(std::out_of_range("bytestream::StaticWriter seek past end"));
+        pos_ = p;
+    }
+
+    BYTESTREAM_CONSTEXPR20 void ensure(std::size_t n) const {
+        if (n > (N - pos_)) {
+            BYTESTREAM_COUNT(overflow, n);
+            BYTESTREAM_THROW(OverflowException("bytestream::StaticWriter overflow"));
+        }
+    }
+
+    BYTESTREAM_CONSTEXPR20 std::byte* claim(std::size_t n) {
+        ensure(n);
+        std::byte* p = buf_.data() + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    // Reader over the bytes written so far
+    constexpr Reader as_reader() const noexcept;
+};
+
+// ------------------------------------------------------------------
+// Writer that never throws. The first overflow is kept in error() and
+// every later write is dropped, so a whole message is encoded and
+// checked once.
+//
+//   bytestream::NothrowWriter w(buf, sizeof(buf));
+//   bytestream::write_field(w, msg);
+//   if (!w) return w.error();   // errc::overflow
+//   send(buf, w.written_bytes());
+// ------------------------------------------------------------------
+class NothrowWriter : public detail::writer_base<NothrowWriter> {
+    std::byte*  data_;
+    std::size_t size_;
+    std::size_t pos_;
+    errc        error_ = errc::ok;
+public:
+    static constexpr bool sticky_errors = true;
+
+    NothrowWriter(void* data, std::size_t size) noexcept
+        : data_(static_cast<std::byte*>(data)), size_(size), pos_(0) {}
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t position() const noexcept { return pos_; }
+    std::size_t remaining() const noexcept { return size_ - pos_; }
+    std::size_t written_bytes() const noexcept { return pos_; }
+    std::byte* data() const noexcept { return data_; }
+    span<const std::byte> written_view() const noexcept { return { data_, pos_ }; }
+
+    bool ok() const noexcept { return error_ == errc::ok; }
+    errc error() const noexcept { return error_; }
+    explicit operator bool() const noexcept { return ok(); }
+
+    // Record e (the first error wins); later claims all fail
+    void fail(errc e) noexcept {
+        if (error_ == errc::ok) error_ = e;
+    }
+
+    void seek(std::size_t p) noexcept {
+        if (p > size_) return fail(errc::out_of_range);
+        pos_ = p;
+    }
+
+    // n bytes at the cursor, or nullptr (and error() set) when full
+    std::byte* claim(std::size_t n) noexcept {
+        if (!ok()) return nullptr;
+        if (n > (size_ - pos_)) {
+            BYTESTREAM_COUNT(overflow, n);
+            fail(errc::overflow);
+            return nullptr;
+        }
+        std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+};
+
 } // namespace bytestream
 
 // Provide definition once Reader is visible
@@ -116,7 +449,11 @@ public:
 
 namespace bytestream {
 inline Reader Writer::as_reader() const noexcept {
-    return Reader{data_, size_};
+    return Reader{data_, pos_};
+}
+template <std::size_t N>
+constexpr Reader StaticWriter<N>::as_reader() const noexcept {
+    return Reader{buf_.data(), pos_};
 }
 }
 
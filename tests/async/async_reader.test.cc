@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/async_reader.hpp>
+
+#if defined(BYTESTREAM_HAS_COROUTINES)
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+// Eager fire-and-forget coroutine that records its outcome
+struct task {
+    struct promise_type {
+        task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { *error_slot = std::current_exception(); }
+        std::exception_ptr* error_slot = &dropped;
+        static inline std::exception_ptr dropped;
+    };
+};
+
+struct Outcome {
+    bool               finished = false;
+    std::exception_ptr error;
+};
+
+// Counts suspensions through a wrapper awaiter
+struct Tally {
+    int suspends = 0;
+};
+
+template <typename A>
+struct counted {
+    A      inner;
+    Tally* tally;
+    bool await_ready() { return inner.await_ready(); }
+    bool await_suspend(std::coroutine_handle<> h) {
+        ++tally->suspends;
+        return inner.await_suspend(h);
+    }
+    decltype(auto) await_resume() { return inner.await_resume(); }
+};
+template <typename A>
+counted<A> count(A a, Tally& t) { return { std::move(a), &t }; }
+
+struct Order {
+    std::uint32_t id{};
+    std::string   symbol;
+    std::vector<std::uint16_t> legs;
+};
+
+DynamicWriter encode_order(const Order& o)
+{
+    DynamicWriter w;
+    write_fields(w, o.id, o.symbol, o.legs);
+    return w;
+}
+
+task read_header(AsyncReader& in, std::uint32_t& a, std::uint16_t& b, std::string& s, Tally& t, Outcome& out)
+{
+    a = co_await count(in.read_le<std::uint32_t>(), t);
+    b = co_await count(in.read_be<std::uint16_t>(), t);
+    s = co_await count(in.read_string(5), t);
+    out.finished = true;
+}
+
+task read_orders(AsyncReader& in, std::vector<Order>& orders, std::size_t n, Tally& t, Outcome& out)
+{
+    try {
+        for (std::size_t i = 0; i < n; ++i) {
+            Order o;
+            o.id     = co_await count(in.read_field<std::uint32_t>(), t);
+            o.symbol = co_await count(in.read_field<std::string>(), t);
+            o.legs   = co_await count(in.read_vector<std::uint16_t>(), t);
+            orders.push_back(std::move(o));
+        }
+        out.finished = true;
+    } catch (...) {
+        out.error = std::current_exception();
+    }
+}
+
+task read_frames(AsyncReader& in, std::vector<std::string>& frames, Outcome& out)
+{
+    try {
+        for (;;) {
+            Reader f = co_await in.read_frame<length_prefix::varint>();
+            frames.push_back(f.read_string(f.remaining()));
+        }
+    } catch (...) {
+        out.error = std::current_exception();
+    }
+}
+
+} // namespace
+
+TEST(AsyncReaderTest, BufferedReadsCompleteWithoutSuspending)
+{
+    AsyncReader in;
+    DynamicWriter w;
+    w.write_le<std::uint32_t>(0xA1B2C3D4u);
+    w.write_be<std::uint16_t>(0x1234);
+    w.write_bytes("hello", 5);
+    in.feed(w.data(), w.size());
+
+    std::uint32_t a = 0;
+    std::uint16_t b = 0;
+    std::string   s;
+    Tally         t;
+    Outcome       out;
+    read_header(in, a, b, s, t, out);
+    EXPECT_TRUE(out.finished);
+    EXPECT_EQ(t.suspends, 0);
+    EXPECT_EQ(a, 0xA1B2C3D4u);
+    EXPECT_EQ(b, 0x1234);
+    EXPECT_EQ(s, "hello");
+    EXPECT_EQ(in.buffered(), 0u);
+    EXPECT_EQ(in.position(), 11u);
+}
+
+TEST(AsyncReaderTest, SuspendsUntilBytesArrive)
+{
+    AsyncReader in(4);
+    DynamicWriter w;
+    w.write_le<std::uint32_t>(7);
+    w.write_be<std::uint16_t>(9);
+    w.write_bytes("world", 5);
+
+    std::uint32_t a = 0;
+    std::uint16_t b = 0;
+    std::string   s;
+    Tally         t;
+    Outcome       out;
+    read_header(in, a, b, s, t, out);
+    EXPECT_TRUE(in.waiting());
+
+    // one byte at a time: each field resumes exactly once
+    for (std::size_t i = 0; i < w.size(); ++i) {
+        EXPECT_FALSE(out.finished);
+        in.feed(w.data() + i, 1);
+    }
+    EXPECT_TRUE(out.finished);
+    EXPECT_FALSE(in.waiting());
+    EXPECT_EQ(t.suspends, 3);
+    EXPECT_EQ(a, 7u);
+    EXPECT_EQ(b, 9);
+    EXPECT_EQ(s, "world");
+}
+
+TEST(AsyncReaderTest, FieldsAcrossArbitraryChunks)
+{
+    std::vector<Order> sent;
+    DynamicWriter stream;
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        Order o{ i, "SYM" + std::to_string(i), std::vector<std::uint16_t>(i % 13, std::uint16_t(i)) };
+        const auto bytes = encode_order(o);
+        stream.write_bytes(bytes.data(), bytes.size());
+        sent.push_back(std::move(o));
+    }
+
+    AsyncReader in(16);
+    std::vector<Order> got;
+    Tally   t;
+    Outcome out;
+    read_orders(in, got, sent.size(), t, out);
+
+    std::size_t off = 0, step = 1;
+    while (off < stream.size()) {
+        const std::size_t n = std::min(step, stream.size() - off);
+        auto buf = in.prepare(n);
+        std::memcpy(buf.data(), stream.data() + off, n);
+        in.commit(n);
+        off += n;
+        step = step % 37 + 3;
+    }
+    ASSERT_FALSE(out.error);
+    ASSERT_TRUE(out.finished);
+    ASSERT_EQ(got.size(), sent.size());
+    for (std::size_t i = 0; i < sent.size(); ++i) {
+        EXPECT_EQ(got[i].id, sent[i].id);
+        EXPECT_EQ(got[i].symbol, sent[i].symbol);
+        EXPECT_EQ(got[i].legs, sent[i].legs);
+    }
+    EXPECT_GT(t.suspends, 0);
+    // the buffer only grew to what was in flight
+    EXPECT_LT(in.capacity(), stream.size());
+}
+
+TEST(AsyncReaderTest, FramesAndEndOfStream)
+{
+    AsyncReader in;
+    std::vector<std::string> frames;
+    Outcome out;
+    read_frames(in, frames, out);
+
+    DynamicWriter w;
+    w.write_sized_string_varint(std::string(300, 'x'));
+    w.write_sized_string_varint("tail");
+    in.feed(w.data(), 1); // half a varint prefix
+    EXPECT_TRUE(frames.empty());
+    in.feed(w.data() + 1, w.size() - 2);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], std::string(300, 'x'));
+    in.feed(w.data() + w.size() - 1, 1);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1], "tail");
+
+    // truncated frame, then the peer goes away
+    in.feed("\x05" "ab", 3);
+    EXPECT_FALSE(out.error);
+    in.close();
+    ASSERT_TRUE(out.error);
+    EXPECT_THROW(std::rethrow_exception(out.error), UnderflowException);
+}
+
+TEST(AsyncReaderTest, ReadAfterCloseThrows)
+{
+    AsyncReader in;
+    in.feed("\x01\x00", 2);
+    in.close();
+
+    std::uint32_t a = 0;
+    std::uint16_t b = 0;
+    std::string   s;
+    Tally   t;
+    Outcome out;
+    task::promise_type::dropped = nullptr;
+    read_header(in, a, b, s, t, out);        // u32 needs 4 bytes, only 2 left
+    EXPECT_FALSE(out.finished);
+    EXPECT_FALSE(in.waiting());
+    ASSERT_TRUE(task::promise_type::dropped);
+    EXPECT_THROW(std::rethrow_exception(task::promise_type::dropped), UnderflowException);
+
+    // a buffered read still completes after close()
+    std::vector<std::string> frames;
+    Outcome fout;
+    AsyncReader late;
+    late.feed("\x02hi", 3);
+    late.close();
+    read_frames(late, frames, fout);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], "hi");
+    ASSERT_TRUE(fout.error);
+    EXPECT_THROW(std::rethrow_exception(fout.error), UnderflowException);
+}
+
+TEST(AsyncReaderTest, BudgetAppliesToFramesAndFields)
+{
+    decode_limits limits;
+    limits.max_string_length = 8;
+    DecodeBudget budget(limits);
+
+    AsyncReader in;
+    in.set_budget(&budget);
+    std::vector<std::string> frames;
+    Outcome out;
+    read_frames(in, frames, out);
+    in.feed("\x40", 1); // 64-byte frame announced: rejected before it arrives
+    ASSERT_TRUE(out.error);
+    EXPECT_THROW(std::rethrow_exception(out.error), LimitException);
+
+    AsyncReader fields;
+    DecodeBudget field_budget(limits);
+    fields.set_budget(&field_budget);
+    std::vector<Order> got;
+    Tally   t;
+    Outcome fout;
+    read_orders(fields, got, 1, t, fout);
+    const auto bytes = encode_order({ 1, "WAY-TOO-LONG", {} });
+    fields.feed(bytes.data(), bytes.size());
+    ASSERT_TRUE(fout.error);
+    EXPECT_THROW(std::rethrow_exception(fout.error), LimitException);
+}
+
+#else
+
+TEST(AsyncReaderTest, RequiresCoroutines)
+{
+    GTEST_SKIP() << "AsyncReader needs C++20 coroutines";
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+// (value, width) pairs covering 1..64-bit fields
+std::vector<std::pair<std::uint64_t, unsigned>> sample_fields(std::size_t count)
+{
+    std::vector<std::pair<std::uint64_t, unsigned>> out;
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < count; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const unsigned w = unsigned(i % 64) + 1;
+        out.emplace_back(x & detail::low_bits_mask(w), w);
+    }
+    return out;
+}
+
+template <bit_order Order>
+void round_trip_fields()
+{
+    const auto fields = sample_fields(1000);
+    DynamicWriter dw;
+    BitWriter<DynamicWriter, Order> bw(dw);
+    std::size_t total = 0;
+    for (const auto& [v, w] : fields) {
+        bw.write_bits(v, w);
+        total += w;
+    }
+    bw.flush();
+    EXPECT_EQ(bw.bit_position(), (total + 7) / 8 * 8);
+    EXPECT_EQ(dw.size(), (total + 7) / 8);
+
+    Reader r(dw.data(), dw.size());
+    BitReader<Reader, Order> br(r);
+    for (const auto& [v, w] : fields) ASSERT_EQ(br.read_bits(w), v) << w;
+    EXPECT_EQ(br.bit_position(), total);
+}
+
+// Overwrite the stack below the caller's frame
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void clobber_stack()
+{
+    volatile unsigned char junk[4096];
+    for (auto& b : junk) b = 0xA5;
+}
+
+} // namespace
+
+TEST(BitStreamTest, MsbFirstLayout)
+{
+    std::vector<std::uint8_t> buffer(8, 0);
+    Writer w(buffer.data(), buffer.size());
+    BitWriter bw(w);
+    bw.write_bits(0b101, 3);
+    bw.write_bits(0b11001, 5);
+    bw.write_bits(0xABC, 12);
+    bw.flush();
+
+    EXPECT_EQ(w.position(), 3u);
+    EXPECT_EQ(buffer[0], 0b10111001);
+    EXPECT_EQ(buffer[1], 0xAB);
+    EXPECT_EQ(buffer[2], 0xC0);
+
+    Reader r(buffer.data(), 3);
+    BitReader br(r);
+    EXPECT_EQ(br.peek_bits(3), 0b101u);
+    EXPECT_EQ(br.read_bits(3), 0b101u);
+    EXPECT_EQ(br.read_bits(5), 0b11001u);
+    EXPECT_EQ(br.read_bits(12), 0xABCu);
+    EXPECT_EQ(br.read_bits(4), 0u);
+    EXPECT_THROW(br.read_bits(1), UnderflowException);
+}
+
+TEST(BitStreamTest, LsbFirstLayout)
+{
+    std::vector<std::uint8_t> buffer(8, 0);
+    Writer w(buffer.data(), buffer.size());
+    BitWriter<Writer, bit_order::lsb_first> bw(w);
+    bw.write_bits(0b101, 3);
+    bw.write_bits(0b11001, 5);
+    bw.write_bits(0xABC, 12);
+    bw.flush();
+
+    EXPECT_EQ(w.position(), 3u);
+    EXPECT_EQ(buffer[0], 0b11001101);
+    EXPECT_EQ(buffer[1], 0xBC);
+    EXPECT_EQ(buffer[2], 0x0A);
+
+    Reader r(buffer.data(), 3);
+    BitReader<Reader, bit_order::lsb_first> br(r);
+    EXPECT_EQ(br.read_bits(3), 0b101u);
+    EXPECT_EQ(br.peek_bits(5), 0b11001u);
+    EXPECT_EQ(br.read_bits(5), 0b11001u);
+    EXPECT_EQ(br.read_bits(12), 0xABCu);
+}
+
+TEST(BitStreamTest, RoundTripAllWidthsMsb) { round_trip_fields<bit_order::msb_first>(); }
+TEST(BitStreamTest, RoundTripAllWidthsLsb) { round_trip_fields<bit_order::lsb_first>(); }
+
+TEST(BitStreamTest, SignedFieldsAndSkip)
+{
+    DynamicWriter dw;
+    BitWriter<DynamicWriter> bw(dw);
+    bw.write_bits(static_cast<std::uint64_t>(-3), 5);
+    bw.write_bits(0x3FF, 10);
+    bw.write_bits(7, 5);
+    bw.write_bits(0xFFFFFFFFFFFFFFFFull, 64);
+    bw.write_bit(true);
+    bw.flush();
+
+    Reader r(dw.data(), dw.size());
+    BitReader br(r);
+    EXPECT_EQ(br.read_signed_bits(5), -3);
+    br.skip_bits(10);
+    EXPECT_EQ(br.read_signed_bits(5), 7);
+    EXPECT_EQ(br.read_signed_bits(64), -1);
+    EXPECT_TRUE(br.read_bit());
+}
+
+TEST(BitStreamTest, AlignmentAndAlignedBytes)
+{
+    DynamicWriter dw;
+    {
+        BitWriter<DynamicWriter> bw(dw);
+        bw.write_bits(1, 1);
+        bw.flush();
+    }
+    dw.write_sized_string_le("payload");
+    {
+        BitWriter<DynamicWriter> bw(dw);
+        bw.write_bits(0x5, 4);
+        bw.flush();
+    }
+
+    Reader r(dw.data(), dw.size());
+    BitReader br(r);
+    EXPECT_EQ(br.read_bits(1), 1u);
+    br.align_to_byte();
+    std::uint8_t len[4];
+    br.read_aligned_bytes(len, sizeof(len));
+    EXPECT_EQ(len[0], 7);
+    char text[7];
+    br.read_aligned_bytes(text, sizeof(text));
+    EXPECT_EQ(std::string(text, 7), "payload");
+    EXPECT_EQ(br.read_bits(4), 0x5u);
+    EXPECT_EQ(br.bit_position(), 8u * dw.size() - 4);
+}
+
+TEST(BitStreamTest, ReaderOverChunkedStream)
+{
+    const auto fields = sample_fields(300);
+    DynamicWriter dw;
+    BitWriter<DynamicWriter, bit_order::lsb_first> bw(dw);
+    for (const auto& [v, w] : fields) bw.write_bits(v, w);
+    bw.flush();
+
+    // 5-byte chunks never offer 8 contiguous bytes: byte-wise refill only
+    std::size_t off = 0;
+    StreamReader sr([&]() -> span<const std::byte> {
+        const std::size_t n = std::min<std::size_t>(5, dw.size() - off);
+        span<const std::byte> s(dw.data() + off, n);
+        off += n;
+        return s;
+    });
+    BitReader<StreamReader, bit_order::lsb_first> br(sr);
+    for (const auto& [v, w] : fields) ASSERT_EQ(br.read_bits(w), v) << w;
+}
+
+TEST(BitStreamTest, GatherSinkGetsCopies)
+{
+    GatherWriter gw(4); // every flush is a reference candidate
+    {
+        BitWriter<GatherWriter> bw(gw);
+        bw.write_bits(0x11223344u, 32);
+        bw.flush();
+    }
+    clobber_stack();
+
+    EXPECT_EQ(gw.inline_size(), 4u);
+    std::vector<std::uint8_t> flat(gw.size());
+    gw.copy_to(flat.data());
+    EXPECT_EQ(flat, (std::vector<std::uint8_t>{ 0x11, 0x22, 0x33, 0x44 }));
+}
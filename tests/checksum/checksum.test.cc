@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+std::vector<std::uint8_t> pattern(std::size_t n)
+{
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    return v;
+}
+
+// Overwrite the stack below the caller's frame
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void clobber_stack()
+{
+    volatile unsigned char junk[4096];
+    for (auto& b : junk) b = 0xA5;
+}
+
+// Write scalars in a frame of their own, so their temporaries are gone afterwards
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void write_scalars(ChecksumWriter<GatherWriter>& cw)
+{
+    cw.write_le<std::uint64_t>(0x1122334455667788ull);
+    cw.write_be<std::uint32_t>(0xCAFEBABEu);
+}
+
+} // namespace
+
+TEST(ChecksumTest, Crc32cKnownVectors)
+{
+    const std::string_view check = "123456789";
+    EXPECT_EQ(crc32c(check.data(), check.size()), 0xE3069283u);
+    EXPECT_EQ(crc32c(nullptr, 0), 0u);
+
+    // RFC 3720 B.4
+    std::uint8_t buf[32] = {};
+    EXPECT_EQ(crc32c(buf, sizeof(buf)), 0x8A9136AAu);
+    for (auto& b : buf) b = 0xFF;
+    EXPECT_EQ(crc32c(buf, sizeof(buf)), 0x62A8AB43u);
+    for (int i = 0; i < 32; ++i) buf[i] = static_cast<std::uint8_t>(i);
+    EXPECT_EQ(crc32c(buf, sizeof(buf)), 0x46DD794Eu);
+}
+
+TEST(ChecksumTest, Crc32cTableMatchesDispatched)
+{
+    const auto data = pattern(1031);
+    for (std::size_t n : { 0u, 1u, 7u, 8u, 9u, 100u, 1031u }) {
+        const std::uint32_t sw = ~detail::crc32c_sw(0xFFFFFFFFu, reinterpret_cast<const std::byte*>(data.data()), n);
+        EXPECT_EQ(crc32c(data.data(), n), sw) << n;
+    }
+}
+
+TEST(ChecksumTest, Xxh64KnownVectors)
+{
+    EXPECT_EQ(xxh64(nullptr, 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(xxh64("abc", 3), 0x44BC2CF5AD770999ull);
+    const std::string_view s = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(xxh64(s.data(), s.size()), 0xFBCEA83C8A378BF1ull);
+}
+
+TEST(ChecksumTest, StreamingMatchesOneShot)
+{
+    const auto data = pattern(300);
+    for (std::size_t split : { 0u, 1u, 5u, 31u, 32u, 33u, 64u, 299u }) {
+        XxHash64 x(42);
+        x.update(data.data(), split);
+        x.update(data.data() + split, data.size() - split);
+        EXPECT_EQ(x.digest(), xxh64(data.data(), data.size(), 42)) << split;
+
+        Crc32c c;
+        c.update(data.data(), split);
+        c.update(data.data() + split, data.size() - split);
+        EXPECT_EQ(c.digest(), crc32c(data.data(), data.size())) << split;
+    }
+
+    XxHash64 x;
+    for (auto b : data) x.update(&b, 1);
+    EXPECT_EQ(x.digest(), xxh64(data.data(), data.size()));
+    x.reset();
+    EXPECT_EQ(x.digest(), xxh64(nullptr, 0));
+}
+
+TEST(ChecksumTest, WriterHashesEverythingWritten)
+{
+    std::vector<std::uint8_t> buffer(256);
+    Writer w(buffer.data(), buffer.size());
+    ChecksumWriter<Writer> cw(w);
+
+    cw.write_le<std::uint32_t>(0xDEADBEEF);
+    cw.write_varint<std::uint64_t>(300);
+    cw.write_sized_string_le("payload");
+    write_field(cw, std::vector<std::uint16_t>{ 1, 2, 3 });
+
+    const std::size_t body = w.position();
+    EXPECT_EQ(cw.covered_bytes(), body);
+    EXPECT_EQ(cw.digest(), crc32c(buffer.data(), body));
+
+    EXPECT_EQ(cw.write_trailer(), crc32c(buffer.data(), body));
+    EXPECT_EQ(w.position(), body + checksum_trailer_size<Crc32c>);
+    EXPECT_EQ(cw.covered_bytes(), 0u);
+}
+
+TEST(ChecksumTest, WriterOverGrowingSink)
+{
+    // claims into DynamicWriter are hashed before the next claim can reallocate
+    DynamicWriter dw(4);
+    ChecksumWriter<DynamicWriter, XxHash64> cw(dw);
+    const auto blob = pattern(5000);
+    for (int i = 0; i < 100; ++i) cw.write_le<std::uint64_t>(std::uint64_t(i) * 0x0101010101ull);
+    cw.write_bytes(blob.data(), blob.size());
+    cw.write_le<std::uint16_t>(7);
+
+    EXPECT_EQ(cw.digest(), xxh64(dw.data(), dw.size()));
+}
+
+TEST(ChecksumTest, WriterKeepsGatherBlobsByReference)
+{
+    GatherWriter gw(64);
+    ChecksumWriter<GatherWriter> cw(gw);
+    const auto blob = pattern(1000);
+    cw.write_le<std::uint32_t>(static_cast<std::uint32_t>(blob.size()));
+    cw.write_bytes(blob.data(), blob.size());
+    cw.write_trailer();
+
+    ASSERT_EQ(gw.segment_count(), 3u);
+    EXPECT_EQ(gw.segments()[1].data(), reinterpret_cast<const std::byte*>(blob.data()));
+
+    std::vector<std::uint8_t> flat(gw.size());
+    gw.copy_to(flat.data());
+    Reader r(flat.data(), flat.size());
+    ChecksumReader<Reader> cr(r);
+    const auto n = cr.read_le<std::uint32_t>();
+    cr.skip(n);
+    EXPECT_NO_THROW(cr.verify_trailer());
+    EXPECT_EQ(r.remaining(), 0u);
+}
+
+TEST(ChecksumTest, WriterCopiesScalarsIntoGatherSink)
+{
+    GatherWriter gw(4); // scalars are all reference candidates
+    ChecksumWriter<GatherWriter> cw(gw);
+    write_scalars(cw);
+    const auto digest = cw.digest();
+    clobber_stack();
+
+    EXPECT_EQ(gw.inline_size(), 12u);
+    std::vector<std::uint8_t> flat(gw.size());
+    gw.copy_to(flat.data());
+    EXPECT_EQ(digest, crc32c(flat.data(), flat.size()));
+    Reader r(flat.data(), flat.size());
+    EXPECT_EQ(r.read_le<std::uint64_t>(), 0x1122334455667788ull);
+    EXPECT_EQ(r.read_be<std::uint32_t>(), 0xCAFEBABEu);
+}
+
+TEST(ChecksumTest, StickySinkAndSource)
+{
+    std::vector<std::uint8_t> buffer(4);
+    NothrowWriter nw(buffer.data(), buffer.size());
+    ChecksumWriter<NothrowWriter> cw(nw);
+    static_assert(detail::sticky_errors<ChecksumWriter<NothrowWriter>>::value);
+    const std::uint32_t words[] = { 1, 2, 3, 4 };
+    cw.write_array_le<std::uint32_t>({ words, 4 }); // too big: refused, nothing hashed
+    EXPECT_FALSE(cw.ok());
+    EXPECT_EQ(nw.error(), errc::overflow);
+    cw.write_le<std::uint16_t>(7);
+    cw.write_bytes("ab", 2);
+    EXPECT_EQ(cw.covered_bytes(), 0u);
+
+    const std::uint8_t short_frame[] = { 1, 2 };
+    NothrowReader nr(short_frame, sizeof(short_frame));
+    ChecksumReader<NothrowReader> cr(nr);
+    EXPECT_EQ(cr.read_le<std::uint32_t>(), 0u);
+    EXPECT_FALSE(cr.ok());
+    EXPECT_EQ(cr.error(), errc::underflow);
+    EXPECT_EQ(cr.covered_bytes(), 0u);
+
+    // a bad trailer is recorded, not thrown
+    std::vector<std::uint8_t> frame(64);
+    Writer w(frame.data(), frame.size());
+    ChecksumWriter<Writer> good(w);
+    good.write_le<std::uint32_t>(5);
+    good.write_trailer();
+    frame[0] ^= 1;
+    NothrowReader corrupt(frame.data(), w.position());
+    ChecksumReader<NothrowReader> check(corrupt);
+    EXPECT_EQ(check.read_le<std::uint32_t>(), 4u);
+    check.verify_trailer();
+    EXPECT_EQ(check.error(), errc::format);
+}
+
+TEST(ChecksumTest, ReaderVerifiesFrames)
+{
+    DynamicWriter dw;
+    ChecksumWriter<DynamicWriter> cw(dw);
+    for (int frame = 0; frame < 3; ++frame) {
+        cw.write_le<std::uint32_t>(frame);
+        cw.write_sized_string_le(std::string(frame * 10, 'x'));
+        cw.write_trailer();
+    }
+
+    Reader r(dw.data(), dw.size());
+    ChecksumReader<Reader> cr(r);
+    for (int frame = 0; frame < 3; ++frame) {
+        EXPECT_EQ(cr.read_le<std::uint32_t>(), std::uint32_t(frame));
+        EXPECT_EQ(cr.read_sized_string_le().size(), std::size_t(frame * 10));
+        EXPECT_NO_THROW(cr.verify_trailer());
+    }
+    EXPECT_EQ(r.remaining(), 0u);
+}
+
+TEST(ChecksumTest, ReaderDetectsCorruption)
+{
+    DynamicWriter dw;
+    ChecksumWriter<DynamicWriter, XxHash64> cw(dw);
+    cw.write_sized_string_le("important bytes");
+    cw.write_trailer();
+
+    std::vector<std::byte> bad(dw.data(), dw.data() + dw.size());
+    bad[6] ^= std::byte{0x01};
+    Reader r(bad.data(), bad.size());
+    ChecksumReader<Reader, XxHash64> cr(r);
+    cr.read_sized_string_le();
+    EXPECT_THROW(cr.verify_trailer(), FormatException);
+
+    // a truncated frame (fewer bytes consumed than were covered) fails too
+    Reader r2(dw.data(), dw.size());
+    ChecksumReader<Reader, XxHash64> cr2(r2);
+    cr2.skip(4);
+    r2.skip(dw.size() - 4 - checksum_trailer_size<XxHash64>);
+    EXPECT_THROW(cr2.verify_trailer(), FormatException);
+}
+
+TEST(ChecksumTest, ReaderOverStreamSource)
+{
+    DynamicWriter dw;
+    ChecksumWriter<DynamicWriter> cw(dw);
+    const auto blob = pattern(777);
+    cw.write_array_le<std::uint8_t>(span<const std::uint8_t>(blob.data(), blob.size()));
+    cw.write_le<double>(2.5);
+    cw.write_trailer();
+
+    // 13-byte chunks so reads straddle chunk boundaries
+    std::size_t off = 0;
+    StreamReader sr([&]() -> span<const std::byte> {
+        const std::size_t n = std::min<std::size_t>(13, dw.size() - off);
+        span<const std::byte> s(dw.data() + off, n);
+        off += n;
+        return s;
+    });
+    ChecksumReader<StreamReader> cr(sr);
+    std::vector<std::uint8_t> got(blob.size());
+    cr.read_bytes(got.data(), got.size());
+    EXPECT_EQ(got, blob);
+    EXPECT_EQ(cr.read_le<double>(), 2.5);
+    EXPECT_NO_THROW(cr.verify_trailer());
+}
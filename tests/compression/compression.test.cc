@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/compression.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+// Byte-level run-length codec: exercises the compressed-block path
+// without an external library
+struct rle_codec {
+    static constexpr std::uint8_t id = 0x7F;
+
+    std::size_t max_compressed_size(std::size_t n) const noexcept { return 2 * n; }
+
+    std::size_t compress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t cap) {
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < n;) {
+            std::size_t run = 1;
+            while (i + run < n && run < 255 && src[i + run] == src[i]) ++run;
+            if (out + 2 > cap) return 0;
+            dst[out++] = std::byte(run);
+            dst[out++] = src[i];
+            i += run;
+        }
+        return out;
+    }
+
+    void decompress(const std::byte* src, std::size_t n, std::byte* dst, std::size_t raw_n) {
+        std::size_t out = 0;
+        for (std::size_t i = 0; i + 1 < n; i += 2) {
+            const std::size_t run = std::size_t(src[i]);
+            if (out + run > raw_n) throw FormatException("rle overflow");
+            std::memset(dst + out, int(src[i + 1]), run);
+            out += run;
+        }
+        if (out != raw_n || n % 2) throw FormatException("rle size mismatch");
+    }
+};
+
+template <typename Sink, typename Codec>
+void write_sample(CompressedWriter<Sink, Codec>& cw, int records)
+{
+    for (int i = 0; i < records; ++i) {
+        cw.template write_le<std::uint32_t>(static_cast<std::uint32_t>(i));
+        cw.write_sized_string_le(std::string(std::size_t(i % 50), 'a'));
+        cw.template write_be<double>(i * 0.5);
+    }
+}
+
+template <typename Codec>
+void read_sample(CompressedReader<Reader, Codec>& cr, int records)
+{
+    for (int i = 0; i < records; ++i) {
+        ASSERT_EQ(cr.template read_le<std::uint32_t>(), static_cast<std::uint32_t>(i));
+        ASSERT_EQ(cr.read_sized_string_le(), std::string(std::size_t(i % 50), 'a'));
+        ASSERT_EQ(cr.template read_be<double>(), i * 0.5);
+    }
+}
+
+} // namespace
+
+TEST(CompressionTest, IdentityRoundTripAcrossBlocks)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter> cw(out, 100);
+    write_sample(cw, 200);
+    const std::size_t raw = cw.position();
+    cw.finish();
+    EXPECT_GT(cw.blocks_written(), 10u);
+    // header + per-block headers + end marker, no compression
+    EXPECT_EQ(out.size(), 9 + raw + 8 * cw.blocks_written() + 4);
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader> cr(in);
+    EXPECT_EQ(cr.block_size(), 100u);
+    read_sample(cr, 200);
+    EXPECT_EQ(cr.position(), raw);
+    EXPECT_TRUE(cr.exhausted());
+    EXPECT_EQ(in.remaining(), 0u);
+    EXPECT_THROW(cr.read_le<std::uint8_t>(), UnderflowException);
+}
+
+TEST(CompressionTest, GatherWriterSinkCopiesEveryBlock)
+{
+    // blocks all go through the same scratch buffer; a sink that keeps
+    // large writes by reference must still see each block's own bytes
+    GatherWriter out(1);
+    CompressedWriter<GatherWriter> cw(out, 100);
+    write_sample(cw, 200);
+    cw.finish();
+    EXPECT_GT(cw.blocks_written(), 10u);
+
+    std::vector<std::byte> flat(out.size());
+    out.copy_to(flat.data());
+    Reader in(flat.data(), flat.size());
+    CompressedReader<Reader> cr(in);
+    read_sample(cr, 200);
+    EXPECT_TRUE(cr.exhausted());
+}
+
+TEST(CompressionTest, CompressedBlocksShrinkAndRoundTrip)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, rle_codec> cw(out, 4096);
+    const std::vector<std::uint8_t> zeros(50000, 0);
+    cw.write_bytes(zeros.data(), zeros.size());
+    write_sample(cw, 100);
+    const std::size_t raw = cw.position();
+    cw.finish();
+    EXPECT_LT(out.size(), raw / 4);
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader, rle_codec> cr(in);
+    std::vector<std::uint8_t> got(zeros.size(), 1);
+    cr.read_bytes(got.data(), got.size());
+    EXPECT_EQ(got, zeros);
+    read_sample(cr, 100);
+    EXPECT_TRUE(cr.exhausted());
+}
+
+TEST(CompressionTest, IncompressibleBlocksAreStored)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, rle_codec> cw(out, 256);
+    std::vector<std::uint8_t> noise(1000);
+    for (std::size_t i = 0; i < noise.size(); ++i) noise[i] = static_cast<std::uint8_t>(i * 7 + 1);
+    cw.write_bytes(noise.data(), noise.size());
+    cw.finish();
+    EXPECT_EQ(out.size(), 9 + noise.size() + 8 * 4 + 4);
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader, rle_codec> cr(in);
+    std::vector<std::uint8_t> got(noise.size());
+    cr.read_bytes(got.data(), got.size());
+    EXPECT_EQ(got, noise);
+}
+
+TEST(CompressionTest, ClaimsLargerThanBlockAndStitchedTakes)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter> cw(out, 64);
+    std::vector<std::uint32_t> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<std::uint32_t>(i * 0x01010101u);
+    cw.write_le<std::uint8_t>(0xAB);
+    cw.write_array_be<std::uint32_t>(span<const std::uint32_t>(values.data(), values.size())); // one 400-byte claim
+    cw.write_le<std::uint16_t>(0x1234);
+    cw.finish();
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader> cr(in);
+    EXPECT_EQ(cr.read_le<std::uint8_t>(), 0xAB);
+    std::vector<std::uint32_t> got(values.size());
+    cr.read_array_be<std::uint32_t>(span<std::uint32_t>(got.data(), got.size())); // stitched across blocks
+    EXPECT_EQ(got, values);
+    EXPECT_EQ(cr.read_le<std::uint16_t>(), 0x1234);
+}
+
+TEST(CompressionTest, SerializationThroughAdapters)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, rle_codec> cw(out, 128);
+    const std::vector<std::string> names{ "alpha", std::string(300, 'b'), "", "gamma" };
+    write_field(cw, names);
+    write_field(cw, std::vector<double>(500, 1.0));
+    cw.finish();
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader, rle_codec> cr(in);
+    EXPECT_EQ(read_field<std::vector<std::string>>(cr), names);
+    EXPECT_EQ(read_field<std::vector<double>>(cr), std::vector<double>(500, 1.0));
+}
+
+TEST(CompressionTest, ReaderOverStreamSource)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, rle_codec> cw(out, 300);
+    write_field(cw, std::vector<std::uint16_t>(2000, 9));
+    cw.finish();
+
+    std::size_t off = 0;
+    StreamReader sr([&]() -> span<const std::byte> {
+        const std::size_t n = std::min<std::size_t>(17, out.size() - off);
+        span<const std::byte> s(out.data() + off, n);
+        off += n;
+        return s;
+    });
+    CompressedReader<StreamReader, rle_codec> cr(sr);
+    EXPECT_EQ(read_field<std::vector<std::uint16_t>>(cr), std::vector<std::uint16_t>(2000, 9));
+    EXPECT_TRUE(cr.exhausted());
+}
+
+TEST(CompressionTest, HeaderBlockSizeIsBounded)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter> cw(out, 1 << 20);
+    cw.write_le<std::uint32_t>(1);
+    cw.finish();
+
+    Reader in(out.data(), out.size());
+    EXPECT_THROW((CompressedReader<Reader>(in, identity_codec(), ScratchPool::shared(), 1 << 16)), FormatException);
+
+    decode_limits limits;
+    limits.max_total_bytes = 1 << 16;
+    DecodeBudget budget(limits);
+    Reader budgeted(out.data(), out.size());
+    budgeted.set_budget(&budget);
+    EXPECT_THROW((CompressedReader<Reader>(budgeted)), LimitException);
+
+    Reader ok(out.data(), out.size());
+    CompressedReader<Reader> cr(ok);
+    EXPECT_EQ(cr.read_le<std::uint32_t>(), 1u);
+}
+
+TEST(CompressionTest, RejectsBadStreams)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, rle_codec> cw(out, 64);
+    cw.write_le<std::uint64_t>(0);
+    cw.finish();
+
+    {
+        Reader in(out.data(), out.size());
+        EXPECT_THROW((CompressedReader<Reader, identity_codec>(in)), FormatException);
+    }
+    {
+        std::vector<std::byte> bad(out.data(), out.data() + out.size());
+        bad[0] ^= std::byte{1};
+        Reader in(bad.data(), bad.size());
+        EXPECT_THROW((CompressedReader<Reader, rle_codec>(in)), FormatException);
+    }
+    {
+        // raw size larger than the declared block size
+        std::vector<std::byte> bad(out.data(), out.data() + out.size());
+        bad[9] = std::byte{0xFF};
+        Reader in(bad.data(), bad.size());
+        CompressedReader<Reader, rle_codec> cr(in);
+        EXPECT_THROW(cr.read_le<std::uint64_t>(), FormatException);
+    }
+    {
+        // truncated before the end marker
+        Reader in(out.data(), out.size() - 4);
+        CompressedReader<Reader, rle_codec> cr(in);
+        EXPECT_EQ(cr.read_le<std::uint64_t>(), 0u);
+        EXPECT_THROW(cr.exhausted(), UnderflowException);
+    }
+}
+
+TEST(CompressionTest, ScratchBuffersAreReused)
+{
+    ScratchPool pool;
+    const std::byte* first = nullptr;
+    {
+        auto a = pool.acquire(1000);
+        first = a.data();
+        EXPECT_GE(a.size(), 1000u);
+    }
+    EXPECT_EQ(pool.cached(), 1u);
+    {
+        auto b = pool.acquire(500);
+        EXPECT_EQ(b.data(), first);
+        EXPECT_EQ(pool.cached(), 0u);
+    }
+
+    DynamicWriter out;
+    {
+        CompressedWriter<DynamicWriter> cw(out, 1024, identity_codec(), pool);
+        cw.write_le<std::uint32_t>(1);
+        cw.finish();
+    }
+    const std::size_t cached = pool.cached();
+    EXPECT_GE(cached, 2u);
+    {
+        CompressedWriter<DynamicWriter> cw(out, 1024, identity_codec(), pool);
+        EXPECT_EQ(pool.cached(), cached - 2);
+    }
+}
+
+#if defined(BYTESTREAM_HAS_LZ4)
+TEST(CompressionTest, Lz4RoundTrip)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, lz4_codec> cw(out, 4096);
+    write_sample(cw, 500);
+    const std::size_t raw = cw.position();
+    cw.finish();
+    EXPECT_LT(out.size(), raw);
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader, lz4_codec> cr(in);
+    read_sample(cr, 500);
+    EXPECT_TRUE(cr.exhausted());
+}
+#endif
+
+#if defined(BYTESTREAM_HAS_ZSTD)
+TEST(CompressionTest, ZstdRoundTrip)
+{
+    DynamicWriter out;
+    CompressedWriter<DynamicWriter, zstd_codec> cw(out, 4096);
+    write_sample(cw, 500);
+    const std::size_t raw = cw.position();
+    cw.finish();
+    EXPECT_LT(out.size(), raw);
+
+    Reader in(out.data(), out.size());
+    CompressedReader<Reader, zstd_codec> cr(in);
+    read_sample(cr, 500);
+    EXPECT_TRUE(cr.exhausted());
+}
+#endif
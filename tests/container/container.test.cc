@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/container.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+std::string record_text(std::size_t i) { return "record-" + std::string(i % 17, '#') + std::to_string(i); }
+
+void write_records(ContainerWriter<DynamicWriter>& cw, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& w = cw.begin_record();
+        w.write_le<std::uint32_t>(static_cast<std::uint32_t>(i));
+        w.write_sized_string_le(record_text(i));
+        cw.end_record();
+    }
+}
+
+void check_records(const ContainerReader& cr, std::size_t count)
+{
+    ASSERT_EQ(cr.size(), count);
+    for (std::size_t i : { std::size_t{0}, count / 2, count - 1, std::size_t{7} }) {
+        Reader r = cr.record(i);
+        EXPECT_EQ(r.read_le<std::uint32_t>(), i);
+        EXPECT_EQ(r.read_sized_string_le(), record_text(i));
+        EXPECT_EQ(r.remaining(), 0u);
+    }
+}
+
+} // namespace
+
+TEST(ContainerTest, PlainTableRandomAccess)
+{
+    DynamicWriter out;
+    ContainerWriter<DynamicWriter> cw(out);
+    write_records(cw, 1000);
+    cw.finish();
+
+    ContainerReader cr(out.data(), out.size());
+    check_records(cr, 1000);
+    // table = 1001 u64 boundaries + trailer
+    EXPECT_EQ(out.size(), cr.records_bytes() + 1001 * 8 + 24);
+    EXPECT_EQ(cr.record_offset(0), 0u);
+    EXPECT_EQ(cr.record_offset(1), cr.record_size(0));
+    EXPECT_THROW(cr.record(1000), std::out_of_range);
+}
+
+TEST(ContainerTest, DeltaVarintTableIsSmaller)
+{
+    DynamicWriter plain_out, delta_out;
+    ContainerWriter<DynamicWriter> plain(plain_out);
+    ContainerWriter<DynamicWriter> delta(delta_out, offset_encoding::delta_varint);
+    write_records(plain, 1000);
+    write_records(delta, 1000);
+    plain.finish();
+    delta.finish();
+
+    EXPECT_LT(delta_out.size() + 6000, plain_out.size());
+    check_records(ContainerReader(delta_out.data(), delta_out.size()), 1000);
+}
+
+TEST(ContainerTest, EmptyAndRawRecords)
+{
+    DynamicWriter out;
+    out.write_le<std::uint32_t>(0xCAFE); // bytes before the container are not part of it
+    ContainerWriter<DynamicWriter> cw(out, offset_encoding::delta_varint);
+    cw.add_record("abc", 3);
+    cw.add_record("", 0);
+    cw.add_record("de", 2);
+    cw.finish();
+
+    ContainerReader cr(out.data() + 4, out.size() - 4);
+    ASSERT_EQ(cr.size(), 3u);
+    EXPECT_EQ(cr[1].size(), 0u);
+    EXPECT_EQ(cr[2].read_string(2), "de");
+
+    DynamicWriter none;
+    ContainerWriter<DynamicWriter> empty(none);
+    empty.finish();
+    EXPECT_TRUE(ContainerReader(none.data(), none.size()).empty());
+}
+
+TEST(ContainerTest, WritesOutsideRecordsAreRejected)
+{
+    DynamicWriter out;
+    ContainerWriter<DynamicWriter> cw(out);
+    cw.add_record("x", 1);
+    out.write_le<std::uint8_t>(1);
+    EXPECT_THROW(cw.begin_record(), FormatException);
+}
+
+TEST(ContainerTest, RejectsCorruptFooters)
+{
+    DynamicWriter out;
+    ContainerWriter<DynamicWriter> cw(out);
+    write_records(cw, 10);
+    cw.finish();
+    const std::vector<std::byte> good(out.data(), out.data() + out.size());
+
+    auto corrupt = [&](std::size_t at_from_end, std::uint8_t value) {
+        std::vector<std::byte> bad = good;
+        bad[bad.size() - at_from_end] = std::byte{value};
+        return bad;
+    };
+
+    EXPECT_THROW(ContainerReader(good.data(), 10), FormatException);
+    { auto b = corrupt(1, 0);    EXPECT_THROW(ContainerReader(b.data(), b.size()), FormatException); } // magic
+    { auto b = corrupt(8, 9);    EXPECT_THROW(ContainerReader(b.data(), b.size()), FormatException); } // encoding
+    { auto b = corrupt(16, 99);  EXPECT_THROW(ContainerReader(b.data(), b.size()), FormatException); } // count
+    { auto b = corrupt(17, 0xFF); EXPECT_THROW(ContainerReader(b.data(), b.size()), FormatException); } // table offset
+
+    // a boundary past the record area fails on lookup
+    std::vector<std::byte> bad = good;
+    ContainerReader ok(good.data(), good.size());
+    bad[ok.records_bytes() + 8 * 3 + 7] = std::byte{0x7F};
+    ContainerReader cr(bad.data(), bad.size());
+    EXPECT_NO_THROW(cr.record(0));
+    EXPECT_THROW(cr.record(3), FormatException);
+}
+
+TEST(ContainerTest, MappedFileRoundTrip)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "bytestream_container_test.bin").string();
+    {
+        MappedFileWriter file(path);
+        ContainerWriter<MappedFileWriter> cw(file, offset_encoding::delta_varint);
+        for (std::size_t i = 0; i < 5000; ++i) {
+            write_field(cw.begin_record(), record_text(i));
+            cw.end_record();
+        }
+        cw.finish();
+        file.close();
+    }
+    {
+        MappedContainer snap(path);
+        ASSERT_EQ(snap.size(), 5000u);
+        auto r = snap.record(4321);
+        EXPECT_EQ(read_field<std::string>(r), record_text(4321));
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
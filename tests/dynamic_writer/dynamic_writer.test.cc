@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+// Allocator that records every allocation it performs
+struct AllocStats {
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+};
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    AllocStats* stats;
+
+    explicit CountingAllocator(AllocStats* s) noexcept : stats(s) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& o) noexcept : stats(o.stats) {}
+
+    T* allocate(std::size_t n) {
+        ++stats->allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) noexcept {
+        ++stats->deallocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& o) const noexcept { return stats == o.stats; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& o) const noexcept { return stats != o.stats; }
+};
+
+} // namespace
+
+TEST(DynamicWriterTest, StartsEmpty)
+{
+    DynamicWriter w;
+
+    EXPECT_EQ(w.size(), 0u);
+    EXPECT_EQ(w.capacity(), 0u);
+    EXPECT_EQ(w.position(), 0u);
+    EXPECT_EQ(w.data(), nullptr);
+}
+
+TEST(DynamicWriterTest, GrowsPastInitialCapacity)
+{
+    DynamicWriter w(8);
+
+    EXPECT_GE(w.capacity(), 8u);
+    for (std::uint32_t i = 0; i < 1000; ++i) w.write_le<std::uint32_t>(i);
+
+    EXPECT_EQ(w.size(), 4000u);
+    EXPECT_GE(w.capacity(), 4000u);
+
+    Reader r = w.as_reader();
+    EXPECT_EQ(r.size(), 4000u);
+    for (std::uint32_t i = 0; i < 1000; ++i) EXPECT_EQ(r.read_le<std::uint32_t>(), i);
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(DynamicWriterTest, MatchesWriterEncoding)
+{
+    std::vector<std::uint8_t> fixed(128, 0);
+    Writer    a(fixed.data(), fixed.size());
+    DynamicWriter b;
+
+    auto encode = [](auto& w) {
+        w.template write_le<std::uint16_t>(0x1234);
+        w.template write_be<std::uint32_t>(0xDEADBEEF);
+        w.write_sized_string_le("hello");
+        w.write_sized_string_be("world");
+        w.write_cstring("c");
+        w.align(8, std::byte{0xEE});
+        w.fill_bytes(std::byte{0x7F}, 3);
+        std::array<std::uint16_t, 3> arr = { { 1, 2, 3 } };
+        w.template write_array_be<std::uint16_t>({ arr.data(), arr.size() });
+    };
+    encode(a);
+    encode(b);
+
+    ASSERT_EQ(a.position(), b.size());
+    EXPECT_EQ(std::memcmp(fixed.data(), b.data(), b.size()), 0);
+}
+
+TEST(DynamicWriterTest, SeekBackPatchesPrefix)
+{
+    DynamicWriter w;
+
+    w.write_le<std::uint32_t>(0); // placeholder
+    w.write_string("payload");
+    const std::size_t end = w.position();
+
+    w.seek(0);
+    w.write_le<std::uint32_t>(static_cast<std::uint32_t>(end - 4));
+    EXPECT_EQ(w.size(), end);
+    w.seek(end);
+
+    Reader r = w.as_reader();
+    EXPECT_EQ(r.read_sized_string_le(), "payload");
+    EXPECT_THROW(w.seek(end + 1), std::out_of_range);
+}
+
+TEST(DynamicWriterTest, ClearKeepsStorage)
+{
+    AllocStats stats;
+    BasicDynamicWriter<CountingAllocator<std::byte>> w(CountingAllocator<std::byte>{&stats});
+
+    for (int msg = 0; msg < 100; ++msg) {
+        w.clear();
+        for (int i = 0; i < 64; ++i) w.write_le<std::uint64_t>(static_cast<std::uint64_t>(msg));
+    }
+    // first message grows the buffer; the other 99 reuse it
+    const std::size_t after_first = stats.allocations;
+    EXPECT_LE(after_first, 4u);
+    w.clear();
+    w.zero_fill(512);
+    EXPECT_EQ(stats.allocations, after_first);
+}
+
+TEST(DynamicWriterTest, MoveTransfersStorage)
+{
+    DynamicWriter a;
+    a.write_sized_string_le("moved");
+    const std::byte* p = a.data();
+
+    DynamicWriter b(std::move(a));
+    EXPECT_EQ(b.data(), p);
+    EXPECT_EQ(a.data(), nullptr);
+    EXPECT_EQ(a.size(), 0u);
+
+    DynamicWriter c;
+    c = std::move(b);
+    Reader r = c.as_reader();
+    EXPECT_EQ(r.read_sized_string_le(), "moved");
+}
+
+#if defined(__cpp_lib_memory_resource)
+TEST(DynamicWriterTest, MonotonicArena)
+{
+    std::array<std::byte, 4096> arena_storage{};
+    std::pmr::monotonic_buffer_resource arena(arena_storage.data(), arena_storage.size(),
+                                              std::pmr::null_memory_resource());
+    PmrDynamicWriter w(256, &arena);
+
+    w.write_sized_string_le("arena-backed");
+    w.write_le<std::uint64_t>(42);
+
+    EXPECT_GE(w.data(), arena_storage.data());
+    EXPECT_LT(w.data(), arena_storage.data() + arena_storage.size());
+
+    Reader r = w.as_reader();
+    EXPECT_EQ(r.read_sized_string_le(), "arena-backed");
+    EXPECT_EQ(r.read_le<std::uint64_t>(), 42u);
+}
+#endif
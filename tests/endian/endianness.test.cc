@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <bytestream/core.hpp>
 #include <cstdint>
+#include <vector>
 
 using namespace bytestream;
 
@@ -24,8 +25,95 @@ TEST(EndiannessTest, ByteswapInt16)
     EXPECT_EQ(byteswap<std::int16_t>(0x1234), 0x3412);
 }
 
+TEST(EndiannessTest, ByteswapBySize)
+{
+    // long long and long are distinct types from the (u)intN_t aliases on some ABIs
+    EXPECT_EQ(byteswap<long long>(0x0102030405060708LL), 0x0807060504030201LL);
+    EXPECT_EQ(byteswap<unsigned long long>(0x0102030405060708ULL), 0x0807060504030201ULL);
+    EXPECT_EQ(byteswap<char16_t>(char16_t(0x1234)), char16_t(0x3412));
+    EXPECT_EQ(byteswap<std::uint8_t>(0xAB), 0xAB);
+
+    enum class Tag : std::uint32_t { a = 0x11223344 };
+    EXPECT_EQ(static_cast<std::uint32_t>(byteswap(Tag::a)), 0x44332211u);
+
+    EXPECT_EQ(byteswap(byteswap(1.5)), 1.5);
+}
+
+#if !defined(_MSC_VER) || defined(__cpp_lib_byteswap)
+static_assert(byteswap<std::uint32_t>(0x12345678u) == 0x78563412u, "constexpr byteswap");
+static_assert(bswap64(0x0123456789ABCDEFULL) == 0xEFCDAB8967452301ULL, "constexpr bswap64");
+#endif
+
+TEST(EndiannessTest, UnalignedLoadsAndStores)
+{
+    unsigned char buf[16] = {};
+    store_be<std::uint32_t>(buf + 1, 0x01020304u);
+    EXPECT_EQ(buf[1], 0x01);
+    EXPECT_EQ(buf[4], 0x04);
+    EXPECT_EQ(load_be<std::uint32_t>(buf + 1), 0x01020304u);
+    EXPECT_EQ(load_le<std::uint32_t>(buf + 1), 0x04030201u);
+
+    store_le<std::uint64_t>(buf + 3, 0x1122334455667788ull);
+    EXPECT_EQ(buf[3], 0x88);
+    EXPECT_EQ(load_le<std::uint64_t>(buf + 3), 0x1122334455667788ull);
+    store_le<double>(buf + 5, -2.25);
+    EXPECT_EQ(load_le<double>(buf + 5), -2.25);
+}
+
 TEST(EndiannessTest, DetectEndianness)
 {
     EXPECT_TRUE(is_little_endian() || is_big_endian());
     EXPECT_FALSE(is_little_endian() && is_big_endian());
 }
+
+// Lengths chosen to hit every SIMD block size plus scalar tails
+template <typename T>
+static void check_bulk_byteswap()
+{
+    for (std::size_t n : { 0u, 1u, 3u, 7u, 8u, 15u, 16u, 17u, 31u, 33u, 64u, 257u }) {
+        std::vector<T> src(n);
+        for (std::size_t i = 0; i < n; ++i) src[i] = static_cast<T>(0x0102030405060708ULL * (i + 1));
+
+        std::vector<T> swapped(n);
+        detail::byteswap_copy<sizeof(T)>(swapped.data(), src.data(), n);
+        for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(swapped[i], byteswap(src[i])) << "n=" << n << " i=" << i;
+    }
+}
+
+TEST(EndiannessTest, BulkByteswapUint16) { check_bulk_byteswap<std::uint16_t>(); }
+TEST(EndiannessTest, BulkByteswapUint32) { check_bulk_byteswap<std::uint32_t>(); }
+TEST(EndiannessTest, BulkByteswapUint64) { check_bulk_byteswap<std::uint64_t>(); }
+
+TEST(EndiannessTest, BulkArrayRoundTripFloat)
+{
+    std::vector<float> src(1000);
+    for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<float>(i) * 0.5f;
+
+    std::vector<std::uint8_t> buf(src.size() * sizeof(float) + 1);
+    Writer w(buf.data(), buf.size());
+    w.write<std::uint8_t>(0xAA); // force an unaligned array start
+    w.write_array_be<float>({src.data(), src.size()});
+
+    Reader r(buf.data(), buf.size());
+    r.skip(1);
+    std::vector<float> out(src.size());
+    r.read_array_be<float>({out.data(), out.size()});
+    EXPECT_EQ(out, src);
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(EndiannessTest, ArraysOfOtherSizesSwapPerElement)
+{
+    // no bulk kernel for sizeof(long double); arrays match the scalar calls
+    const std::vector<long double> src = { 1.5L, -2.25L, 1e300L };
+    DynamicWriter w;
+    w.write_array_be<long double>({ src.data(), src.size() });
+    w.write_array_le<long double>({ src.data(), src.size() });
+
+    Reader r(w.data(), w.size());
+    for (long double v : src) EXPECT_EQ(r.read_be<long double>(), v);
+    std::vector<long double> out(src.size());
+    r.read_array_le<long double>({ out.data(), out.size() });
+    EXPECT_EQ(out, src);
+    EXPECT_TRUE(r.exhausted());
+}
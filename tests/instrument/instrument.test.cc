@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/instrument.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Quote {
+    std::uint32_t id{};
+    std::string   venue;
+    std::vector<std::uint16_t> sizes;
+
+    using bytestream_schema = schema<field_le<&Quote::id>, field<&Quote::venue>, field<&Quote::sizes>>;
+};
+
+} // namespace
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValue) {
+    EXPECT_EQ(LatencyHistogram::bucket_of(0), 0u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(15), 15u);
+    EXPECT_EQ(LatencyHistogram::bucket_of(std::uint64_t(-1)), LatencyHistogram::bucket_count - 1);
+    for (std::size_t i = 0; i < LatencyHistogram::bucket_count; ++i) {
+        const std::uint64_t lo = LatencyHistogram::bucket_lower(i);
+        const std::uint64_t hi = LatencyHistogram::bucket_upper(i);
+        ASSERT_LE(lo, hi);
+        ASSERT_EQ(LatencyHistogram::bucket_of(lo), i);
+        ASSERT_EQ(LatencyHistogram::bucket_of(hi), i);
+        if (i + 1 < LatencyHistogram::bucket_count) {
+            ASSERT_EQ(LatencyHistogram::bucket_lower(i + 1), hi + 1);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketError) {
+    LatencyHistogram h;
+    for (std::uint64_t v = 1; v <= 1000; ++v) h.record(v * 100);
+    const auto s = h.snapshot();
+    EXPECT_EQ(s.count, 1000u);
+    EXPECT_EQ(s.max, 100000u);
+    EXPECT_DOUBLE_EQ(s.mean(), 50050.0);
+    for (double q : { 0.5, 0.9, 0.99 }) {
+        const double exact = q * 100000.0;
+        EXPECT_GE(double(s.percentile(q)), exact);
+        EXPECT_LE(double(s.percentile(q)), exact * 1.125);
+    }
+    EXPECT_EQ(s.percentile(1.0), 100000u);
+
+    h.reset();
+    EXPECT_EQ(h.snapshot().count, 0u);
+    EXPECT_EQ(h.snapshot().percentile(0.5), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreAllKept) {
+    LatencyHistogram h;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&h, t] {
+            for (int i = 0; i < 10000; ++i) h.record(std::uint64_t(t * 10000 + i));
+        });
+    for (auto& t : threads) t.join();
+    const auto s = h.snapshot();
+    EXPECT_EQ(s.count, 40000u);
+    EXPECT_EQ(s.max, 39999u);
+    EXPECT_EQ(s.sum, 40000ull * 39999 / 2);
+}
+
+TEST(LatencyHistogramTest, NamedHistogramsAndScopedTimer) {
+    LatencyHistogram& h = latency_histogram("test: decode quote");
+    EXPECT_EQ(&h, &latency_histogram("test: decode quote"));
+    h.reset();
+    { ScopedTimer t(h); }
+    { ScopedTimer t(h); }
+    EXPECT_EQ(h.count(), 2u);
+
+    bool seen = false;
+    for_each_latency_histogram([&](const std::string& name, const LatencyHistogram& x) {
+        if (name == "test: decode quote") seen = (&x == &h);
+    });
+    EXPECT_TRUE(seen);
+}
+
+#if BYTESTREAM_INSTRUMENT
+
+namespace {
+
+op_counts counts_since(const op_counts& before) {
+    op_counts c = thread_op_counts();
+    c -= before;
+    return c;
+}
+
+} // namespace
+
+TEST(InstrumentTest, CountsEachPrimitiveOnceByFamily) {
+    const op_counts before = thread_op_counts();
+    DynamicWriter w(4);
+    w.write_le<std::uint32_t>(7);
+    w.write_be<std::uint16_t>(9);
+    w.write_varint<std::uint64_t>(300);
+    w.write_sized_string_le("hello");
+    w.write_bytes("xyz", 3);
+
+    Reader r = w.as_reader();
+    EXPECT_EQ(r.read_le<std::uint32_t>(), 7u);
+    EXPECT_EQ(r.read_be<std::uint16_t>(), 9u);
+    EXPECT_EQ(r.read_varint<std::uint64_t>(), 300u);
+    EXPECT_EQ(r.read_sized_string_le(), "hello");
+    char blob[3];
+    r.read_bytes(blob, 3);
+
+    const op_counts c = counts_since(before);
+    EXPECT_EQ(c.ops(op_family::write_fixed), 2u);
+    EXPECT_EQ(c.bytes(op_family::write_fixed), 6u);
+    EXPECT_EQ(c.ops(op_family::write_varint), 1u);
+    EXPECT_EQ(c.bytes(op_family::write_varint), 2u);
+    EXPECT_EQ(c.ops(op_family::write_string), 1u); // the prefix is not a separate write_fixed
+    EXPECT_EQ(c.bytes(op_family::write_string), 5u);
+    EXPECT_EQ(c.ops(op_family::write_bytes), 1u);
+    EXPECT_EQ(c.bytes(op_family::write_bytes), 3u);
+    EXPECT_GE(c.ops(op_family::grow), 1u);
+
+    EXPECT_EQ(c.ops(op_family::read_fixed), 2u);
+    EXPECT_EQ(c.bytes(op_family::read_fixed), 6u);
+    EXPECT_EQ(c.ops(op_family::read_varint), 1u);
+    EXPECT_EQ(c.ops(op_family::read_string), 1u);
+    EXPECT_EQ(c.bytes(op_family::read_string), 5u);
+    EXPECT_EQ(c.ops(op_family::read_bytes), 1u);
+    EXPECT_EQ(c.ops(op_family::underflow), 0u);
+}
+
+TEST(InstrumentTest, VectorsAndFieldsCountContainerAndElements) {
+    const Quote q{ 42, "XNAS", { 1, 2, 3, 4 } };
+    DynamicWriter w;
+    w.reserve(64);
+    op_counts before = thread_op_counts();
+    write_field(w, q);
+    op_counts c = counts_since(before);
+    EXPECT_EQ(c.ops(op_family::write_vector), 1u);
+    EXPECT_EQ(c.bytes(op_family::write_vector), 8u);
+    EXPECT_EQ(c.ops(op_family::write_array), 1u); // memcpy elements in one go
+    EXPECT_EQ(c.ops(op_family::write_string), 1u);
+    EXPECT_EQ(c.ops(op_family::grow), 0u);
+
+    Reader r = w.as_reader();
+    before = thread_op_counts();
+    const Quote back = read_field<Quote>(r);
+    c = counts_since(before);
+    EXPECT_EQ(back.sizes, q.sizes);
+    EXPECT_EQ(c.ops(op_family::read_vector), 1u);
+    EXPECT_EQ(c.bytes(op_family::read_vector), 8u);
+    EXPECT_EQ(c.ops(op_family::read_string), 1u);
+}
+
+TEST(InstrumentTest, CountsUnderflowAndOverflow) {
+    const op_counts before = thread_op_counts();
+    std::byte buf[2]{};
+    Reader r(buf, sizeof(buf));
+    EXPECT_THROW(r.read_le<std::uint32_t>(), UnderflowException);
+    Writer w(buf, sizeof(buf));
+    EXPECT_THROW(w.write_le<std::uint64_t>(1), OverflowException);
+
+    const op_counts c = counts_since(before);
+    EXPECT_EQ(c.ops(op_family::underflow), 1u);
+    EXPECT_EQ(c.bytes(op_family::underflow), 4u);
+    EXPECT_EQ(c.ops(op_family::overflow), 1u);
+    EXPECT_EQ(c.bytes(op_family::overflow), 8u);
+}
+
+TEST(InstrumentTest, TotalsIncludeExitedThreads) {
+    reset_op_counts();
+    std::thread([] {
+        DynamicWriter w;
+        for (int i = 0; i < 100; ++i) w.write_le<std::uint32_t>(std::uint32_t(i));
+    }).join();
+    const op_counts total = total_op_counts();
+    EXPECT_EQ(total.ops(op_family::write_fixed), 100u);
+    EXPECT_EQ(total.bytes(op_family::write_fixed), 400u);
+
+    reset_op_counts();
+    EXPECT_EQ(total_op_counts().ops(op_family::write_fixed), 0u);
+    EXPECT_STREQ(op_family_name(op_family::read_vector), "read_vector");
+}
+
+TEST(InstrumentTest, TimeScopeRecordsIntoNamedHistogram) {
+    LatencyHistogram& h = latency_histogram("test: time scope");
+    h.reset();
+    for (int i = 0; i < 3; ++i) {
+        BYTESTREAM_TIME_SCOPE("test: time scope");
+        DynamicWriter w;
+        write_field(w, Quote{ 1, "ARCX", {} });
+    }
+    EXPECT_EQ(h.count(), 3u);
+}
+
+#else
+
+TEST(InstrumentTest, RequiresInstrumentBuild) {
+    GTEST_SKIP() << "counters need BYTESTREAM_INSTRUMENT=1 (see instrument_test)";
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/mapped_file.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace bytestream;
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override
+    {
+        // unique per run: the same cases run in the combined and per-file
+        // executables, possibly at the same time (ctest -j)
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::random_device rd;
+        const std::uint64_t tag = (std::uint64_t(rd()) << 32) ^ rd() ^
+                                  std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+        path = (std::filesystem::temp_directory_path() /
+                (std::string("bytestream_") + info->name() + "_" + std::to_string(tag) + ".bin")).string();
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+TEST_F(MappedFileTest, ReadsExistingFile)
+{
+    {
+        std::ofstream out(path, std::ios::binary);
+        const std::uint8_t bytes[] = { 0x78, 0x56, 0x34, 0x12, 'h', 'i', 0 };
+        out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+    }
+
+    map_options opts;
+    opts.hint = access_hint::sequential;
+    MappedFile file(path, opts);
+    ASSERT_EQ(file.size(), 7u);
+
+    Reader reader = file.reader();
+    EXPECT_EQ(reader.read_le<std::uint32_t>(), 0x12345678u);
+    EXPECT_EQ(reader.read_cstring(), "hi");
+    EXPECT_TRUE(reader.exhausted());
+
+    Reader tail = file.reader(4, 2);
+    EXPECT_EQ(tail.read_string(2), "hi");
+
+    file.advise(access_hint::willneed, 3, 100); // clamped, unaligned start
+}
+
+TEST_F(MappedFileTest, EmptyAndMissingFiles)
+{
+    { std::ofstream out(path, std::ios::binary); }
+    MappedFile empty(path);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.reader().exhausted());
+
+    EXPECT_THROW(MappedFile(path + ".missing"), std::system_error);
+}
+
+TEST_F(MappedFileTest, WriterGrowsAndTrimsOnClose)
+{
+    const std::size_t count = MappedFileWriter::min_capacity; // forces several remaps
+    {
+        MappedFileWriter writer(path);
+        for (std::size_t i = 0; i < count; ++i) writer.write_le<std::uint32_t>(static_cast<std::uint32_t>(i));
+        writer.write_sized_string_le("end");
+        EXPECT_GE(writer.capacity(), writer.size());
+
+        Reader check = writer.as_reader();
+        EXPECT_EQ(check.read_le<std::uint32_t>(), 0u);
+        writer.flush();
+    } // destructor closes
+
+    EXPECT_EQ(std::filesystem::file_size(path), count * 4 + 4 + 3);
+
+    map_options opts;
+    opts.populate   = true;
+    opts.huge_pages = true;
+    MappedFile file(path, opts);
+    Reader reader = file.reader();
+    for (std::size_t i = 0; i < count; ++i) ASSERT_EQ(reader.read_le<std::uint32_t>(), i);
+    EXPECT_EQ(reader.read_sized_string_le(), "end");
+}
+
+TEST_F(MappedFileTest, WriterSeekAndMove)
+{
+    MappedFileWriter writer(path, 16);
+    writer.write_le<std::uint32_t>(0);
+    writer.write_le<std::uint32_t>(0xCAFEBABE);
+    writer.seek(0);
+    writer.write_le<std::uint32_t>(8); // patch a header after the fact
+    EXPECT_EQ(writer.size(), 8u);
+    EXPECT_THROW(writer.seek(9), std::out_of_range);
+
+    MappedFileWriter moved(std::move(writer));
+    EXPECT_FALSE(writer.is_open());
+    moved.close();
+    EXPECT_FALSE(moved.is_open());
+
+    MappedFile file(path);
+    Reader reader = file.reader();
+    EXPECT_EQ(reader.read_le<std::uint32_t>(), 8u);
+    EXPECT_EQ(reader.read_le<std::uint32_t>(), 0xCAFEBABEu);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST_F(MappedFileTest, SerializesIntoFile)
+{
+    const std::vector<std::uint64_t> ids = { 1, 2, 3, 5, 8 };
+    {
+        MappedFileWriter writer(path);
+        write_fields(writer, std::string("ids"), ids);
+    }
+    MappedFile file(path);
+    Reader reader = file.reader();
+    EXPECT_EQ(read_field<std::string>(reader), "ids");
+    EXPECT_EQ(read_vector<std::uint64_t>(reader), ids);
+}
+
+TEST_F(MappedFileTest, FailedGrowthKeepsMapping)
+{
+    MappedFileWriter writer(path, 16);
+    writer.write_le<std::uint32_t>(0xCAFEBABE);
+    const std::size_t cap = writer.capacity();
+    // far past any address space: either the resize or the map fails
+    EXPECT_THROW(writer.reserve(std::size_t(1) << 62), std::system_error);
+    EXPECT_EQ(writer.capacity(), cap);
+    EXPECT_EQ(writer.size(), 4u);
+    writer.write_le<std::uint32_t>(8);
+    writer.close();
+
+    MappedFile file(path);
+    Reader reader = file.reader();
+    EXPECT_EQ(reader.read_le<std::uint32_t>(), 0xCAFEBABEu);
+    EXPECT_EQ(reader.read_le<std::uint32_t>(), 8u);
+    EXPECT_TRUE(reader.exhausted());
+}
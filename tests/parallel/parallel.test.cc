@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/parallel.hpp>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Event {
+    std::uint32_t id{};
+    std::string   name;
+};
+
+DynamicWriter make_archive(std::size_t count)
+{
+    DynamicWriter out;
+    DynamicWriter rec;
+    for (std::size_t i = 0; i < count; ++i) {
+        rec.clear();
+        rec.write_le<std::uint32_t>(static_cast<std::uint32_t>(i));
+        rec.write_sized_string_le("event-" + std::to_string(i));
+        out.write_sized_string_le({ reinterpret_cast<const char*>(rec.data()), rec.size() });
+    }
+    return out;
+}
+
+Event decode_event(Reader& r)
+{
+    Event e;
+    e.id   = r.read_le<std::uint32_t>();
+    e.name = r.read_sized_string_le();
+    return e;
+}
+
+} // namespace
+
+TEST(ParallelTest, IndexScansPrefixesOnly)
+{
+    DynamicWriter out;
+    out.write_sized_string_le("abc");
+    out.write_sized_string_le("");
+    out.write_sized_string_le("hello");
+
+    const auto index = index_records(out.data(), out.size());
+    ASSERT_EQ(index.size(), 3u);
+    EXPECT_EQ(index[0].offset, 4u);
+    EXPECT_EQ(index[0].size, 3u);
+    EXPECT_EQ(index[1].offset, 11u);
+    EXPECT_EQ(index[1].size, 0u);
+    EXPECT_EQ(index[2].offset, 15u);
+    EXPECT_EQ(index[2].size, 5u);
+
+    DynamicWriter v;
+    v.write_sized_string_varint(std::string(200, 'x'));
+    v.write_sized_string_varint("y");
+    const auto vindex = index_records<length_prefix::varint>(v.data(), v.size());
+    ASSERT_EQ(vindex.size(), 2u);
+    EXPECT_EQ(vindex[0].offset, 2u);
+    EXPECT_EQ(vindex[1].offset, 203u);
+
+    EXPECT_THROW(index_records(out.data(), out.size() - 1), UnderflowException);
+}
+
+TEST(ParallelTest, DecodeKeepsRecordOrder)
+{
+    const auto archive = make_archive(5000);
+    const Reader src(archive.data(), archive.size());
+    const auto index = index_records(archive.data(), archive.size());
+    ASSERT_EQ(index.size(), 5000u);
+
+    parallel_options opt;
+    opt.threads = 8;
+    opt.min_records_per_thread = 16;
+    const auto events = parallel_decode(src, index, decode_event, opt);
+    ASSERT_EQ(events.size(), 5000u);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        ASSERT_EQ(events[i].id, i);
+        ASSERT_EQ(events[i].name, "event-" + std::to_string(i));
+    }
+
+    // single-threaded fallback returns the same thing
+    opt.threads = 1;
+    const auto serial = parallel_decode(src, index, decode_event, opt);
+    ASSERT_EQ(serial.size(), events.size());
+    EXPECT_EQ(serial.back().name, events.back().name);
+}
+
+TEST(ParallelTest, ForRecordsVisitsEveryRecordOnce)
+{
+    const auto archive = make_archive(3000);
+    const Reader src(archive.data(), archive.size());
+    const auto index = index_records(archive.data(), archive.size());
+
+    std::vector<std::atomic<int>> seen(index.size());
+    std::atomic<std::uint64_t> id_sum{0};
+    parallel_options opt;
+    opt.threads = 4;
+    opt.min_records_per_thread = 1;
+    parallel_for_records(src, index, [&](std::size_t i, Reader& rec) {
+        seen[i].fetch_add(1);
+        id_sum += rec.read_le<std::uint32_t>();
+    }, opt);
+
+    for (const auto& s : seen) ASSERT_EQ(s.load(), 1);
+    EXPECT_EQ(id_sum.load(), 3000ull * 2999ull / 2);
+}
+
+TEST(ParallelTest, DecoderExceptionsPropagate)
+{
+    const auto archive = make_archive(1000);
+    const Reader src(archive.data(), archive.size());
+    const auto index = index_records(archive.data(), archive.size());
+
+    parallel_options opt;
+    opt.threads = 4;
+    opt.min_records_per_thread = 1;
+    EXPECT_THROW(parallel_decode(src, index, [](Reader& r) {
+        const Event e = decode_event(r);
+        if (e.id == 777) throw FormatException("bad record");
+        return e;
+    }, opt), FormatException);
+
+    // reading past a record's subview underflows inside that record only
+    EXPECT_THROW(parallel_decode(src, index, [](Reader& r) {
+        decode_event(r);
+        return r.read_le<std::uint8_t>();
+    }, opt), UnderflowException);
+}
+
+TEST(ParallelTest, SourceBudgetIsNotShared)
+{
+    const auto archive = make_archive(2000);
+    Reader src(archive.data(), archive.size());
+    decode_limits limits;
+    limits.max_string_length = 8; // "event-N" fits only for N < 10
+    DecodeBudget budget(limits);
+    src.set_budget(&budget);
+    const auto index = index_records(archive.data(), archive.size());
+
+    parallel_options opt;
+    opt.threads = 4;
+    opt.min_records_per_thread = 1;
+    std::atomic<int> budgeted{0};
+    const auto events = parallel_decode(src, index, [&](Reader& rec) {
+        if (rec.budget()) ++budgeted;
+        return decode_event(rec);
+    }, opt);
+    EXPECT_EQ(budgeted.load(), 0);
+    ASSERT_EQ(events.size(), 2000u);
+    EXPECT_EQ(events.back().name, "event-1999");
+    EXPECT_EQ(budget.allocated(), 0u);
+
+    parallel_for_records(src, index, [&](std::size_t, Reader& rec) {
+        if (rec.budget()) ++budgeted;
+    }, opt);
+    EXPECT_EQ(budgeted.load(), 0);
+}
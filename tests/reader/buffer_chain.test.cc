@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Envelope {
+    std::uint32_t id{};
+    std::string   route;
+    std::vector<std::uint16_t> hops;
+
+    using bytestream_schema = schema<field_le<&Envelope::id>, field<&Envelope::route>, field<&Envelope::hops>>;
+};
+
+span<const std::byte> bytes_of(const std::string& s) {
+    return { reinterpret_cast<const std::byte*>(s.data()), s.size() };
+}
+
+} // namespace
+
+TEST(BufferChainTest, AppendsWritersByReference) {
+    std::array<std::byte, 64> head{};
+    Writer h(head.data(), head.size());
+    h.write_le<std::uint32_t>(7);
+    DynamicWriter tail;
+    tail.write_be<std::uint16_t>(0xBEEF);
+
+    const std::string body = "payload";
+    BufferChain chain;
+    chain.append(h);
+    chain.append(bytes_of(body));
+    chain.append(span<const std::byte>{}); // dropped
+    chain.append(tail);
+
+    ASSERT_EQ(chain.segment_count(), 3u);
+    EXPECT_EQ(chain.size(), 4u + body.size() + 2u);
+    EXPECT_EQ(chain.segment(0).data(), head.data());
+    EXPECT_EQ(reinterpret_cast<const char*>(chain.segment(1).data()), body.data());
+
+    std::vector<std::byte> flat(chain.size());
+    chain.copy_to(flat.data());
+    Reader r(flat.data(), flat.size());
+    EXPECT_EQ(r.read_le<std::uint32_t>(), 7u);
+    EXPECT_EQ(r.read_string(body.size()), body);
+    EXPECT_EQ(r.read_be<std::uint16_t>(), 0xBEEF);
+}
+
+TEST(BufferChainTest, FieldsAcrossSegmentBoundaries) {
+    DynamicWriter w;
+    w.write_le<std::uint64_t>(0x0102030405060708ull);
+    w.write_varint<std::uint32_t>(300);
+    w.write_sized_string_le("crosses");
+    w.write_le<double>(2.5);
+    const span<const std::byte> all = w.view();
+
+    // split everywhere
+    for (std::size_t a = 0; a <= all.size(); ++a) {
+        for (std::size_t b = a; b <= all.size(); b += 3) {
+            BufferChain chain;
+            chain.append(all.data(), a);
+            chain.append(all.data() + a, b - a);
+            chain.append(all.data() + b, all.size() - b);
+            ChainReader r = chain.as_reader();
+            ASSERT_EQ(r.read_le<std::uint64_t>(), 0x0102030405060708ull) << a << "/" << b;
+            ASSERT_EQ(r.read_varint<std::uint32_t>(), 300u);
+            ASSERT_EQ(r.read_sized_string_le(), "crosses");
+            ASSERT_EQ(r.read_le<double>(), 2.5);
+            ASSERT_TRUE(r.exhausted());
+            ASSERT_EQ(r.position(), all.size());
+        }
+    }
+}
+
+TEST(BufferChainTest, ReadFieldOverHeaderAndBody) {
+    const Envelope e{ 9, "edge-1/core-3", { 1, 2, 3 } };
+    DynamicWriter body;
+    write_field(body, e);
+
+    std::array<std::byte, 8> head{};
+    Writer h(head.data(), head.size());
+    h.write_le<std::uint32_t>(static_cast<std::uint32_t>(body.size()));
+
+    BufferChain msg;
+    msg.append(h);
+    msg.append(body);
+    ChainReader r = msg.as_reader();
+    EXPECT_EQ(r.read_le<std::uint32_t>(), body.size());
+    const Envelope back = read_field<Envelope>(r);
+    EXPECT_EQ(back.id, e.id);
+    EXPECT_EQ(back.route, e.route);
+    EXPECT_EQ(back.hops, e.hops);
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(BufferChainTest, UnderflowLeavesCursor) {
+    const std::string a = "ab", b = "c";
+    BufferChain chain;
+    chain.append(bytes_of(a));
+    chain.append(bytes_of(b));
+    ChainReader r = chain.as_reader();
+    r.skip(1);
+    EXPECT_THROW(r.read_le<std::uint32_t>(), UnderflowException);
+    EXPECT_EQ(r.position(), 1u);
+    EXPECT_EQ(r.remaining(), 2u);
+    char out[2];
+    r.read_bytes(out, 2);
+    EXPECT_EQ(std::string(out, 2), "bc");
+    EXPECT_THROW(r.skip(1), UnderflowException);
+
+    r.rewind();
+    EXPECT_EQ(r.position(), 0u);
+    EXPECT_EQ(r.read_string(3), "abc");
+}
+
+TEST(BufferChainTest, TakeAtBoundaryPointsIntoNextSegment) {
+    const std::string a = "head", b = "body";
+    BufferChain chain;
+    chain.append(bytes_of(a));
+    chain.append(bytes_of(b));
+    ChainReader r = chain.as_reader();
+    r.skip(4);
+    EXPECT_EQ(reinterpret_cast<const char*>(r.take(4)), b.data()); // no stitching copy
+}
+
+TEST(BufferChainTest, GatherWriterSegmentsAndNestedChains) {
+    const std::string big(5000, 'z');
+    GatherWriter g(1024);
+    g.write_le<std::uint16_t>(3);
+    g.write_sized_string_le(big);
+
+    BufferChain inner;
+    inner.append(g);
+    BufferChain outer;
+    outer.append(inner);
+    outer.append(inner);
+    EXPECT_EQ(outer.size(), 2 * g.size());
+    EXPECT_EQ(outer.segment_count(), 2 * g.segment_count());
+
+    ChainReader r = outer.as_reader();
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(r.read_le<std::uint16_t>(), 3u);
+        EXPECT_EQ(r.read_sized_string_le(), big);
+    }
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(WriterWrittenViewTest, AsReaderStopsAtCursor) {
+    std::array<std::byte, 32> buf{};
+    Writer w(buf.data(), buf.size());
+    w.write_le<std::uint16_t>(5);
+    EXPECT_EQ(w.as_reader().size(), 2u);
+    EXPECT_EQ(w.written_view().data(), buf.data());
+    EXPECT_EQ(w.written_view().size(), 2u);
+
+    NothrowWriter n(buf.data(), buf.size());
+    n.write_le<std::uint32_t>(1);
+    EXPECT_EQ(n.written_view().size(), 4u);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// No EXPECT_THROW here: nothrow_reader_test builds this file with
+// exceptions disabled where the compiler allows it.
+
+using namespace bytestream;
+
+namespace {
+
+struct Order {
+    std::uint64_t id{};
+    std::uint32_t qty{};
+    std::string   symbol;
+    std::vector<std::uint16_t> legs;
+
+    using bytestream_schema = schema<field_le<&Order::id>, field_le<&Order::qty>,
+                                     field<&Order::symbol>, field<&Order::legs>>;
+};
+
+bool operator==(const Order& a, const Order& b) {
+    return a.id == b.id && a.qty == b.qty && a.symbol == b.symbol && a.legs == b.legs;
+}
+
+std::vector<std::byte> encode(const Order& o) {
+    DynamicWriter w;
+    write_field(w, o);
+    return { w.data(), w.data() + w.size() };
+}
+
+const Order sample{ 77, 500, "MSFT", { 1, 2, 3 } };
+
+} // namespace
+
+TEST(NothrowReaderTest, DecodesLikeReader) {
+    const auto bytes = encode(sample);
+    NothrowReader r(bytes.data(), bytes.size());
+    EXPECT_EQ(read_field<Order>(r), sample);
+    EXPECT_TRUE(r.ok());
+    EXPECT_EQ(r.error(), errc::ok);
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(NothrowReaderTest, UnderflowIsStickyAndReadsZeros) {
+    const std::array<std::uint8_t, 3> buf{ 1, 2, 3 };
+    NothrowReader r(buf.data(), buf.size());
+    EXPECT_EQ(r.read_le<std::uint16_t>(), 0x0201u);
+    EXPECT_EQ(r.read_le<std::uint32_t>(), 0u);
+    EXPECT_FALSE(r);
+    EXPECT_EQ(r.error(), errc::underflow);
+    EXPECT_TRUE(r.exhausted());
+
+    // everything after the first error is inert
+    EXPECT_EQ(r.read<std::uint8_t>(), 0u);
+    EXPECT_EQ(r.read_string(2), "");
+    EXPECT_EQ(r.view_bytes(1).size(), 0u);
+    std::array<std::uint32_t, 2> out{ 9, 9 };
+    r.read_array_le(span<std::uint32_t>(out.data(), out.size()));
+    EXPECT_EQ(out[0], 0u);
+    EXPECT_EQ(r.error(), errc::underflow);
+}
+
+TEST(NothrowReaderTest, TruncatedRecordAtEveryLength) {
+    const auto bytes = encode(sample);
+    for (std::size_t n = 0; n < bytes.size(); ++n) {
+        NothrowReader r(bytes.data(), n);
+        (void)read_field<Order>(r);
+        EXPECT_EQ(r.error(), errc::underflow) << "length " << n;
+    }
+}
+
+TEST(NothrowReaderTest, MalformedVarint) {
+    std::array<std::uint8_t, 12> buf;
+    buf.fill(0xFF);
+    NothrowReader r(buf.data(), buf.size());
+    EXPECT_EQ(r.read_varint<std::uint64_t>(), 0u);
+    EXPECT_EQ(r.error(), errc::format);
+
+    const std::array<std::uint8_t, 5> big{ 0x80, 0x80, 0x80, 0x80, 0x10 }; // 2^32
+    NothrowReader r32(big.data(), big.size());
+    EXPECT_EQ(r32.read_varint<std::uint32_t>(), 0u);
+    EXPECT_EQ(r32.error(), errc::format);
+}
+
+TEST(NothrowReaderTest, BudgetLimitsBecomeErrc) {
+    const auto bytes = encode(sample);
+    decode_limits limits;
+    limits.max_string_length = 2;
+    DecodeBudget budget(limits);
+    NothrowReader r(bytes.data(), bytes.size());
+    r.set_budget(&budget);
+    const Order o = read_field<Order>(r);
+    EXPECT_EQ(r.error(), errc::limit);
+    EXPECT_TRUE(o.symbol.empty());
+    EXPECT_TRUE(o.legs.empty());
+
+    limits = {};
+    limits.max_depth = 0;
+    DecodeBudget shallow(limits);
+    NothrowReader d(bytes.data(), bytes.size());
+    d.set_budget(&shallow);
+    (void)read_field<Order>(d);
+    EXPECT_EQ(d.error(), errc::limit);
+    EXPECT_EQ(shallow.depth(), 0u);
+}
+
+TEST(NothrowReaderTest, SeekAndMisalignedView) {
+    alignas(8) std::array<std::uint8_t, 16> buf{};
+    NothrowReader r(buf.data(), buf.size());
+    r.seek(1);
+    EXPECT_TRUE(r.view_array<std::uint32_t>(2).size() == 0);
+    EXPECT_EQ(r.error(), errc::alignment);
+
+    NothrowReader s(buf.data(), buf.size());
+    s.seek(17);
+    EXPECT_EQ(s.error(), errc::out_of_range);
+}
+
+TEST(NothrowWriterTest, OverflowIsStickyAndStoresNothing) {
+    std::array<std::uint8_t, 6> buf{};
+    NothrowWriter w(buf.data(), buf.size());
+    w.write_le<std::uint32_t>(0x04030201u);
+    w.write_le<std::uint32_t>(0xFFFFFFFFu);
+    EXPECT_FALSE(w);
+    EXPECT_EQ(w.error(), errc::overflow);
+    w.write_le<std::uint8_t>(0xFF);      // fits, but the writer has failed
+    w.write_varint<std::uint32_t>(300);
+    EXPECT_EQ(w.written_bytes(), 4u);
+    EXPECT_EQ(buf[4], 0u);
+    EXPECT_EQ(buf[5], 0u);
+}
+
+TEST(NothrowWriterTest, EncodesLikeWriter) {
+    const auto expected = encode(sample);
+    std::vector<std::byte> buf(expected.size());
+    NothrowWriter w(buf.data(), buf.size());
+    write_field(w, sample);
+    EXPECT_TRUE(w.ok());
+    EXPECT_EQ(buf, expected);
+
+    NothrowWriter small(buf.data(), buf.size() - 1);
+    write_field(small, sample);
+    EXPECT_EQ(small.error(), errc::overflow);
+}
+
+TEST(ResultTest, TryReadFieldAdvancesOnlyOnSuccess) {
+    auto bytes = encode(sample);
+    const auto second = encode(Order{ 1, 2, "AAPL", {} });
+    bytes.insert(bytes.end(), second.begin(), second.end());
+
+    Reader r(bytes.data(), bytes.size());
+    result<Order> a = try_read_field<Order>(r);
+    ASSERT_TRUE(a);
+    EXPECT_EQ(*a, sample);
+    EXPECT_EQ(r.position(), bytes.size() - second.size());
+    EXPECT_EQ(try_read_field<Order>(r).value().symbol, "AAPL");
+    EXPECT_TRUE(r.exhausted());
+
+    Reader shorter(bytes.data(), 5);
+    const result<Order> b = try_read_field<Order>(shorter);
+    EXPECT_FALSE(b);
+    EXPECT_EQ(b.error(), errc::underflow);
+    EXPECT_EQ(shorter.position(), 0u);
+    EXPECT_EQ(b.value_or(Order{ 9, 0, "", {} }).id, 9u);
+}
+
+TEST(ResultTest, TryWriteFieldAdvancesOnlyOnSuccess) {
+    const auto expected = encode(sample);
+    std::vector<std::byte> buf(expected.size() + 4);
+    Writer w(buf.data(), buf.size());
+    EXPECT_EQ(try_write_field(w, sample), errc::ok);
+    EXPECT_EQ(w.position(), expected.size());
+    EXPECT_EQ(try_write_field(w, sample), errc::overflow);
+    EXPECT_EQ(w.position(), expected.size());
+    EXPECT_STREQ(errc_message(errc::overflow), "overflow");
+}
@@ -286,6 +286,39 @@ TEST_F(ReaderTest, ReadArrayLE)
     EXPECT_EQ(dest[1], 0x5678);
 }
 
+TEST_F(ReaderTest, ReadArrayBEUnderflowLeavesPosition)
+{
+    Reader reader(buffer.data(), 7);
+    std::array<std::uint32_t, 2> dest{};
+    EXPECT_THROW(reader.read_array_be(bytestream::span<std::uint32_t>(dest.data(), dest.size())),
+                 UnderflowException);
+    EXPECT_EQ(reader.position(), 0);
+}
+
+TEST_F(ReaderTest, UncheckedFrame)
+{
+    buffer[0] = 0x01;
+    buffer[1] = 0x00; buffer[2] = 0x02;
+    buffer[3] = 0x00; buffer[4] = 0x00; buffer[5] = 0x00; buffer[6] = 0x03;
+    Reader reader(buffer.data(), buffer.size());
+
+    UncheckedReader frame = reader.unchecked(7);
+    EXPECT_EQ(reader.position(), 7);
+    EXPECT_EQ(frame.size(), 7);
+    EXPECT_EQ(frame.read<std::uint8_t>(), 0x01);
+    EXPECT_EQ(frame.read_be<std::uint16_t>(), 0x0002);
+    EXPECT_EQ(frame.read_be<std::uint32_t>(), 0x00000003u);
+    EXPECT_TRUE(frame.exhausted());
+}
+
+TEST_F(ReaderTest, UncheckedFrameValidatesOnce)
+{
+    Reader reader(buffer.data(), 6);
+
+    EXPECT_THROW(reader.unchecked(7), UnderflowException);
+    EXPECT_EQ(reader.position(), 0);
+}
+
 TEST_F(ReaderTest, ReadString)
 {
     std::string s = "Hello, World!";
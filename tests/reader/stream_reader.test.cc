@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+// Hands out `data` in chunks of `chunk` bytes
+struct Chunker {
+    const std::vector<std::byte>& data;
+    std::size_t                   chunk;
+    std::size_t                   pos   = 0;
+    std::size_t                   calls = 0;
+
+    span<const std::byte> operator()()
+    {
+        ++calls;
+        const std::size_t n = std::min(chunk, data.size() - pos);
+        span<const std::byte> s{ data.data() + pos, n };
+        pos += n;
+        return s;
+    }
+};
+
+std::vector<std::byte> sample_message()
+{
+    DynamicWriter w;
+    w.write_le<std::uint64_t>(0x1122334455667788ull);
+    w.write_be<std::uint32_t>(0xCAFEBABE);
+    w.write_varint<std::uint64_t>(1ull << 40);
+    w.write_sized_string_le("stream");
+    w.write_le<std::uint16_t>(0xBEEF);
+    const auto v = w.view();
+    return { v.data(), v.data() + v.size() };
+}
+
+template <typename R>
+void expect_sample(R& r)
+{
+    EXPECT_EQ(r.template read_le<std::uint64_t>(), 0x1122334455667788ull);
+    EXPECT_EQ(r.template read_be<std::uint32_t>(), 0xCAFEBABEu);
+    EXPECT_EQ(r.template read_varint<std::uint64_t>(), 1ull << 40);
+    EXPECT_EQ(r.read_sized_string_le(), "stream");
+    EXPECT_EQ(r.template read_le<std::uint16_t>(), 0xBEEF);
+}
+
+} // namespace
+
+TEST(StreamReaderTest, FieldsAcrossEveryChunkSize)
+{
+    const auto msg = sample_message();
+    for (std::size_t chunk = 1; chunk <= msg.size(); ++chunk) {
+        Chunker source{ msg, chunk };
+        StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+        expect_sample(reader);
+        EXPECT_EQ(reader.position(), msg.size()) << "chunk=" << chunk;
+        EXPECT_TRUE(reader.exhausted());
+    }
+}
+
+TEST(StreamReaderTest, WholeMessageInOneChunk)
+{
+    const auto msg = sample_message();
+    Chunker source{ msg, msg.size() };
+    StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+    expect_sample(reader);
+    EXPECT_EQ(source.calls, 1u); // no refill until the end is probed
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST(StreamReaderTest, PullSource)
+{
+    const auto msg = sample_message();
+    std::size_t pos = 0;
+    StreamReader reader(
+        StreamReader::pull_source([&](span<std::byte> buf) {
+            const std::size_t n = std::min(buf.size(), msg.size() - pos);
+            std::copy_n(msg.data() + pos, n, buf.data());
+            pos += n;
+            return n;
+        }),
+        3);
+    expect_sample(reader);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST(StreamReaderTest, BulkReadsAndSkips)
+{
+    std::vector<std::byte> data(1000);
+    for (std::size_t i = 0; i < data.size(); ++i) data[i] = std::byte(i & 0xFF);
+    Chunker source{ data, 64 };
+    StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+
+    reader.skip(10);
+    std::vector<std::uint8_t> out(500);
+    reader.read_bytes(out.data(), out.size());
+    EXPECT_EQ(out[0], 10);
+    EXPECT_EQ(out[499], (509 & 0xFF));
+
+    std::vector<std::uint16_t> words(5);
+    reader.read_array_le<std::uint16_t>({ words.data(), words.size() });
+    EXPECT_EQ(words[0], 0xFFFE); // bytes 510, 511 mod 256
+    EXPECT_EQ(reader.position(), 520u);
+}
+
+TEST(StreamReaderTest, UnderflowAtEnd)
+{
+    const auto msg = sample_message();
+    Chunker source{ msg, 5 };
+    StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+    reader.skip(msg.size() - 1);
+    EXPECT_THROW(reader.read_le<std::uint32_t>(), UnderflowException);
+
+    Chunker empty_source{ msg, 0 };
+    StreamReader empty(StreamReader::chunk_source(std::ref(empty_source)));
+    EXPECT_TRUE(empty.exhausted());
+    EXPECT_THROW(empty.read<std::uint8_t>(), UnderflowException);
+}
+
+TEST(StreamReaderTest, HostileViewLengthAcrossChunks)
+{
+    DynamicWriter w;
+    w.write_le<std::uint32_t>(0xFFFFFFF0u);
+    w.write_string("short");
+    const auto v = w.view();
+    const std::vector<std::byte> msg(v.data(), v.data() + v.size());
+
+    // the stitch buffer grows only as far as bytes arrive
+    Chunker source{ msg, 3 };
+    StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+    EXPECT_THROW(reader.view_sized_string_le(), UnderflowException);
+
+    // with a budget the length is refused before anything is copied
+    decode_limits limits;
+    limits.max_total_bytes = 1024;
+    DecodeBudget budget(limits);
+    Chunker limited_source{ msg, 3 };
+    StreamReader limited(StreamReader::chunk_source(std::ref(limited_source)));
+    limited.set_budget(&budget);
+    EXPECT_THROW(limited.view_sized_string_le(), LimitException);
+    EXPECT_EQ(limited_source.calls, 2u); // no pulls past the length
+}
+
+TEST(StreamReaderTest, SerializationAndPackedArrays)
+{
+    std::vector<std::uint32_t> ids(100);
+    for (std::size_t i = 0; i < ids.size(); ++i) ids[i] = std::uint32_t(i * i * 977);
+
+    DynamicWriter w;
+    write_fields(w, std::string("ids"), ids);
+    w.write_packed_u32_array({ ids.data(), ids.size() }, packed_coding::delta);
+    const auto v = w.view();
+    const std::vector<std::byte> msg(v.data(), v.data() + v.size());
+
+    Chunker source{ msg, 7 };
+    StreamReader reader(StreamReader::chunk_source(std::ref(source)));
+    EXPECT_EQ(read_field<std::string>(reader), "ids");
+    EXPECT_EQ(read_vector<std::uint32_t>(reader), ids);
+    std::vector<std::uint32_t> out(ids.size());
+    reader.read_packed_u32_array({ out.data(), out.size() }, packed_coding::delta);
+    EXPECT_EQ(out, ids);
+    EXPECT_TRUE(reader.exhausted());
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/ring_buffer.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Region {
+    std::size_t                 bytes;
+    std::unique_ptr<std::byte[]> raw;
+    void*                       ptr;
+
+    explicit Region(std::size_t n) : bytes(n), raw(new std::byte[n + 64]) {
+        auto p = reinterpret_cast<std::uintptr_t>(raw.get());
+        ptr = raw.get() + ((64 - p % 64) % 64);
+    }
+};
+
+template <ring_mode M>
+bool push_u64(RingBuffer<M>& ring, std::uint64_t v, std::size_t pad = 0)
+{
+    auto f = ring.try_reserve(8 + pad);
+    if (!f) return false;
+    f->writer.template write_le<std::uint64_t>(v);
+    for (std::size_t i = 0; i < pad; ++i) f->writer.template write_le<std::uint8_t>(std::uint8_t(v + i));
+    ring.commit(*f);
+    return true;
+}
+
+} // namespace
+
+TEST(RingBufferTest, CommitThenAcquireInOrder)
+{
+    Region mem(RingBuffer<>::header_size + 1024);
+    auto ring = RingBuffer<>::create(mem.ptr, mem.bytes);
+    EXPECT_EQ(ring.capacity(), 1024u);
+    EXPECT_FALSE(ring.try_acquire());
+
+    auto f = ring.try_reserve(64);
+    ASSERT_TRUE(f);
+    f->writer.write_sized_string_le("hello");
+    EXPECT_FALSE(ring.try_acquire()); // reserved, not committed
+    ring.commit(*f);
+    ASSERT_TRUE(push_u64(ring, 42));
+
+    auto a = ring.try_acquire();
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a->reader.size(), 9u); // only what was written
+    EXPECT_EQ(a->reader.read_sized_string_le(), "hello");
+    ring.release(*a);
+
+    auto b = ring.try_acquire();
+    ASSERT_TRUE(b);
+    EXPECT_EQ(b->reader.read_le<std::uint64_t>(), 42u);
+    ring.release(*b);
+    EXPECT_FALSE(ring.try_acquire());
+    EXPECT_EQ(ring.used(), 0u);
+}
+
+TEST(RingBufferTest, FullRingRejectsAndWrapsContiguously)
+{
+    Region mem(RingBuffer<>::header_size + 256);
+    auto ring = RingBuffer<>::create(mem.ptr, mem.bytes);
+    ASSERT_EQ(ring.capacity(), 256u);
+    EXPECT_THROW(ring.try_reserve(ring.max_frame_size() + 1), OverflowException);
+
+    // 40-byte frames: six fit, the seventh does not
+    std::uint64_t next_in = 0, next_out = 0;
+    while (push_u64(ring, next_in, 24)) ++next_in;
+    EXPECT_EQ(next_in, 6u);
+
+    // keep the ring cycling so frames straddle the end many times
+    for (int round = 0; round < 50; ++round) {
+        auto f = ring.try_acquire();
+        ASSERT_TRUE(f);
+        ASSERT_EQ(f->reader.size(), 32u);
+        EXPECT_EQ(f->reader.read_le<std::uint64_t>(), next_out);
+        for (std::size_t i = 0; i < 24; ++i) ASSERT_EQ(f->reader.read_le<std::uint8_t>(), std::uint8_t(next_out + i));
+        ring.release(*f);
+        ++next_out;
+        while (push_u64(ring, next_in, 24)) ++next_in;
+        ASSERT_LE(ring.used(), ring.capacity());
+    }
+    while (auto f = ring.try_acquire()) {
+        EXPECT_EQ(f->reader.read_le<std::uint64_t>(), next_out++);
+        ring.release(*f);
+    }
+    EXPECT_EQ(next_out, next_in);
+}
+
+TEST(RingBufferTest, AttachSharesTheRegion)
+{
+    Region mem(RingBuffer<ring_mode::mpsc>::header_size + 4096);
+    auto producer = RingBuffer<ring_mode::mpsc>::create(mem.ptr, mem.bytes);
+    auto consumer = RingBuffer<ring_mode::mpsc>::attach(mem.ptr, mem.bytes);
+    ASSERT_TRUE(push_u64(producer, 7));
+    auto f = consumer.try_acquire();
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f->reader.read_le<std::uint64_t>(), 7u);
+    consumer.release(*f);
+
+    EXPECT_THROW(RingBuffer<ring_mode::spsc>::attach(mem.ptr, mem.bytes), FormatException);
+    EXPECT_THROW(RingBuffer<ring_mode::mpsc>::attach(mem.ptr, 100), std::invalid_argument);
+    EXPECT_THROW(RingBuffer<>::create(static_cast<std::byte*>(mem.ptr) + 8, 1024), std::invalid_argument);
+}
+
+TEST(RingBufferTest, MpscOutOfOrderCommitWaitsForEarlierFrame)
+{
+    Region mem(RingBuffer<ring_mode::mpsc>::header_size + 1024);
+    auto a = RingBuffer<ring_mode::mpsc>::create(mem.ptr, mem.bytes);
+    auto b = RingBuffer<ring_mode::mpsc>::attach(mem.ptr, mem.bytes);
+    auto c = RingBuffer<ring_mode::mpsc>::attach(mem.ptr, mem.bytes);
+
+    auto first  = a.reserve(16);
+    auto second = b.reserve(16);
+    second.writer.write_le<std::uint32_t>(2);
+    b.commit(second);
+    EXPECT_FALSE(c.try_acquire()); // blocked behind the first reservation
+    first.writer.write_le<std::uint32_t>(1);
+    a.commit(first);
+
+    auto f1 = c.acquire();
+    EXPECT_EQ(f1.reader.read_le<std::uint32_t>(), 1u);
+    c.release(f1);
+    auto f2 = c.acquire();
+    EXPECT_EQ(f2.reader.read_le<std::uint32_t>(), 2u);
+    c.release(f2);
+}
+
+TEST(RingBufferTest, SpscThreadsSeeEveryFrameInOrder)
+{
+    constexpr std::uint64_t frames = 200000;
+    Region mem(RingBuffer<>::header_size + 4096);
+    auto ring = RingBuffer<>::create(mem.ptr, mem.bytes);
+
+    std::thread producer([view = ring]() mutable {
+        for (std::uint64_t i = 0; i < frames; ++i) {
+            auto f = view.reserve(8 + i % 40);
+            f.writer.write_le<std::uint64_t>(i);
+            for (std::size_t k = 0; k < i % 40; ++k) f.writer.write_le<std::uint8_t>(std::uint8_t(i));
+            view.commit(f);
+        }
+    });
+
+    for (std::uint64_t i = 0; i < frames; ++i) {
+        auto f = ring.acquire();
+        ASSERT_EQ(f.reader.size(), 8 + i % 40);
+        ASSERT_EQ(f.reader.read_le<std::uint64_t>(), i);
+        while (f.reader.remaining()) ASSERT_EQ(f.reader.read_le<std::uint8_t>(), std::uint8_t(i));
+        ring.release(f);
+    }
+    producer.join();
+    EXPECT_FALSE(ring.try_acquire());
+}
+
+TEST(RingBufferTest, MpscThreadsKeepPerProducerOrder)
+{
+    constexpr std::uint32_t producers = 4;
+    constexpr std::uint32_t per_producer = 50000;
+    Region mem(RingBuffer<ring_mode::mpsc>::header_size + 8192);
+    auto ring = RingBuffer<ring_mode::mpsc>::create(mem.ptr, mem.bytes);
+
+    std::vector<std::thread> threads;
+    for (std::uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([view = ring, p]() mutable {
+            for (std::uint32_t i = 0; i < per_producer; ++i) {
+                auto f = view.reserve(16 + (i % 3) * 8);
+                f.writer.write_le<std::uint32_t>(p);
+                f.writer.write_le<std::uint32_t>(i);
+                view.commit(f);
+            }
+        });
+    }
+
+    std::vector<std::uint32_t> next(producers, 0);
+    for (std::uint64_t n = 0; n < std::uint64_t{producers} * per_producer; ++n) {
+        auto f = ring.acquire();
+        ASSERT_EQ(f.reader.size(), 8u);
+        const auto p = f.reader.read_le<std::uint32_t>();
+        ASSERT_LT(p, producers);
+        ASSERT_EQ(f.reader.read_le<std::uint32_t>(), next[p]++);
+        ring.release(f);
+    }
+    for (auto& t : threads) t.join();
+    for (auto v : next) EXPECT_EQ(v, per_producer);
+    EXPECT_FALSE(ring.try_acquire());
+    EXPECT_EQ(ring.used(), 0u);
+}
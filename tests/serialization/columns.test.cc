@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/columns.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+enum class Side : std::uint8_t { buy = 1, sell = 2 };
+
+struct Tick
+{
+    std::uint64_t ts   = 0;
+    double        px   = 0;
+    std::uint32_t qty  = 0;
+    Side          side = Side::buy;
+    std::int16_t  venue = 0;
+
+    using bytestream_schema = schema<field_le<&Tick::ts>, field_le<&Tick::px>, field_be<&Tick::qty>,
+                                     field_le<&Tick::side>, field<&Tick::venue>>;
+};
+
+bool operator==(const Tick& a, const Tick& b)
+{
+    return a.ts == b.ts && a.px == b.px && a.qty == b.qty && a.side == b.side && a.venue == b.venue;
+}
+
+std::vector<Tick> make_ticks(std::size_t n)
+{
+    std::vector<Tick> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i].ts    = 1'700'000'000'000ull + i;
+        v[i].px    = 100.0 + double(i) / 8;
+        v[i].qty   = std::uint32_t(i * 7);
+        v[i].side  = i % 3 ? Side::buy : Side::sell;
+        v[i].venue = std::int16_t(i % 11 - 5);
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(ColumnsTest, ReadsTheVectorWireFormatAsColumns)
+{
+    static_assert(ColumnBatch<Tick>::row_size == 8 + 8 + 4 + 1 + 2);
+    const auto ticks = make_ticks(1000); // several transpose tiles
+    DynamicWriter w;
+    write_field(w, ticks);
+
+    Reader r(w.data(), w.size());
+    ColumnBatch<Tick> cols;
+    read_vector_columns(r, cols);
+    EXPECT_EQ(r.remaining(), 0u);
+    ASSERT_EQ(cols.size(), ticks.size());
+
+    const auto& px  = cols.column<&Tick::px>();
+    const auto& qty = cols.column<2>();
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        ASSERT_EQ(px[i], ticks[i].px);
+        ASSERT_EQ(qty[i], ticks[i].qty);
+        ASSERT_EQ(cols.row(i), ticks[i]);
+    }
+}
+
+TEST(ColumnsTest, WritesTheSameBytesAsWriteField)
+{
+    const auto ticks = make_ticks(777);
+    ColumnBatch<Tick> cols;
+    for (const auto& t : ticks) cols.push_back(t);
+
+    DynamicWriter expected;
+    write_field<length_prefix::varint>(expected, ticks);
+    DynamicWriter got;
+    write_vector_columns<length_prefix::varint>(got, cols);
+    ASSERT_EQ(got.size(), expected.size());
+    EXPECT_EQ(std::memcmp(got.data(), expected.data(), got.size()), 0);
+
+    // sinks without claim() take the staged path
+    CountingWriter counter;
+    write_vector_columns<length_prefix::varint>(counter, cols);
+    EXPECT_EQ(counter.size(), expected.size());
+
+    Reader r(got.data(), got.size());
+    EXPECT_EQ((read_field<std::vector<Tick>, length_prefix::varint>(r)), ticks);
+}
+
+TEST(ColumnsTest, RawPointerColumnsAndAppend)
+{
+    const auto ticks = make_ticks(40);
+    std::vector<std::uint64_t> ts(40);
+    std::vector<double>        px(40);
+    std::vector<std::uint32_t> qty(40);
+    std::vector<Side>          side(40);
+    std::vector<std::int16_t>  venue(40);
+
+    DynamicWriter w;
+    for (const auto& t : ticks) write_field(w, t);
+
+    Reader r(w.data(), w.size());
+    read_columns<Tick>(r, 40, std::tuple{ ts.data(), px.data(), qty.data(), side.data(), venue.data() });
+    EXPECT_EQ(ts[39], ticks[39].ts);
+    EXPECT_EQ(side[0], Side::sell);
+
+    DynamicWriter back;
+    write_columns<Tick>(back, 40, std::tuple{ ts.data(), px.data(), qty.data(), side.data(), venue.data() });
+    ASSERT_EQ(back.size(), w.size());
+    EXPECT_EQ(std::memcmp(back.data(), w.data(), w.size()), 0);
+
+    // read_columns into a batch appends
+    ColumnBatch<Tick> cols;
+    Reader a(w.data(), w.size());
+    read_columns(a, 10, cols);
+    read_columns(a, 30, cols);
+    ASSERT_EQ(cols.size(), 40u);
+    EXPECT_EQ(cols.row(25), ticks[25]);
+}
+
+TEST(ColumnsTest, TruncatedOrOversizedInputThrowsBeforeGrowing)
+{
+    DynamicWriter w;
+    write_field(w, make_ticks(10));
+
+    ColumnBatch<Tick> cols;
+    Reader short_input(w.data(), w.size() - 1);
+    EXPECT_THROW(read_vector_columns(short_input, cols), UnderflowException);
+    EXPECT_EQ(cols.size(), 0u);
+
+    DynamicWriter bogus;
+    bogus.write_le<std::uint32_t>(0xFFFFFFFFu);
+    Reader huge(bogus.data(), bogus.size());
+    EXPECT_THROW(read_vector_columns(huge, cols), UnderflowException);
+    EXPECT_EQ(cols.column<0>().capacity(), 0u);
+
+    decode_limits limits;
+    limits.max_collection_length = 5;
+    DecodeBudget budget(limits);
+    Reader limited(w.data(), w.size());
+    limited.set_budget(&budget);
+    EXPECT_THROW(read_vector_columns(limited, cols), LimitException);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Node
+{
+    std::uint32_t     id = 0;
+    std::vector<Node> children;
+
+    template <class W>
+    void serialize(W& w) const
+    {
+        write_fields(w, id, children);
+    }
+    template <class R>
+    static Node deserialize(R& r)
+    {
+        Node n;
+        n.id       = read_field<std::uint32_t>(r);
+        n.children = read_field<std::vector<Node>>(r);
+        return n;
+    }
+};
+
+Node chain(std::size_t depth)
+{
+    Node root;
+    Node* cur = &root;
+    for (std::size_t i = 0; i < depth; ++i) {
+        cur->children.emplace_back();
+        cur = &cur->children.back();
+        cur->id = static_cast<std::uint32_t>(i + 1);
+    }
+    return root;
+}
+
+} // namespace
+
+TEST(DecodeLimitsTest, HostileStringLengthFailsBeforeAllocating)
+{
+    std::vector<std::uint8_t> buffer(8, 0);
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_le<std::uint32_t>(0xFFFFFFF0u);
+
+    Reader reader(buffer.data(), buffer.size());
+    EXPECT_THROW(reader.read_sized_string_le(), UnderflowException); // no bad_alloc, no limits needed
+}
+
+TEST(DecodeLimitsTest, HostileVectorOfStringsReservesBounded)
+{
+    std::vector<std::uint8_t> buffer(16, 0);
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_le<std::uint32_t>(0xFFFFFFFFu);
+
+    Reader reader(buffer.data(), buffer.size());
+    EXPECT_THROW(read_vector<std::string>(reader), UnderflowException);
+}
+
+TEST(DecodeLimitsTest, ReserveIsBoundedByElementSize)
+{
+    // 64 bytes hold 16 empty strings, far fewer than the claimed count
+    std::vector<std::uint8_t> buffer(68, 0);
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_le<std::uint32_t>(0x00100000u);
+
+    Reader reader(buffer.data(), buffer.size());
+    std::vector<std::string> out;
+    EXPECT_THROW(read_vector_into(reader, out), UnderflowException);
+    EXPECT_LT(out.capacity(), 64u); // never one element per remaining byte
+}
+
+TEST(DecodeLimitsTest, CollectionAndStringCaps)
+{
+    DynamicWriter writer;
+    write_fields(writer, std::vector<std::uint16_t>(100, 1), std::string(50, 's'));
+
+    decode_limits limits;
+    limits.max_collection_length = 99;
+    DecodeBudget budget(limits);
+    Reader reader = writer.as_reader();
+    reader.set_budget(&budget);
+    EXPECT_THROW(read_vector<std::uint16_t>(reader), LimitException);
+
+    limits.max_collection_length = 100;
+    limits.max_string_length     = 49;
+    DecodeBudget budget2(limits);
+    Reader reader2 = writer.as_reader();
+    reader2.set_budget(&budget2);
+    EXPECT_EQ(read_vector<std::uint16_t>(reader2).size(), 100u);
+    const std::size_t before = reader2.position();
+    EXPECT_THROW(read_field<std::string>(reader2), LimitException);
+    EXPECT_EQ(reader2.position(), before + 4); // only the prefix was consumed
+    EXPECT_EQ(budget2.allocated(), 200u);
+}
+
+TEST(DecodeLimitsTest, TotalAllocationBudget)
+{
+    DynamicWriter writer;
+    for (int i = 0; i < 4; ++i) write_field(writer, std::vector<std::uint64_t>(32, 7));
+
+    decode_limits limits;
+    limits.max_total_bytes = 3 * 32 * 8;
+    DecodeBudget budget(limits);
+    Reader reader = writer.as_reader();
+    reader.set_budget(&budget);
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(read_vector<std::uint64_t>(reader).size(), 32u);
+    EXPECT_THROW(read_vector<std::uint64_t>(reader), LimitException);
+
+    budget.reset(); // next message
+    Reader next = writer.as_reader();
+    next.set_budget(&budget);
+    EXPECT_EQ(read_vector<std::uint64_t>(next).size(), 32u);
+}
+
+TEST(DecodeLimitsTest, NestingDepth)
+{
+    DynamicWriter writer;
+    write_field(writer, chain(20));
+
+    decode_limits limits;
+    limits.max_depth = 10;
+    DecodeBudget shallow(limits);
+    Reader reader = writer.as_reader();
+    reader.set_budget(&shallow);
+    EXPECT_THROW(read_field<Node>(reader), LimitException);
+
+    limits.max_depth = 64;
+    DecodeBudget deep(limits);
+    Reader reader2 = writer.as_reader();
+    reader2.set_budget(&deep);
+    const Node back = read_field<Node>(reader2);
+    EXPECT_EQ(back.children.at(0).children.at(0).id, 2u);
+    EXPECT_EQ(deep.depth(), 0u); // unwound
+}
+
+TEST(DecodeLimitsTest, BudgetFollowsSubviewsAndUncheckedFrames)
+{
+    DynamicWriter writer;
+    write_field(writer, std::string(10, 'x'));
+
+    decode_limits limits;
+    limits.max_string_length = 5;
+    DecodeBudget budget(limits);
+    Reader reader = writer.as_reader();
+    reader.set_budget(&budget);
+
+    Reader sub = reader.subview(0);
+    EXPECT_THROW(read_field<std::string>(sub), LimitException);
+
+    auto frame = reader.unchecked(writer.size());
+    EXPECT_THROW(read_field<std::string_view>(frame), LimitException);
+}
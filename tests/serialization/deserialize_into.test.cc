@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+// ------------------------------------------------------------------
+// Allocation counter (only counts while armed on this thread). It
+// replaces the global operator new, so it is compiled into
+// deserialize_into_test alone (BYTESTREAM_TEST_COUNT_ALLOCATIONS).
+// ------------------------------------------------------------------
+#if BYTESTREAM_TEST_COUNT_ALLOCATIONS
+namespace {
+thread_local bool        g_counting    = false;
+thread_local std::size_t g_allocations = 0;
+
+struct count_allocations {
+    count_allocations() { g_allocations = 0; g_counting = true; }
+    ~count_allocations() { g_counting = false; }
+    std::size_t count() const { return g_allocations; }
+};
+} // namespace
+
+void* operator new(std::size_t n)
+{
+    if (g_counting) ++g_allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+// kept out of line: inlined, GCC pairs the free() with a new-expression
+// and warns (-Wmismatched-new-delete)
+BYTESTREAM_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BYTESTREAM_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+namespace {
+
+struct Quote : Serializable<Quote> {
+    std::uint64_t              id{};
+    std::string                venue;
+    std::vector<double>        levels;
+    std::vector<std::string>   tags;
+
+    template <class W> void serialize_impl(W& w) const { write_fields(w, id, venue, levels, tags); }
+    template <class R> void deserialize_impl(R& r) {
+        read_field_into(r, id);
+        read_field_into(r, venue);
+        read_field_into(r, levels);
+        read_field_into(r, tags);
+    }
+};
+
+struct Fill {
+    std::uint32_t            qty{};
+    std::string              account;
+    std::vector<std::string> notes;
+    using bytestream_schema = schema<field_le<&Fill::qty>, field<&Fill::account>, field<&Fill::notes>>;
+};
+
+Quote make_quote(std::uint64_t i)
+{
+    Quote q;
+    q.id     = i;
+    q.venue  = "venue-" + std::string(20, char('a' + i % 26));
+    q.levels = std::vector<double>(16, double(i));
+    q.tags   = { "tag-long-enough-to-allocate-" + std::to_string(i), "b" };
+    return q;
+}
+
+} // namespace
+
+TEST(DeserializeIntoTest, StringReusesCapacity)
+{
+    DynamicWriter w;
+    write_field(w, std::string(100, 'x'));
+    write_field(w, std::string(10, 'y'));
+
+    std::string s;
+    s.reserve(200);
+    const char* storage = s.data();
+    Reader r(w.data(), w.size());
+    read_field_into(r, s);
+    EXPECT_EQ(s, std::string(100, 'x'));
+    read_field_into(r, s);
+    EXPECT_EQ(s, std::string(10, 'y'));
+    EXPECT_EQ(s.data(), storage);
+}
+
+TEST(DeserializeIntoTest, VectorIntoShrinksAndGrows)
+{
+    DynamicWriter w;
+    write_field(w, std::vector<std::string>{ "a", "b", "c" });
+    write_field(w, std::vector<std::string>{ "d" });
+    write_field(w, std::vector<std::string>{ "e", "f", "g", "h" });
+    write_field(w, std::vector<std::uint16_t>{ 1, 2, 3 });
+
+    Reader r(w.data(), w.size());
+    std::vector<std::string> v;
+    read_vector_into(r, v);
+    EXPECT_EQ(v, (std::vector<std::string>{ "a", "b", "c" }));
+    read_vector_into(r, v);
+    EXPECT_EQ(v, (std::vector<std::string>{ "d" }));
+    read_vector_into(r, v);
+    EXPECT_EQ(v, (std::vector<std::string>{ "e", "f", "g", "h" }));
+
+    std::vector<std::uint16_t> u(10, 9);
+    read_vector_into(r, u);
+    EXPECT_EQ(u, (std::vector<std::uint16_t>{ 1, 2, 3 }));
+}
+
+TEST(DeserializeIntoTest, CrtpAndSchemaMatchReadField)
+{
+    DynamicWriter w;
+    const Quote q = make_quote(5);
+    write_field(w, q);
+    const Fill f{ 7, "acct", { "n1", "n2" } };
+    write_field(w, f);
+
+    Reader r(w.data(), w.size());
+    Quote got = make_quote(99);
+    deserialize_into(r, got);
+    EXPECT_EQ(got.id, q.id);
+    EXPECT_EQ(got.venue, q.venue);
+    EXPECT_EQ(got.levels, q.levels);
+    EXPECT_EQ(got.tags, q.tags);
+
+    Fill fill{ 1, "old-account-with-long-name", { "x", "y", "z" } };
+    read_field_into(r, fill);
+    EXPECT_EQ(fill.qty, 7u);
+    EXPECT_EQ(fill.account, "acct");
+    EXPECT_EQ(fill.notes, f.notes);
+}
+
+#if BYTESTREAM_TEST_COUNT_ALLOCATIONS
+TEST(DeserializeIntoTest, PooledDecodeLoopDoesNotAllocate)
+{
+    DynamicWriter w;
+    for (std::uint64_t i = 0; i < 200; ++i) write_field(w, make_quote(i));
+
+    ObjectPool<Quote> pool(4);
+    {
+        // warm-up pass sizes every buffer
+        Reader r(w.data(), w.size());
+        for (int i = 0; i < 200; ++i) EXPECT_EQ(pool.decode(r)->id, std::uint64_t(i));
+    }
+    EXPECT_EQ(pool.cached(), 1u);
+
+    Reader r(w.data(), w.size());
+    std::uint64_t sum = 0;
+    std::size_t allocations;
+    {
+        count_allocations counter;
+        for (int i = 0; i < 200; ++i) {
+            auto q = pool.decode(r);
+            sum += q->id + q->tags.size();
+        }
+        allocations = counter.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(sum, 199u * 200u / 2 + 400u);
+}
+#else
+TEST(DeserializeIntoTest, PooledDecodeLoopDoesNotAllocate) {
+    GTEST_SKIP() << "counting allocations needs BYTESTREAM_TEST_COUNT_ALLOCATIONS=1 (see deserialize_into_test)";
+}
+#endif
+
+TEST(DeserializeIntoTest, PoolRecyclesObjects)
+{
+    ObjectPool<Quote> pool(2);
+    pool.prewarm(2);
+    EXPECT_EQ(pool.cached(), 2u);
+    Quote* first;
+    {
+        auto a = pool.acquire();
+        first = a.get();
+        a->venue = "kept";
+        EXPECT_EQ(pool.cached(), 1u);
+    }
+    EXPECT_EQ(pool.cached(), 2u);
+    auto b = pool.acquire();
+    EXPECT_EQ(b.get(), first);
+    EXPECT_EQ(b->venue, "kept");
+
+    // past max_cached objects are freed instead of cached
+    auto c = pool.acquire();
+    auto d = pool.acquire();
+    b.reset(); c.reset(); d.reset();
+    EXPECT_EQ(pool.cached(), 2u);
+}
+
+namespace {
+
+struct Pair {
+    std::uint32_t a{};
+    std::uint16_t b{};
+    using bytestream_schema = schema<field_be<&Pair::a>, field_le<&Pair::b>>;
+};
+
+} // namespace
+
+TEST(DeserializeIntoTest, ArraysOfSchemaTypesMatchReadField)
+{
+    const std::array<Pair, 2> v{ { { 16777216, 512 }, { 768, 1 } } };
+    DynamicWriter w;
+    write_field(w, v);
+    write_array(w, v);
+
+    Reader r(w.data(), w.size());
+    std::array<Pair, 2> into{};
+    read_field_into(r, into);
+    const auto back = read_field<std::array<Pair, 2>>(r);
+    EXPECT_TRUE(r.exhausted());
+    for (std::size_t i = 0; i < 2; ++i) {
+        EXPECT_EQ(into[i].a, v[i].a);
+        EXPECT_EQ(into[i].b, v[i].b);
+        EXPECT_EQ(back[i].a, v[i].a);
+        EXPECT_EQ(back[i].b, v[i].b);
+    }
+
+    // native element arrays: one block either way
+    const std::array<std::array<std::uint16_t, 2>, 2> raw{ { { 1, 2 }, { 3, 4 } } };
+    DynamicWriter rw;
+    write_field(rw, raw);
+    Reader rr(rw.data(), rw.size());
+    std::array<std::array<std::uint16_t, 2>, 2> raw_into{};
+    read_field_into(rr, raw_into);
+    EXPECT_EQ(raw_into, raw);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/record_view.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Leg
+{
+    std::uint32_t qty = 0;
+    std::string   venue;
+    using bytestream_schema = schema<field_le<&Leg::qty>, field<&Leg::venue>>;
+};
+
+struct Order
+{
+    std::uint64_t              id    = 0;
+    double                     price = 0;
+    std::string                account;
+    std::uint32_t              qty   = 0;
+    std::vector<std::uint16_t> flags;
+    std::vector<Leg>           legs;
+    std::int16_t               side  = 0;
+    std::string                note;
+
+    using bytestream_schema = schema<field_le<&Order::id>, field_le<&Order::price>, field<&Order::account>,
+                                     field_be<&Order::qty>, field<&Order::flags>, field<&Order::legs>,
+                                     field_le<&Order::side>, field<&Order::note>>;
+};
+
+Order make_order(std::uint64_t i)
+{
+    Order o;
+    o.id      = i;
+    o.price   = 10.5 + double(i);
+    o.account = "acct-" + std::to_string(i);
+    o.qty     = std::uint32_t(i * 3);
+    o.flags   = std::vector<std::uint16_t>(i % 5, std::uint16_t(i));
+    for (std::uint64_t k = 0; k < i % 3; ++k) o.legs.push_back({ std::uint32_t(k), "venue-" + std::to_string(k) });
+    o.side    = std::int16_t(i % 2 ? -1 : 1);
+    o.note    = std::string(i % 7, 'n');
+    return o;
+}
+
+template <typename View>
+void expect_fields(const View& v, const Order& o)
+{
+    EXPECT_EQ(v.template get<&Order::note>(), o.note); // last field first: resolves every offset
+    EXPECT_EQ(v.template get<&Order::id>(), o.id);
+    EXPECT_EQ(v.template get<&Order::price>(), o.price);
+    EXPECT_EQ((v.template get<&Order::account, std::string_view>()), o.account);
+    EXPECT_EQ(v.template get<&Order::qty>(), o.qty);
+    EXPECT_EQ(v.template get<&Order::flags>(), o.flags);
+    const auto legs = v.template get<&Order::legs>();
+    ASSERT_EQ(legs.size(), o.legs.size());
+    for (std::size_t k = 0; k < legs.size(); ++k) EXPECT_EQ(legs[k].venue, o.legs[k].venue);
+    EXPECT_EQ(v.template get<&Order::side>(), o.side);
+}
+
+} // namespace
+
+TEST(RecordViewTest, SkipsToFieldsInPlainRecords)
+{
+    for (std::uint64_t i = 0; i < 12; ++i) {
+        const Order o = make_order(i);
+        DynamicWriter w;
+        write_field(w, o);
+        Reader r(w.data(), w.size());
+        const RecordView<Order> v(r);
+        expect_fields(v, o);
+        EXPECT_EQ(v.offset_of<&Order::price>(), 8u);
+        EXPECT_EQ(v.offset_of<&Order::qty>(), 16u + 4u + o.account.size());
+        EXPECT_EQ(v.decode().note, o.note);
+    }
+}
+
+TEST(RecordViewTest, OffsetTableGivesDirectAccess)
+{
+    const Order o = make_order(11);
+    DynamicWriter plain;
+    write_field(plain, o);
+    DynamicWriter indexed;
+    write_indexed(indexed, o);
+    // schema bytes, then one u32 per variable field (account, flags, legs, note)
+    ASSERT_EQ(indexed.size(), plain.size() + 4 * 4);
+    EXPECT_EQ(std::memcmp(indexed.data(), plain.data(), plain.size()), 0);
+
+    const RecordView<Order> v(indexed.data(), indexed.size(), record_index::trailer);
+    EXPECT_EQ(v.size(), plain.size());
+    expect_fields(v, o);
+
+    // the table points at the same places the skipping walk finds
+    const RecordView<Order> walked(plain.data(), plain.size());
+    EXPECT_EQ(v.offset_of<&Order::side>(), walked.offset_of<&Order::side>());
+    EXPECT_EQ(v.offset_of<&Order::note>(), walked.offset_of<&Order::note>());
+
+    // and a plain reader still decodes the record
+    Reader r(indexed.data(), indexed.size());
+    EXPECT_EQ(read_field<Order>(r).note, o.note);
+}
+
+TEST(RecordViewTest, ReadViewWalksLengthPrefixedRecords)
+{
+    DynamicWriter w;
+    for (std::uint64_t i = 0; i < 100; ++i) write_indexed_field<length_prefix::varint>(w, make_order(i));
+
+    Reader r(w.data(), w.size());
+    std::uint64_t total = 0, n = 0;
+    while (r.remaining()) {
+        auto v = read_view<Order, length_prefix::varint>(r, record_index::trailer);
+        if (v.get<&Order::side>() < 0) total += v.get<&Order::qty>();
+        EXPECT_EQ(v.get<&Order::id>(), n++);
+    }
+    EXPECT_EQ(n, 100u);
+    std::uint64_t expected = 0;
+    for (std::uint64_t i = 1; i < 100; i += 2) expected += i * 3;
+    EXPECT_EQ(total, expected);
+}
+
+TEST(RecordViewTest, MalformedRecordsThrow)
+{
+    const Order o = make_order(4);
+    DynamicWriter w;
+    write_indexed(w, o);
+
+    // truncated table / table pointing past the record
+    EXPECT_THROW((RecordView<Order>(w.data(), 8, record_index::trailer)), FormatException);
+    std::vector<std::byte> bad(w.data(), w.data() + w.size());
+    bad[bad.size() - 1] = std::byte{0x7F};
+    EXPECT_THROW((RecordView<Order>(bad.data(), bad.size(), record_index::trailer)), FormatException);
+
+    // a truncated plain record underflows only when the missing field is read
+    DynamicWriter plain;
+    write_field(plain, o);
+    const RecordView<Order> cut(plain.data(), 20);
+    EXPECT_EQ(cut.get<&Order::id>(), o.id);
+    EXPECT_THROW(cut.get<&Order::note>(), UnderflowException);
+}
+
+namespace {
+
+struct Split
+{
+    std::string   a;
+    std::uint32_t b = 0;
+    std::string   c;
+    using bytestream_schema = schema<field<&Split::a>, field_le<&Split::b>, field<&Split::c>>;
+};
+
+} // namespace
+
+TEST(RecordViewTest, TruncatedAfterVariableFieldThrows)
+{
+    DynamicWriter w;
+    write_field(w, Split{ "abcd", 7, "tail" });
+
+    // ends right after `a`: b and c start past the end
+    const RecordView<Split> cut(w.data(), 4 + 4);
+    EXPECT_EQ((cut.get<&Split::a, std::string_view>()), "abcd");
+    EXPECT_THROW(cut.get<&Split::c>(), UnderflowException);
+    EXPECT_THROW(cut.get<&Split::b>(), UnderflowException);
+
+    // ends two bytes into `b`
+    const RecordView<Split> mid(w.data(), 4 + 4 + 2);
+    EXPECT_THROW(mid.get<&Split::c>(), UnderflowException);
+    EXPECT_THROW(mid.get<&Split::b>(), UnderflowException);
+}
+
+TEST(RecordViewTest, OffsetTableMustLeaveRoomForFixedFields)
+{
+    DynamicWriter w;
+    write_indexed(w, Split{ "abcd", 7, "tail" });
+    std::vector<std::byte> bad(w.data(), w.data() + w.size());
+    const std::size_t schema_bytes = bad.size() - 8;
+
+    // end of `c` before `a` + `b`
+    store_le<std::uint32_t>(bad.data() + schema_bytes + 4, 9);
+    EXPECT_THROW((RecordView<Split>(bad.data(), bad.size(), record_index::trailer)), FormatException);
+
+    // end of `a` leaves no room for `b` in front of the end of the record
+    store_le<std::uint32_t>(bad.data() + schema_bytes, std::uint32_t(schema_bytes - 2));
+    store_le<std::uint32_t>(bad.data() + schema_bytes + 4, std::uint32_t(schema_bytes));
+    EXPECT_THROW((RecordView<Split>(bad.data(), bad.size(), record_index::trailer)), FormatException);
+
+    const RecordView<Split> ok(w.data(), w.size(), record_index::trailer);
+    EXPECT_EQ(ok.get<&Split::c>(), "tail");
+    EXPECT_EQ(ok.get<&Split::b>(), 7u);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/schema.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+enum class Side : std::uint8_t { buy = 1, sell = 2 };
+
+struct Trade
+{
+    std::uint64_t id    = 0;
+    double        price = 0;
+    std::uint32_t qty   = 0;
+    Side          side  = Side::buy;
+    std::string   venue;
+    std::int16_t  flags = 0;
+
+    using bytestream_schema = schema<field_le<&Trade::id>, field_le<&Trade::price>, field_be<&Trade::qty>,
+                                     field_le<&Trade::side>, field<&Trade::venue>, field_le<&Trade::flags>>;
+};
+
+bool operator==(const Trade& a, const Trade& b)
+{
+    return a.id == b.id && a.price == b.price && a.qty == b.qty && a.side == b.side && a.venue == b.venue &&
+           a.flags == b.flags;
+}
+
+// all fixed: no padding on the wire, fixed size known at compile time
+struct Point
+{
+    std::uint8_t  tag;
+    std::uint32_t x;
+    std::uint32_t y;
+};
+
+// non-intrusive: schema declared outside the type
+struct Book
+{
+    std::vector<Trade> trades;
+    Point              origin;
+};
+
+} // namespace
+
+template <>
+struct bytestream::schema_of<Point> {
+    using type = schema<field_le<&Point::tag>, field_le<&Point::x>, field_le<&Point::y>>;
+};
+template <>
+struct bytestream::schema_of<Book> {
+    using type = schema<field<&Book::trades>, field<&Book::origin>>;
+};
+
+class SchemaTest : public ::testing::Test {
+protected:
+    std::vector<std::uint8_t> buffer;
+
+    void SetUp() override
+    {
+        buffer.resize(512, 0);
+    }
+
+    static Trade sample()
+    {
+        Trade t;
+        t.id    = 0x0102030405060708ull;
+        t.price = 101.25;
+        t.qty   = 0x0A0B0C0D;
+        t.side  = Side::sell;
+        t.venue = "XNAS";
+        t.flags = -3;
+        return t;
+    }
+};
+
+TEST_F(SchemaTest, WireLayoutMatchesFieldOrder)
+{
+    const Trade t = sample();
+    Writer writer(buffer.data(), buffer.size());
+    write_field(writer, t);
+
+    // same bytes as hand-written per-field encoding
+    std::vector<std::uint8_t> expected(512, 0);
+    Writer manual(expected.data(), expected.size());
+    manual.write_le<std::uint64_t>(t.id);
+    manual.write_le<double>(t.price);
+    manual.write_be<std::uint32_t>(t.qty);
+    manual.write_le<std::uint8_t>(static_cast<std::uint8_t>(t.side));
+    write_field(manual, t.venue);
+    manual.write_le<std::int16_t>(t.flags);
+
+    ASSERT_EQ(writer.position(), manual.position());
+    EXPECT_EQ(buffer, expected);
+    EXPECT_EQ(serialized_size(t), writer.position());
+}
+
+TEST_F(SchemaTest, RoundTrip)
+{
+    const Trade t = sample();
+    Writer writer(buffer.data(), buffer.size());
+    write_fields(writer, t, t);
+
+    Reader reader(buffer.data(), writer.position());
+    EXPECT_EQ(read_field<Trade>(reader), t);
+    EXPECT_EQ(read_field<Trade>(reader), t);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST_F(SchemaTest, FixedSchemaSize)
+{
+    static_assert(has_fixed_serialized_size_v<Point>);
+    static_assert(serialized_size<Point>() == 9, "packed: no padding on the wire");
+    static_assert(!has_fixed_serialized_size_v<Trade>);
+    static_assert(schema_of<Trade>::type::field_count == 6);
+
+    Writer writer(buffer.data(), buffer.size());
+    write_field(writer, Point{ 7, 1, 2 });
+    EXPECT_EQ(writer.position(), 9u);
+    EXPECT_EQ(buffer[1], 1);
+    EXPECT_EQ(buffer[5], 2);
+}
+
+TEST_F(SchemaTest, NestedAndNonIntrusive)
+{
+    Book book;
+    book.trades = { sample(), sample() };
+    book.trades[1].venue = "XLON";
+    book.origin = { 1, 2, 3 };
+
+    DynamicWriter writer;
+    write_field<length_prefix::varint>(writer, book);
+
+    Reader reader = writer.as_reader();
+    const Book back = read_field<Book, length_prefix::varint>(reader);
+    EXPECT_EQ(back.trades, book.trades);
+    EXPECT_EQ(back.origin.y, 3u);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST_F(SchemaTest, UnderflowInFixedRun)
+{
+    const Trade t = sample();
+    Writer writer(buffer.data(), buffer.size());
+    write_field(writer, t);
+
+    Reader reader(buffer.data(), 10); // inside the first fixed run
+    EXPECT_THROW(read_field<Trade>(reader), UnderflowException);
+    EXPECT_EQ(reader.position(), 0u);
+
+    Writer small(buffer.data(), 10);
+    EXPECT_THROW(write_field(small, t), OverflowException);
+    EXPECT_EQ(small.position(), 0u);
+}
+
+TEST_F(SchemaTest, StreamAndUncheckedSources)
+{
+    const Point p{ 9, 0xAABBCCDD, 5 };
+    Writer writer(buffer.data(), buffer.size());
+    write_field(writer, p);
+
+    Reader reader(buffer.data(), writer.position());
+    auto frame = reader.unchecked(serialized_size<Point>());
+    const Point back = read_field<Point>(frame);
+    EXPECT_EQ(back.x, 0xAABBCCDDu);
+    EXPECT_EQ(back.y, 5u);
+}
+
+namespace {
+
+// padded: sizeof 8, 6 bytes on the wire
+struct Sample
+{
+    std::uint32_t a = 0;
+    std::uint16_t b = 0;
+    using bytestream_schema = schema<field_be<&Sample::a>, field_le<&Sample::b>>;
+};
+
+} // namespace
+
+TEST_F(SchemaTest, ArraysOfSchemaTypesGoElementByElement)
+{
+    const std::array<Sample, 2> v{ { { 1, 2 }, { 3, 4 } } };
+    DynamicWriter w;
+    write_field(w, v);
+    ASSERT_EQ(w.size(), 12u);
+    EXPECT_EQ(w.data()[3], std::byte{1}); // field_be honoured
+    EXPECT_EQ(w.data()[4], std::byte{2});
+
+    Reader r(w.data(), w.size());
+    const auto back = read_field<std::array<Sample, 2>>(r);
+    EXPECT_EQ(back[1].a, 3u);
+    EXPECT_EQ(back[1].b, 4u);
+    EXPECT_TRUE(r.exhausted());
+
+    // nested arrays as well
+    const std::array<std::array<Sample, 2>, 2> nested{ { v, v } };
+    DynamicWriter n;
+    write_field(n, nested);
+    EXPECT_EQ(n.size(), 24u);
+}
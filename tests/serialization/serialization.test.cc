@@ -527,3 +527,277 @@ TEST_F(SerializationTest, NestedVectors)
     EXPECT_EQ(c2.data[1], std::vector<uint32_t>({ 4, 5 }));
     EXPECT_EQ(c2.data[2], std::vector<uint32_t>({ 6, 7, 8, 9 }));
 }
+
+// ============================================================================
+// Size Precomputation Tests
+// ============================================================================
+
+struct Reading : public Serializable<Reading>
+{
+    uint16_t              sensor = 0;
+    std::string           label;
+    std::vector<uint32_t> samples;
+
+    template <typename W>
+    void serialize_impl(W &w) const
+    {
+        write_fields(w, sensor, label, samples);
+    }
+
+    template <typename R>
+    void deserialize_impl(R &r)
+    {
+        sensor  = read_field<uint16_t>(r);
+        label   = read_field<std::string>(r);
+        samples = read_vector<uint32_t>(r);
+    }
+};
+
+TEST(SerializedSizeTest, FixedSizeTypes)
+{
+    static_assert(serialized_size<uint32_t>() == 4);
+    static_assert(serialized_size<SimplePOD>() == sizeof(SimplePOD));
+    static_assert(serialized_size<std::array<double, 3> >() == 24);
+    static_assert(!has_fixed_serialized_size_v<std::string>);
+    static_assert(!has_fixed_serialized_size_v<Person>);
+    SUCCEED();
+}
+
+TEST(SerializedSizeTest, MatchesEncodedBytes)
+{
+    std::vector<Reading> msgs(3);
+    msgs[0].label = "a";
+    msgs[1].label = "temperature";
+    msgs[1].samples = { 1, 2, 3 };
+    msgs[2].samples.assign(100, 7);
+
+    const std::size_t n = serialized_size(msgs);
+    EXPECT_EQ(n, 4u + (2 + 4 + 1 + 4) + (2 + 4 + 11 + 4 + 12) + (2 + 4 + 0 + 4 + 400));
+
+    // exact-size buffer: no overflow, no slack
+    std::vector<uint8_t> buf(n);
+    Writer w(buf.data(), buf.size());
+    write_field(w, msgs);
+    EXPECT_EQ(w.remaining(), 0u);
+
+    Reader r(buf.data(), buf.size());
+    auto back = read_vector<Reading>(r);
+    ASSERT_EQ(back.size(), 3u);
+    EXPECT_EQ(back[1].label, "temperature");
+    EXPECT_EQ(back[2].samples.size(), 100u);
+}
+
+TEST(SerializedSizeTest, PreSizedDynamicWriter)
+{
+    Reading msg;
+    msg.label = "pressure";
+    msg.samples = { 10, 20 };
+
+    DynamicWriter w;
+    w.reserve(serialized_size(msg));
+    const std::size_t cap = w.capacity();
+    write_field(w, msg);
+
+    EXPECT_EQ(w.capacity(), cap);
+    EXPECT_EQ(w.size(), serialized_size(msg));
+}
+
+TEST(SerializedSizeTest, CountingWriterTracksApi)
+{
+    CountingWriter c;
+
+    c.write_le<uint32_t>(1);
+    c.write_sized_string_be("abc");
+    c.write_cstring("xy");
+    c.align(16);
+    std::array<uint16_t, 5> arr{};
+    c.write_array_be<uint16_t>({ arr.data(), arr.size() });
+
+    EXPECT_EQ(c.size(), 16u + 10u);
+    c.seek(4);
+    EXPECT_EQ(c.position(), 4u);
+    EXPECT_EQ(c.size(), 26u);
+}
+
+// ============================================================================
+// Unchecked Cursor Tests
+// ============================================================================
+
+TEST_F(SerializationTest, UncheckedRoundTripWithGenericCRTP)
+{
+    Reading msg;
+    msg.sensor  = 9;
+    msg.label   = "flow";
+    msg.samples = { 5, 6, 7 };
+    const std::size_t n = serialized_size(msg);
+
+    Writer w(buffer.data(), buffer.size());
+    auto   uw = w.unchecked(n);
+    write_field(uw, msg);
+    EXPECT_EQ(uw.remaining(), 0u);
+    EXPECT_EQ(w.position(), n);
+
+    Reader r(buffer.data(), buffer.size());
+    auto   ur   = r.unchecked(n);
+    auto   back = read_field<Reading>(ur);
+    EXPECT_TRUE(ur.exhausted());
+    EXPECT_EQ(r.position(), n);
+    EXPECT_EQ(back.sensor, 9);
+    EXPECT_EQ(back.label, "flow");
+    EXPECT_EQ(back.samples, msg.samples);
+
+    // vector payload starts after sensor (2) + sized label (4 + 4)
+    Reader rv(buffer.data() + 10, n - 10);
+    EXPECT_EQ(read_field<std::vector<uint32_t> >(rv), msg.samples);
+}
+
+// ============================================================================
+// Zero-Copy View Tests
+// ============================================================================
+
+TEST_F(SerializationTest, StringViewRoundTrip)
+{
+    Writer w(buffer.data(), buffer.size());
+    write_field(w, std::string_view("edge-01"));
+    write_field(w, std::string("owned"));
+
+    Reader r(buffer.data(), buffer.size());
+    auto   host = read_field<std::string_view>(r);
+    EXPECT_EQ(host, "edge-01");
+    // points into the source buffer, no copy
+    EXPECT_EQ(reinterpret_cast<const uint8_t *>(host.data()), buffer.data() + 4);
+    EXPECT_EQ(read_field<std::string>(r), "owned");
+}
+
+TEST_F(SerializationTest, SpanViewMatchesVectorFormat)
+{
+    std::vector<float> src = { 1.0f, 2.5f, -3.0f };
+
+    // u32 prefix keeps the float payload 4-aligned in the buffer
+    Writer w(buffer.data(), buffer.size());
+    write_vector(w, src);
+
+    Reader r(buffer.data(), buffer.size());
+    auto   view = read_field<bytestream::span<const float> >(r);
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_EQ(reinterpret_cast<const uint8_t *>(view.data()), buffer.data() + 4);
+    EXPECT_FLOAT_EQ(view.data()[1], 2.5f);
+
+    Writer w2(buffer.data() + 64, 64);
+    write_field(w2, bytestream::span<const float>(src.data(), src.size()));
+    Reader r2(buffer.data() + 64, 64);
+    EXPECT_EQ(read_vector<float>(r2), src);
+}
+
+TEST_F(SerializationTest, SpanViewRejectsMisalignedData)
+{
+    Writer w(buffer.data(), buffer.size());
+    w.write<uint8_t>(0);
+    write_vector(w, std::vector<uint32_t>{ 1, 2 });
+
+    Reader r(buffer.data(), buffer.size());
+    r.skip(1);
+    EXPECT_THROW(read_vector_view<uint32_t>(r), AlignmentException);
+}
+
+TEST_F(SerializationTest, MisalignedViewArrayLeavesCursor)
+{
+    alignas(8) std::array<std::byte, 16> raw{};
+    Writer w(raw.data(), raw.size());
+    w.write<uint8_t>(0);
+    w.write_le<uint32_t>(7);
+    w.write_le<uint32_t>(9);
+
+    Reader r(raw.data(), raw.size());
+    r.skip(1);
+    EXPECT_THROW(r.view_array<uint32_t>(2), AlignmentException);
+    EXPECT_EQ(r.position(), 1u);
+    EXPECT_EQ(r.read_le<uint32_t>(), 7u); // fall back to a copying read
+}
+
+TEST_F(SerializationTest, ViewsAreNotTriviallySerializable)
+{
+    EXPECT_FALSE(detail::is_trivially_serializable_v<std::string_view>);
+    EXPECT_FALSE(detail::is_trivially_serializable_v<bytestream::span<const int> >);
+    EXPECT_FALSE(has_fixed_serialized_size_v<std::string_view>);
+    EXPECT_EQ(serialized_size(std::string_view("abc")), 7u);
+}
+
+// ============================================================================
+// Bulk Element Tests
+// ============================================================================
+
+TEST_F(SerializationTest, TrivialVectorsMoveAsOneBlock)
+{
+    std::vector<float> features(100000);
+    for (size_t i = 0; i < features.size(); ++i) features[i] = static_cast<float>(i) * 0.5f;
+    std::vector<SimplePOD> pods = { { 1, 1.5f, 2 }, { -3, 4.5f, 6 } };
+
+    DynamicWriter w;
+    write_fields(w, features, pods);
+    EXPECT_EQ(w.size(), 4 + features.size() * 4 + 4 + pods.size() * sizeof(SimplePOD));
+
+    Reader r = w.as_reader();
+    EXPECT_EQ(read_vector<float>(r), features);
+    const auto back = read_vector<SimplePOD>(r);
+    ASSERT_EQ(back.size(), 2u);
+    EXPECT_EQ(back[1].x, -3);
+    EXPECT_EQ(back[1].z, 6);
+}
+
+TEST_F(SerializationTest, DefaultInitAllocatorVector)
+{
+    using FastFloats = std::vector<float, default_init_allocator<float> >;
+    const std::vector<float> src = { 1.f, 2.f, 3.f };
+
+    Writer w(buffer.data(), buffer.size());
+    write_vector(w, src);
+
+    Reader     r(buffer.data(), buffer.size());
+    FastFloats v = read_field<FastFloats>(r);
+    EXPECT_EQ(std::vector<float>(v.begin(), v.end()), src);
+
+    FastFloats grown;
+    grown.resize(4);
+    grown.push_back(7.f);
+    EXPECT_EQ(grown.back(), 7.f);
+}
+
+TEST_F(SerializationTest, TrivialVectorLengthCheckedBeforeAllocating)
+{
+    Writer w(buffer.data(), buffer.size());
+    w.write_le<uint32_t>(0xFFFFFFFFu); // hostile element count, no payload
+
+    Reader r(buffer.data(), 4);
+    EXPECT_THROW(read_vector<double>(r), UnderflowException);
+    EXPECT_EQ(r.position(), 4u);
+}
+
+TEST_F(SerializationTest, TrivialVectorFromChunkedSource)
+{
+    std::vector<uint64_t> src(50000);
+    for (size_t i = 0; i < src.size(); ++i) src[i] = i * 0x9E3779B97F4A7C15ull;
+    DynamicWriter w;
+    write_vector(w, src);
+
+    const auto   bytes = w.view();
+    size_t       pos   = 0;
+    StreamReader r(StreamReader::chunk_source([&]() -> bytestream::span<const std::byte> {
+        const size_t n = std::min<size_t>(1000, bytes.size() - pos);
+        bytestream::span<const std::byte> s{ bytes.data() + pos, n };
+        pos += n;
+        return s;
+    }));
+    EXPECT_EQ(read_vector<uint64_t>(r), src);
+}
+
+TEST_F(SerializationTest, TrivialArrayRoundTrip)
+{
+    const std::array<int16_t, 5> a = { 1, -2, 3, -4, 5 };
+    Writer                       w(buffer.data(), buffer.size());
+    write_array(w, a);
+    EXPECT_EQ(w.position(), 10u);
+
+    Reader r(buffer.data(), buffer.size());
+    EXPECT_EQ((read_array<int16_t, 5>(r)), a);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <bytestream/tagged.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+struct Venue
+{
+    std::string   mic;
+    std::uint16_t lot = 0;
+
+    using bytestream_tagged = tagged_schema<tag<1, field<&Venue::mic>>, tag<2, field_le<&Venue::lot>>>;
+};
+
+// version 1 of a quote
+struct QuoteV1
+{
+    std::uint64_t id = 0;
+    double        px = 0;
+    std::string   symbol;
+
+    using bytestream_tagged = tagged_schema<tag<1, field_le<&QuoteV1::id>>, tag<2, field_le<&QuoteV1::px>>,
+                                            tag<3, field<&QuoteV1::symbol>>>;
+};
+
+// version 2: px retired, fields added (listed out of id order on purpose)
+struct QuoteV2
+{
+    std::uint64_t              id = 0;
+    std::string                symbol;
+    std::vector<std::uint32_t> sizes;
+    Venue                      venue;
+    std::uint32_t              flags = 0;
+
+    using bytestream_tagged = tagged_schema<tag<1, field_le<&QuoteV2::id>>, tag<7, field<&QuoteV2::venue>>,
+                                            tag<3, field<&QuoteV2::symbol>>, tag<4, field<&QuoteV2::sizes>>,
+                                            tag<5, field_be<&QuoteV2::flags>>>;
+};
+
+template <typename T>
+std::vector<std::byte> encode(const T& v)
+{
+    DynamicWriter w;
+    write_field(w, v);
+    return { w.data(), w.data() + w.size() };
+}
+
+// Overwrite the stack below the caller's frame
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void clobber_stack()
+{
+    volatile unsigned char junk[4096];
+    for (auto& b : junk) b = 0xA5;
+}
+
+// Encode in a frame of its own, so its temporaries are gone afterwards
+template <typename W, typename T>
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void write_out(W& w, const T& v)
+{
+    write_field(w, v);
+}
+
+const QuoteV2 sample{ 42, "MSFT", { 100, 200 }, { "XNAS", 100 }, 0x01020304u };
+
+} // namespace
+
+TEST(TaggedTest, RoundTrip)
+{
+    const auto bytes = encode(sample);
+    Reader r(bytes.data(), bytes.size());
+    const QuoteV2 q = read_field<QuoteV2>(r);
+    EXPECT_TRUE(r.exhausted());
+    EXPECT_EQ(q.id, 42u);
+    EXPECT_EQ(q.symbol, "MSFT");
+    EXPECT_EQ(q.sizes, sample.sizes);
+    EXPECT_EQ(q.venue.mic, "XNAS");
+    EXPECT_EQ(q.venue.lot, 100u);
+    EXPECT_EQ(q.flags, 0x01020304u);
+}
+
+TEST(TaggedTest, FixedEntriesCopiedIntoGatherWriter)
+{
+    const QuoteV1 q{ 0x1122334455667788ull, 2.5, "a symbol held by reference" };
+    GatherWriter gather(8); // fixed-width entries are at least this big
+    write_out(gather, q);
+    clobber_stack();
+    std::vector<std::byte> flat(gather.size());
+    gather.copy_to(flat.data());
+    EXPECT_EQ(flat, encode(q));
+
+    Reader r(flat.data(), flat.size());
+    const QuoteV1 back = read_field<QuoteV1>(r);
+    EXPECT_EQ(back.id, q.id);
+    EXPECT_EQ(back.px, q.px);
+    EXPECT_EQ(back.symbol, q.symbol);
+}
+
+TEST(TaggedTest, WireLayout)
+{
+    const auto bytes = encode(Venue{ "AB", 0x0102 });
+    const std::vector<std::uint8_t> expected{
+        7,                          // body length
+        (1 << 3) | 4, 2, 'A', 'B',  // id 1, length-delimited
+        (2 << 3) | 1, 0x02, 0x01,   // id 2, fixed16 little-endian
+    };
+    ASSERT_EQ(bytes.size(), expected.size());
+    EXPECT_EQ(std::memcmp(bytes.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(TaggedTest, OldReaderSkipsNewFields)
+{
+    const auto bytes = encode(sample);
+    Reader r(bytes.data(), bytes.size());
+    const QuoteV1 q = read_field<QuoteV1>(r);
+    EXPECT_TRUE(r.exhausted());
+    EXPECT_EQ(q.id, 42u);
+    EXPECT_EQ(q.symbol, "MSFT");
+    EXPECT_EQ(q.px, 0.0); // not sent
+}
+
+TEST(TaggedTest, NewReaderDefaultsMissingFields)
+{
+    const auto bytes = encode(QuoteV1{ 7, 1.5, "AAPL" });
+    Reader r(bytes.data(), bytes.size());
+    QuoteV2 q;
+    q.flags = 9;
+    read_field_into(r, q);
+    EXPECT_TRUE(r.exhausted());
+    EXPECT_EQ(q.id, 7u);
+    EXPECT_EQ(q.symbol, "AAPL");
+    EXPECT_TRUE(q.sizes.empty());
+    EXPECT_EQ(q.flags, 9u); // absent fields keep their value
+
+    Reader again(bytes.data(), bytes.size());
+    EXPECT_EQ(read_field<QuoteV2>(again).flags, 0u);
+}
+
+TEST(TaggedTest, VectorsOfTaggedRecords)
+{
+    const std::vector<QuoteV2> in{ sample, QuoteV2{ 1, "A", {}, {}, 0 } };
+    DynamicWriter w;
+    write_field<length_prefix::varint>(w, in);
+    Reader r = w.as_reader();
+    const auto out = read_field<std::vector<QuoteV2>, length_prefix::varint>(r);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].venue.mic, "XNAS");
+    EXPECT_EQ(out[1].symbol, "A");
+}
+
+TEST(TaggedTest, MalformedInput)
+{
+    // id 1 is fixed64 in QuoteV1; sent as fixed32
+    const std::vector<std::uint8_t> mismatch{ 5, (1 << 3) | 2, 1, 2, 3, 4 };
+    Reader a(mismatch.data(), mismatch.size());
+    EXPECT_THROW(read_field<QuoteV1>(a), FormatException);
+
+    // unknown id with an unknown wire type cannot be skipped
+    const std::vector<std::uint8_t> wire7{ 2, (9 << 3) | 7, 0 };
+    Reader b(wire7.data(), wire7.size());
+    EXPECT_THROW(read_field<QuoteV1>(b), FormatException);
+
+    // payload past the end of the body
+    const std::vector<std::uint8_t> longer{ 3, (9 << 3) | 4, 5, 0 };
+    Reader c(longer.data(), longer.size());
+    EXPECT_THROW(read_field<QuoteV1>(c), UnderflowException);
+
+    const auto bytes = encode(sample);
+    for (std::size_t n = 0; n < bytes.size(); ++n) {
+        Reader t(bytes.data(), n);
+        EXPECT_THROW(read_field<QuoteV2>(t), UnderflowException) << "length " << n;
+    }
+}
+
+TEST(TaggedTest, NothrowReaderReportsErrc)
+{
+    const auto bytes = encode(sample);
+    NothrowReader ok(bytes.data(), bytes.size());
+    EXPECT_EQ(read_field<QuoteV2>(ok).venue.mic, "XNAS");
+    EXPECT_TRUE(ok.ok());
+
+    for (std::size_t n = 0; n < bytes.size(); ++n) {
+        NothrowReader t(bytes.data(), n);
+        (void)read_field<QuoteV2>(t);
+        EXPECT_EQ(t.error(), errc::underflow) << "length " << n;
+    }
+
+    const std::vector<std::uint8_t> mismatch{ 5, (1 << 3) | 2, 1, 2, 3, 4 };
+    NothrowReader m(mismatch.data(), mismatch.size());
+    (void)read_field<QuoteV1>(m);
+    EXPECT_EQ(m.error(), errc::format);
+}
+
+TEST(TaggedTest, BudgetCoversNestedRecords)
+{
+    const auto bytes = encode(sample);
+    decode_limits limits;
+    limits.max_depth = 1; // the quote itself, but not its venue
+    DecodeBudget budget(limits);
+    Reader r(bytes.data(), bytes.size());
+    r.set_budget(&budget);
+    EXPECT_THROW(read_field<QuoteV2>(r), LimitException);
+    EXPECT_EQ(budget.depth(), 0u);
+}
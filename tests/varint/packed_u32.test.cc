@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace bytestream;
+
+namespace {
+
+std::vector<std::uint32_t> mixed_values(std::size_t n)
+{
+    std::vector<std::uint32_t> v(n);
+    std::uint32_t x = 0x9E3779B9u;
+    for (std::size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        // mix of 1-, 2-, 3- and 4-byte values
+        v[i] = x >> (8 * (i % 4));
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(PackedU32Test, Layout)
+{
+    const std::uint32_t values[] = { 5, 0x1234, 0x123456, 0x12345678, 0 };
+    std::vector<std::uint8_t> buffer(32, 0xEE);
+    Writer writer(buffer.data(), buffer.size());
+
+    writer.write_packed_u32_array({ values, 5 });
+    // 2 control bytes + 1+2+3+4+1 data bytes
+    ASSERT_EQ(writer.position(), 13u);
+    EXPECT_EQ(buffer[0], 0xE4); // codes 0,1,2,3
+    EXPECT_EQ(buffer[1], 0x00);
+    EXPECT_EQ(buffer[2], 0x05);
+    EXPECT_EQ(buffer[3], 0x34);
+    EXPECT_EQ(buffer[4], 0x12);
+    EXPECT_EQ(buffer[5], 0x56);
+    EXPECT_EQ(buffer[8], 0x78);
+    EXPECT_EQ(buffer[12], 0x00);
+}
+
+TEST(PackedU32Test, RoundTripAllLengths)
+{
+    // every count 0..67 covers full groups, partial control bytes and the scalar tail
+    for (std::size_t n = 0; n < 68; ++n) {
+        const auto values = mixed_values(n);
+        std::vector<std::uint8_t> buffer(5 * n + 1);
+        Writer writer(buffer.data(), buffer.size());
+        writer.write_packed_u32_array({ values.data(), n });
+
+        CountingWriter counter;
+        counter.write_packed_u32_array({ values.data(), n });
+        EXPECT_EQ(counter.size(), writer.position());
+
+        std::vector<std::uint32_t> out(n, 0xDEADBEEF);
+        Reader reader(buffer.data(), writer.position());
+        reader.read_packed_u32_array({ out.data(), n });
+        EXPECT_EQ(out, values) << "n=" << n;
+        EXPECT_TRUE(reader.exhausted());
+    }
+}
+
+TEST(PackedU32Test, DeltaCoding)
+{
+    std::vector<std::uint32_t> timestamps(1000);
+    for (std::size_t i = 0; i < timestamps.size(); ++i) timestamps[i] = 1700000000u + std::uint32_t(i * 7);
+    timestamps[500] = 3; // a negative delta wraps instead of breaking the stream
+
+    const auto plain = serialized_size(timestamps);
+    DynamicWriter writer;
+    writer.write_packed_u32_array({ timestamps.data(), timestamps.size() }, packed_coding::delta);
+    EXPECT_LT(writer.size(), plain / 3);
+
+    std::vector<std::uint32_t> out(timestamps.size());
+    Reader reader = writer.as_reader();
+    reader.read_packed_u32_array({ out.data(), out.size() }, packed_coding::delta);
+    EXPECT_EQ(out, timestamps);
+}
+
+TEST(PackedU32Test, UnderflowLeavesPosition)
+{
+    const auto values = mixed_values(40);
+    std::vector<std::uint8_t> buffer(256);
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_packed_u32_array({ values.data(), values.size() });
+
+    std::vector<std::uint32_t> out(values.size());
+    Reader reader(buffer.data(), writer.position() - 1);
+    EXPECT_THROW(reader.read_packed_u32_array({ out.data(), out.size() }), UnderflowException);
+    EXPECT_EQ(reader.position(), 0u);
+}
+
+TEST(PackedU32Test, WriterOverflow)
+{
+    const std::uint32_t values[] = { 0xFFFFFFFFu, 0xFFFFFFFFu };
+    std::vector<std::uint8_t> buffer(8);
+    Writer writer(buffer.data(), buffer.size());
+    EXPECT_THROW(writer.write_packed_u32_array({ values, 2 }), OverflowException);
+    EXPECT_EQ(writer.position(), 0u);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace bytestream;
+
+class VarintTest : public ::testing::Test {
+protected:
+    std::vector<std::uint8_t> buffer;
+
+    void SetUp() override
+    {
+        buffer.resize(64, 0);
+    }
+};
+
+TEST_F(VarintTest, KnownEncodings)
+{
+    Writer writer(buffer.data(), buffer.size());
+
+    writer.write_varint<std::uint32_t>(1);
+    writer.write_varint<std::uint32_t>(300);
+    writer.write_varint<std::uint64_t>(0);
+    EXPECT_EQ(writer.position(), 4);
+    EXPECT_EQ(buffer[0], 0x01);
+    EXPECT_EQ(buffer[1], 0xAC);
+    EXPECT_EQ(buffer[2], 0x02);
+    EXPECT_EQ(buffer[3], 0x00);
+}
+
+TEST_F(VarintTest, ZigZagMapping)
+{
+    EXPECT_EQ(detail::zigzag_encode(std::int32_t{ 0 }), 0u);
+    EXPECT_EQ(detail::zigzag_encode(std::int32_t{ -1 }), 1u);
+    EXPECT_EQ(detail::zigzag_encode(std::int32_t{ 1 }), 2u);
+    EXPECT_EQ(detail::zigzag_encode(std::int32_t{ -2 }), 3u);
+    EXPECT_EQ(detail::zigzag_encode(std::numeric_limits<std::int32_t>::min()), 0xFFFFFFFFu);
+    EXPECT_EQ(detail::zigzag_decode(std::uint64_t{ 0xFFFFFFFFFFFFFFFFull }),
+              std::numeric_limits<std::int64_t>::min());
+}
+
+// Every encoded length 1..10, read from the middle and from the very end of
+// the buffer so both the 8-byte fast path and the byte-wise path decode it
+TEST_F(VarintTest, RoundTripEveryLength)
+{
+    for (unsigned bits = 0; bits <= 64; ++bits) {
+        const std::uint64_t v = bits == 64 ? ~0ull : ((1ull << bits) - 1);
+        const std::size_t   n = detail::varint_size(v);
+
+        Writer writer(buffer.data(), buffer.size());
+        writer.write_varint(v);
+        ASSERT_EQ(writer.position(), n) << "bits=" << bits;
+
+        Reader padded(buffer.data(), buffer.size());
+        EXPECT_EQ(padded.read_varint<std::uint64_t>(), v);
+        EXPECT_EQ(padded.position(), n);
+
+        Reader tight(buffer.data(), n);
+        EXPECT_EQ(tight.read_varint<std::uint64_t>(), v);
+        EXPECT_TRUE(tight.exhausted());
+    }
+}
+
+TEST_F(VarintTest, SignedRoundTrip)
+{
+    const std::int64_t values[] = { 0, -1, 1, -64, 64, std::numeric_limits<std::int64_t>::min(),
+                                    std::numeric_limits<std::int64_t>::max() };
+    Writer writer(buffer.data(), buffer.size());
+    for (auto v : values) writer.write_varint(v);
+    writer.write_varint<std::int32_t>(-300);
+
+    Reader reader(buffer.data(), writer.position());
+    for (auto v : values) EXPECT_EQ(reader.read_varint<std::int64_t>(), v);
+    EXPECT_EQ(reader.read_varint<std::int32_t>(), -300);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST_F(VarintTest, TruncatedInputUnderflows)
+{
+    buffer[0] = 0x80;
+    buffer[1] = 0x80;
+    Reader reader(buffer.data(), 2);
+
+    EXPECT_THROW(reader.read_varint<std::uint32_t>(), UnderflowException);
+}
+
+TEST_F(VarintTest, MalformedInputIsRejected)
+{
+    for (std::size_t i = 0; i < 10; ++i) buffer[i] = 0xFF;
+    buffer[10] = 0x01;
+    Reader overlong(buffer.data(), buffer.size());
+    EXPECT_THROW(overlong.read_varint<std::uint64_t>(), FormatException);
+
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_varint<std::uint64_t>(0x100000000ull);
+    Reader wide(buffer.data(), buffer.size());
+    EXPECT_THROW(wide.read_varint<std::uint32_t>(), FormatException);
+}
+
+TEST_F(VarintTest, VarintLengthPrefixes)
+{
+    std::vector<std::uint32_t> ids = { 7, 8, 9 };
+    const std::string          name = "sensor";
+
+    Writer writer(buffer.data(), buffer.size());
+    write_fields<length_prefix::varint>(writer, name, ids);
+    // 1-byte prefixes instead of 4-byte ones
+    EXPECT_EQ(writer.position(), 1 + name.size() + 1 + ids.size() * 4);
+    EXPECT_EQ(serialized_size<length_prefix::varint>(ids), 1 + ids.size() * 4);
+
+    Reader reader(buffer.data(), writer.position());
+    EXPECT_EQ((read_field<std::string, length_prefix::varint>(reader)), name);
+    EXPECT_EQ((read_vector<std::uint32_t, length_prefix::varint>(reader)), ids);
+    EXPECT_TRUE(reader.exhausted());
+}
+
+TEST_F(VarintTest, SizedStringVarint)
+{
+    Writer writer(buffer.data(), buffer.size());
+    writer.write_sized_string_varint("hello");
+
+    CountingWriter counter;
+    counter.write_sized_string_varint("hello");
+    EXPECT_EQ(counter.size(), writer.position());
+
+    Reader reader(buffer.data(), buffer.size());
+    EXPECT_EQ(reader.view_sized_string_varint(), "hello");
+}
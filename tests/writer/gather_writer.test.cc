@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#  include <unistd.h>
+#endif
+
+using namespace bytestream;
+
+namespace {
+
+template <typename W>
+void encode_response(W& w, const std::string& body)
+{
+    w.template write_le<std::uint32_t>(0xC0FFEE);
+    w.write_sized_string_le("small");
+    w.write_sized_string_le(body);
+    w.template write_le<std::uint16_t>(7);
+}
+
+std::vector<std::uint8_t> flatten(const GatherWriter& w)
+{
+    std::vector<std::uint8_t> out(w.size());
+    w.copy_to(out.data());
+    return out;
+}
+
+// Overwrite the stack below the caller's frame
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void clobber_stack()
+{
+    volatile unsigned char junk[4096];
+    for (auto& b : junk) b = 0xA5;
+}
+
+} // namespace
+
+TEST(GatherWriterTest, LargeBlobsByReference)
+{
+    const std::string body(10000, 'x');
+    GatherWriter writer(1024);
+    encode_response(writer, body);
+
+    // inline header, referenced body, inline trailer
+    const auto segs = writer.segments();
+    ASSERT_EQ(segs.size(), 3u);
+    EXPECT_EQ(segs[0].size(), 4u + 4u + 5u + 4u);
+    EXPECT_EQ(reinterpret_cast<const char*>(segs[1].data()), body.data());
+    EXPECT_EQ(segs[1].size(), body.size());
+    EXPECT_EQ(segs[2].size(), 2u);
+    EXPECT_EQ(writer.inline_size(), 19u);
+    EXPECT_EQ(writer.size(), 19u + body.size());
+
+    DynamicWriter expected;
+    encode_response(expected, body);
+    const auto v = expected.view();
+    EXPECT_EQ(flatten(writer), std::vector<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(v.data()),
+                                                         reinterpret_cast<const std::uint8_t*>(v.data()) + v.size()));
+}
+
+TEST(GatherWriterTest, SmallWritesCoalesce)
+{
+    GatherWriter writer;
+    for (std::uint32_t i = 0; i < 1000; ++i) writer.write_le<std::uint32_t>(i); // grows the inline buffer
+    writer.write_sized_string_le("tail");
+    EXPECT_EQ(writer.segment_count(), 1u);
+    EXPECT_EQ(writer.size(), 4008u);
+
+    writer.clear();
+    EXPECT_EQ(writer.size(), 0u);
+    EXPECT_TRUE(writer.segments().empty());
+}
+
+TEST(GatherWriterTest, ScalarsNeverReferenced)
+{
+    GatherWriter writer(1); // everything at least 1 byte is a reference candidate
+    writer.write_le<std::uint64_t>(42);
+    writer.write_be<std::uint32_t>(7);
+    const char blob[] = "abc";
+    writer.write_bytes(blob, 3);
+
+    const auto segs = writer.segments();
+    ASSERT_EQ(segs.size(), 2u);
+    EXPECT_EQ(segs[0].size(), 12u);
+    EXPECT_EQ(reinterpret_cast<const char*>(segs[1].data()), blob);
+
+    Reader reader(segs[0].data(), segs[0].size());
+    EXPECT_EQ(reader.read_le<std::uint64_t>(), 42u);
+    EXPECT_EQ(reader.read_be<std::uint32_t>(), 7u);
+}
+
+TEST(GatherWriterTest, PrefixesAndTerminatorsGoInline)
+{
+    const std::string text = "prefixed";
+    GatherWriter writer(1); // the text itself is referenced
+    writer.write_sized_string_le(text);
+    writer.write_sized_string_be(text);
+    writer.write_sized_string_varint(text);
+    writer.write_cstring(text);
+    clobber_stack();
+
+    DynamicWriter expected;
+    expected.write_sized_string_le(text);
+    expected.write_sized_string_be(text);
+    expected.write_sized_string_varint(text);
+    expected.write_cstring(text);
+    const auto v = expected.view();
+    EXPECT_EQ(writer.inline_size(), 4u + 4u + 1u + 1u);
+    EXPECT_EQ(flatten(writer), std::vector<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(v.data()),
+                                                         reinterpret_cast<const std::uint8_t*>(v.data()) + v.size()));
+}
+
+TEST(GatherWriterTest, SerializationSpansByReference)
+{
+    std::vector<std::uint32_t> samples(4096, 0xAB);
+    GatherWriter writer;
+    write_fields(writer, std::string("samples"), span<const std::uint32_t>{ samples.data(), samples.size() });
+    EXPECT_EQ(writer.inline_size(), 4u + 7u + 4u);
+    EXPECT_EQ(writer.size(), serialized_size(samples) + 4u + 7u);
+
+    const auto out = flatten(writer);
+    Reader reader(out.data(), out.size());
+    EXPECT_EQ(read_field<std::string>(reader), "samples");
+    EXPECT_EQ(read_vector<std::uint32_t>(reader), samples);
+}
+
+#if defined(BYTESTREAM_HAS_IOVEC)
+TEST(GatherWriterTest, WritevToPipe)
+{
+    const std::string body(2000, 'y');
+    GatherWriter writer(256);
+    encode_response(writer, body);
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    const auto iov = writer.iovecs();
+    ASSERT_EQ(iov.size(), 3u);
+    EXPECT_EQ(::writev(fds[1], iov.data(), static_cast<int>(iov.size())), static_cast<ssize_t>(writer.size()));
+
+    std::vector<std::uint8_t> got(writer.size());
+    std::size_t have = 0;
+    while (have < got.size()) {
+        const auto n = ::read(fds[0], got.data() + have, got.size() - have);
+        ASSERT_GT(n, 0);
+        have += static_cast<std::size_t>(n);
+    }
+    ::close(fds[0]);
+    ::close(fds[1]);
+    EXPECT_EQ(got, flatten(writer));
+}
+#endif
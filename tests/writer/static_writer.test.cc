@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <bytestream/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+using namespace bytestream;
+
+namespace {
+
+// PNG-style file header: magic, version, flags, name, padding
+BYTESTREAM_CONSTEXPR20 StaticWriter<16> make_header() {
+    StaticWriter<16> w;
+    w.write_be<std::uint32_t>(0x89504E47);
+    w.write_le<std::uint16_t>(2);
+    w.write_varint<std::uint32_t>(300);
+    w.write_sized_string_varint("hdr");
+    w.align(4);
+    return w;
+}
+
+// CRC-32 (IEEE) table, as it would be baked into a binary
+BYTESTREAM_CONSTEXPR20 StaticWriter<1024> make_crc_table() {
+    StaticWriter<1024> w;
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        w.write_le(c);
+    }
+    return w;
+}
+
+} // namespace
+
+#if BYTESTREAM_HAS_CONSTEXPR20
+
+constexpr auto header = make_header();
+static_assert(header.written_bytes() == 12);
+static_assert(header.data()[0] == std::byte{0x89} && header.data()[3] == std::byte{0x47});
+static_assert(header.data()[6] == std::byte{0xAC} && header.data()[7] == std::byte{0x02});
+
+static_assert([] {
+    Reader r = header.as_reader();
+    return r.read_be<std::uint32_t>() == 0x89504E47 && r.read_le<std::uint16_t>() == 2 &&
+           r.read_varint<std::uint32_t>() == 300 && r.read_varint_length() == 3;
+}());
+
+constexpr auto crc_table = make_crc_table();
+static_assert(load_le<std::uint32_t>(crc_table.data() + 4) == 0x77073096u);
+
+static_assert(byteswap(std::uint32_t{0x01020304}) == 0x04030201u);
+static_assert(byteswap(byteswap(1.25)) == 1.25);
+static_assert(align_up(13, 8) == 16);
+
+#endif
+
+TEST(StaticWriterTest, RuntimeMatchesWriter) {
+    const StaticWriter<16> s = make_header();
+
+    std::array<std::byte, 16> buf{};
+    Writer w(buf.data(), buf.size());
+    w.write_be<std::uint32_t>(0x89504E47);
+    w.write_le<std::uint16_t>(2);
+    w.write_varint<std::uint32_t>(300);
+    w.write_sized_string_varint("hdr");
+    w.align(4);
+
+    ASSERT_EQ(s.written_bytes(), w.written_bytes());
+    EXPECT_EQ(s.array(), buf);
+    EXPECT_EQ(s.written_view().size(), 12u);
+}
+
+TEST(StaticWriterTest, AsReaderCoversWrittenBytes) {
+    StaticWriter<32> w;
+    w.write_cstring("abc");
+    w.write_le<double>(2.5);
+    Reader r = w.as_reader();
+    EXPECT_EQ(r.size(), 12u);
+    EXPECT_EQ(r.read_cstring(), "abc");
+    EXPECT_EQ(r.read_le<double>(), 2.5);
+    EXPECT_TRUE(r.exhausted());
+}
+
+TEST(StaticWriterTest, CrcTableEntries) {
+    const auto t = make_crc_table();
+    ASSERT_EQ(t.written_bytes(), 1024u);
+    EXPECT_EQ(load_le<std::uint32_t>(t.data() + 4), 0x77073096u);
+    EXPECT_EQ(load_le<std::uint32_t>(t.data() + 1020), 0x2D02EF8Du);
+}
+
+TEST(StaticWriterTest, OverflowAndSeek) {
+    StaticWriter<4> w;
+    w.write_le<std::uint16_t>(1);
+    EXPECT_THROW(w.write_le<std::uint32_t>(2), OverflowException);
+    EXPECT_EQ(w.position(), 2u);
+    EXPECT_EQ(w.remaining(), 2u);
+    w.seek(0);
+    w.fill_bytes(std::byte{0xFF}, 4);
+    EXPECT_EQ(w.data()[3], std::byte{0xFF});
+    EXPECT_THROW(w.seek(5), std::out_of_range);
+}
+
+TEST(StaticWriterTest, ByteSpanReader) {
+    const std::array<std::byte, 4> bytes{ std::byte{1}, std::byte{0}, std::byte{0}, std::byte{0} };
+    Reader r(span<const std::byte>(bytes.data(), bytes.size()));
+    EXPECT_EQ(r.read_le<std::uint32_t>(), 1u);
+}
@@ -140,6 +140,47 @@ TEST_F(WriterTest, WriteArrayBE)
     EXPECT_EQ(buffer[3], 0x78);
 }
 
+TEST_F(WriterTest, WriteArrayLE)
+{
+    Writer writer(buffer.data(), buffer.size());
+    std::array<std::uint32_t, 2> data = { { 0x11223344, 0x55667788 } };
+
+    writer.write_array_le(bytestream::span<const std::uint32_t>(data.data(), data.size()));
+    EXPECT_EQ(buffer[0], 0x44);
+    EXPECT_EQ(buffer[3], 0x11);
+    EXPECT_EQ(buffer[4], 0x88);
+    EXPECT_EQ(buffer[7], 0x55);
+    EXPECT_EQ(writer.position(), 8);
+}
+
+TEST_F(WriterTest, WriteArrayBEOverflow)
+{
+    Writer writer(buffer.data(), 5);
+    std::array<std::uint16_t, 3> data = { { 1, 2, 3 } };
+
+    EXPECT_THROW(writer.write_array_be(bytestream::span<const std::uint16_t>(data.data(), data.size())),
+                 OverflowException);
+    EXPECT_EQ(writer.position(), 0);
+}
+
+TEST_F(WriterTest, UncheckedFrame)
+{
+    Writer writer(buffer.data(), buffer.size());
+
+    UncheckedWriter frame = writer.unchecked(6);
+    EXPECT_EQ(writer.position(), 6);
+    frame.write_be<std::uint16_t>(0x1234);
+    frame.write_le<std::uint32_t>(0x89ABCDEF);
+    EXPECT_EQ(frame.remaining(), 0);
+    EXPECT_EQ(buffer[0], 0x12);
+    EXPECT_EQ(buffer[1], 0x34);
+    EXPECT_EQ(buffer[2], 0xEF);
+    EXPECT_EQ(buffer[5], 0x89);
+
+    Writer small(buffer.data(), 4);
+    EXPECT_THROW(small.unchecked(5), OverflowException);
+}
+
 TEST_F(WriterTest, WriteString)
 {
     Writer      writer(buffer.data(), buffer.size());
@@ -225,10 +266,12 @@ TEST_F(WriterTest, AsReader)
 
     writer.write<std::uint32_t>(0x12345678);
     Reader reader = writer.as_reader();
-    EXPECT_EQ(reader.size(), writer.size());
-    reader.rewind();
+    EXPECT_EQ(reader.size(), writer.written_bytes());
+    EXPECT_EQ(reader.data(), writer.written_view().data());
     std::uint32_t v = reader.read<std::uint32_t>();
     EXPECT_EQ(v, 0x12345678);
+    EXPECT_TRUE(reader.exhausted());
+    EXPECT_EQ(writer.written_view().size(), 4u);
 }
 
 TEST(ExtrasTest, WrittenBytesAndRemainingView) {